@@ -34,6 +34,27 @@ enum backing_store_flags {
 	BACKING_STORE_META = 1,
 };
 
+/**
+ * backing store statistics
+ */
+struct backing_store_stats {
+	size_t limit; /**< target upper bound of the store size */
+	uint64_t size; /**< total size of stored objects */
+	size_t entry_count; /**< number of entries in the store */
+
+	size_t hit_count; /**< number of fetches served */
+	uint64_t hit_size; /**< size of data served */
+	size_t miss_count; /**< number of fetches not in the store */
+
+	size_t evict_count; /**< number of entries evicted */
+	uint64_t evict_size; /**< size of entries evicted */
+
+	/** small block slots in use for data and metadata */
+	unsigned int blocks_used[2];
+	/** small block slots up to the last one in use, including holes */
+	unsigned int blocks_extent[2];
+};
+
 /**
  * low level cache backing store operation table
  *
@@ -121,6 +142,16 @@ struct gui_llcache_table {
 	 */
 	nserror (*invalidate)(struct nsurl *url);
 
+	/**
+	 * Get statistics about the backing store.
+	 *
+	 * This operation is optional and may be NULL.
+	 *
+	 * @param[out] stats The structure to fill with the statistics.
+	 * @return NSERROR_OK on success or error code on failure.
+	 */
+	nserror (*stats)(struct backing_store_stats *stats);
+
 };
 
 extern struct gui_llcache_table* null_llcache_table;
@@ -0,0 +1,1181 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Network content blocking implementation.
+ *
+ * Both matchers are held as flat arrays of nodes, edges and patterns
+ *  which are written out and read back unchanged as the compiled form
+ *  of a filter list. The edges of each node are sorted so the child
+ *  for a character is found with a binary search.
+ *
+ * The domain trie holds each domain reversed so a host is walked from
+ *  its last character and every label boundary reached on a node
+ *  carrying a rule is a suffix match.
+ *
+ * The URL matcher is an Aho-Corasick automaton. Each node has a
+ *  failure link and a dictionary link to the next node on its failure
+ *  chain which completes a pattern, so one pass over the URL finds
+ *  every pattern it contains.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "utils/errors.h"
+#include "utils/utils.h"
+#include "utils/log.h"
+#include "utils/ascii.h"
+#include "utils/nsurl.h"
+
+#include "content/blocklist.h"
+
+/** Compiled form identifier, "NSBL" */
+#define BLOCKLIST_MAGIC 0x4c42534e
+
+/** Compiled form version */
+#define BLOCKLIST_VERSION 1
+
+/** Suffix of the compiled form file name */
+#define BLOCKLIST_COMPILED_SUFFIX ".compiled"
+
+/** Maximum length of a filter list line */
+#define BLOCKLIST_LINE_MAX 4096
+
+/** Shortest URL text rule accepted, shorter ones match too much */
+#define BLOCKLIST_PATTERN_MIN 4
+
+/* rule flags */
+#define BLOCKLIST_BLOCK (1 << 0) /**< rule blocks matches */
+#define BLOCKLIST_ALLOW (1 << 1) /**< rule is an exception */
+#define BLOCKLIST_ANCHOR_START (1 << 2) /**< match must start the URL */
+#define BLOCKLIST_ANCHOR_END (1 << 3) /**< match must end the URL */
+
+/**
+ * Compiled form header
+ */
+struct blocklist_header {
+	uint32_t magic; /**< BLOCKLIST_MAGIC in host byte order */
+	uint32_t version; /**< BLOCKLIST_VERSION */
+	uint64_t source_size; /**< size of the filter list compiled */
+	int64_t source_mtime; /**< modification time of that list */
+	uint32_t domain_count; /**< number of domain rules */
+	uint32_t pattern_count; /**< number of URL text rules */
+	uint32_t domain_node_count; /**< nodes in the domain trie */
+	uint32_t match_node_count; /**< nodes in the URL matcher */
+	uint32_t edge_count; /**< edges of both */
+	uint32_t reserved;
+};
+
+/**
+ * Matcher node
+ */
+struct blocklist_node {
+	uint32_t edge; /**< index of the first edge */
+	uint32_t fail; /**< failure link */
+	uint32_t dict; /**< next node on failure chain with a pattern */
+	uint32_t pattern; /**< first pattern ending here plus one or zero */
+	uint16_t edge_count; /**< number of edges */
+	uint16_t flags; /**< rule flags of a domain ending here */
+};
+
+/**
+ * Matcher edge
+ */
+struct blocklist_edge {
+	uint32_t target; /**< index of node the edge leads to */
+	uint8_t c; /**< character of the edge */
+	uint8_t reserved[3];
+};
+
+/**
+ * URL text rule
+ */
+struct blocklist_pattern {
+	uint32_t next; /**< next pattern ending at same node plus one */
+	uint16_t length; /**< length of the text */
+	uint16_t flags; /**< rule flags */
+};
+
+/**
+ * Compiled filter list
+ */
+struct blocklist {
+	struct blocklist_header header;
+	struct blocklist_node *domain_nodes;
+	struct blocklist_node *match_nodes;
+	struct blocklist_edge *edges;
+	struct blocklist_pattern *patterns;
+	size_t data_size; /**< size of data */
+	void *data; /**< allocation holding all the arrays */
+};
+
+/**
+ * Node of a matcher being built
+ */
+struct blocklist_build_node {
+	struct blocklist_edge *edges; /**< edges sorted by character */
+	uint32_t fail;
+	uint32_t dict;
+	uint32_t pattern;
+	uint16_t edge_count;
+	uint16_t flags;
+};
+
+/**
+ * Matcher being built
+ */
+struct blocklist_build {
+	struct blocklist_build_node *nodes;
+	uint32_t node_count;
+	uint32_t node_alloc;
+};
+
+/**
+ * Filter list being compiled
+ */
+struct blocklist_compile {
+	struct blocklist_build domains; /**< domain trie */
+	struct blocklist_build matches; /**< URL matcher */
+	struct blocklist_pattern *patterns; /**< URL text rules */
+	uint32_t pattern_count;
+	uint32_t pattern_alloc;
+	uint32_t domain_count;
+};
+
+/** The filter list in use */
+static struct blocklist *blocklist = NULL;
+
+
+/**
+ * Find the child of a compiled node for a character
+ *
+ * \param nodes The node array.
+ * \param edges The edge array.
+ * \param node The node index.
+ * \param c The character.
+ * \return The child node index or zero if there is none.
+ */
+static inline uint32_t
+blocklist_child(const struct blocklist_node *nodes,
+		const struct blocklist_edge *edges,
+		uint32_t node,
+		uint8_t c)
+{
+	const struct blocklist_edge *e = edges + nodes[node].edge;
+	unsigned int lo = 0;
+	unsigned int hi = nodes[node].edge_count;
+
+	while (lo < hi) {
+		unsigned int mid = (lo + hi) / 2;
+		if (e[mid].c == c) {
+			return e[mid].target;
+		} else if (e[mid].c < c) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return 0;
+}
+
+
+/**
+ * Find the rules matching a host
+ *
+ * \param bl The filter list.
+ * \param host The host name.
+ * \param len The length of the host name.
+ * \return The flags of all rules for the host and its parent domains.
+ */
+static uint16_t
+blocklist_match_host(const struct blocklist *bl, const char *host, size_t len)
+{
+	uint32_t node = 0;
+	uint16_t flags = 0;
+	size_t idx;
+
+	for (idx = len; idx > 0; idx--) {
+		uint8_t c = ascii_to_lower(host[idx - 1]);
+
+		node = blocklist_child(bl->domain_nodes, bl->edges, node, c);
+		if (node == 0) {
+			break;
+		}
+		if ((bl->domain_nodes[node].flags != 0) &&
+		    ((idx == 1) || (host[idx - 2] == '.'))) {
+			flags |= bl->domain_nodes[node].flags;
+		}
+	}
+
+	return flags;
+}
+
+
+/**
+ * Find the rules matching a URL
+ *
+ * Stops at the first exception found.
+ *
+ * \param bl The filter list.
+ * \param url The URL text.
+ * \param len The length of the URL text.
+ * \return The flags of the rules found.
+ */
+static uint16_t
+blocklist_match_url(const struct blocklist *bl, const char *url, size_t len)
+{
+	const struct blocklist_node *nodes = bl->match_nodes;
+	uint32_t node = 0;
+	uint16_t flags = 0;
+	size_t idx;
+
+	for (idx = 0; idx < len; idx++) {
+		uint8_t c = ascii_to_lower(url[idx]);
+		uint32_t next;
+		uint32_t out;
+
+		while (((next = blocklist_child(nodes, bl->edges, node, c)) == 0) &&
+		       (node != 0)) {
+			node = nodes[node].fail;
+		}
+		node = next;
+
+		out = (nodes[node].pattern != 0) ? node : nodes[node].dict;
+		for (; out != 0; out = nodes[out].dict) {
+			uint32_t p;
+
+			for (p = nodes[out].pattern; p != 0; p = bl->patterns[p - 1].next) {
+				const struct blocklist_pattern *pat = &bl->patterns[p - 1];
+
+				if ((pat->flags & BLOCKLIST_ANCHOR_START) &&
+				    (idx + 1 != pat->length)) {
+					continue;
+				}
+				if ((pat->flags & BLOCKLIST_ANCHOR_END) &&
+				    (idx + 1 != len)) {
+					continue;
+				}
+				flags |= pat->flags;
+				if (flags & BLOCKLIST_ALLOW) {
+					return flags;
+				}
+			}
+		}
+	}
+
+	return flags;
+}
+
+
+/**
+ * Find or create the child of a node being built
+ *
+ * \param b The matcher being built.
+ * \param node The node index.
+ * \param c The character.
+ * \param child Updated with the child node index.
+ * \return NSERROR_OK on success or NSERROR_NOMEM.
+ */
+static nserror
+blocklist_build_child(struct blocklist_build *b,
+		      uint32_t node,
+		      uint8_t c,
+		      uint32_t *child)
+{
+	struct blocklist_build_node *n = &b->nodes[node];
+	struct blocklist_edge *edges;
+	unsigned int idx;
+
+	for (idx = 0; idx < n->edge_count; idx++) {
+		if (n->edges[idx].c == c) {
+			*child = n->edges[idx].target;
+			return NSERROR_OK;
+		}
+		if (n->edges[idx].c > c) {
+			break;
+		}
+	}
+
+	if (b->node_count == b->node_alloc) {
+		struct blocklist_build_node *nodes;
+		uint32_t alloc = (b->node_alloc == 0) ? 1024 : b->node_alloc * 2;
+
+		nodes = realloc(b->nodes, alloc * sizeof(*nodes));
+		if (nodes == NULL) {
+			return NSERROR_NOMEM;
+		}
+		b->nodes = nodes;
+		b->node_alloc = alloc;
+		n = &b->nodes[node];
+	}
+
+	edges = realloc(n->edges, (n->edge_count + 1) * sizeof(*edges));
+	if (edges == NULL) {
+		return NSERROR_NOMEM;
+	}
+	memmove(edges + idx + 1, edges + idx,
+		(n->edge_count - idx) * sizeof(*edges));
+	memset(&edges[idx], 0, sizeof(*edges));
+	edges[idx].c = c;
+	edges[idx].target = b->node_count;
+	n->edges = edges;
+	n->edge_count++;
+
+	memset(&b->nodes[b->node_count], 0, sizeof(*b->nodes));
+	*child = b->node_count++;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Add a domain rule
+ */
+static nserror
+blocklist_add_domain(struct blocklist_compile *bc,
+		     const char *domain,
+		     size_t len,
+		     uint16_t flags)
+{
+	uint32_t node = 0;
+	nserror res;
+
+	while (len > 0) {
+		res = blocklist_build_child(&bc->domains, node,
+					    ascii_to_lower(domain[--len]),
+					    &node);
+		if (res != NSERROR_OK) {
+			return res;
+		}
+	}
+
+	if (node != 0) {
+		bc->domains.nodes[node].flags |= flags;
+		bc->domain_count++;
+	}
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Add a URL text rule
+ */
+static nserror
+blocklist_add_pattern(struct blocklist_compile *bc,
+		      const char *text,
+		      size_t len,
+		      uint16_t flags)
+{
+	struct blocklist_pattern *pat;
+	uint32_t node = 0;
+	size_t idx;
+	nserror res;
+
+	for (idx = 0; idx < len; idx++) {
+		res = blocklist_build_child(&bc->matches, node,
+					    ascii_to_lower(text[idx]),
+					    &node);
+		if (res != NSERROR_OK) {
+			return res;
+		}
+	}
+
+	if (bc->pattern_count == bc->pattern_alloc) {
+		uint32_t alloc;
+
+		alloc = (bc->pattern_alloc == 0) ? 256 : bc->pattern_alloc * 2;
+		pat = realloc(bc->patterns, alloc * sizeof(*pat));
+		if (pat == NULL) {
+			return NSERROR_NOMEM;
+		}
+		bc->patterns = pat;
+		bc->pattern_alloc = alloc;
+	}
+
+	pat = &bc->patterns[bc->pattern_count++];
+	pat->next = bc->matches.nodes[node].pattern;
+	pat->length = len;
+	pat->flags = flags;
+	bc->matches.nodes[node].pattern = bc->pattern_count;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Check if text is made up only of host name characters
+ */
+static bool blocklist_is_host(const char *text, size_t len)
+{
+	size_t idx;
+
+	if (len == 0) {
+		return false;
+	}
+	for (idx = 0; idx < len; idx++) {
+		if (!ascii_is_alphanumerical(text[idx]) &&
+		    (text[idx] != '.') &&
+		    (text[idx] != '-') &&
+		    (text[idx] != '_')) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Parse a hosts file format line
+ *
+ * \param bc The filter list being compiled.
+ * \param line The line.
+ * \param handled Set true if the line was in hosts file format.
+ * \return NSERROR_OK on success or error code on failure.
+ */
+static nserror
+blocklist_parse_hosts(struct blocklist_compile *bc, char *line, bool *handled)
+{
+	static const char *ignore[] = {
+		"localhost", "localhost.localdomain", "local",
+		"broadcasthost", "0.0.0.0", NULL
+	};
+	char *host;
+	size_t len;
+	int idx;
+
+	*handled = false;
+
+	/* address of only digits, dots and colons then white space */
+	len = strspn(line, "0123456789.:");
+	if ((len == 0) || ((line[len] != ' ') && (line[len] != '\t'))) {
+		return NSERROR_OK;
+	}
+	*handled = true;
+
+	host = line + len + strspn(line + len, " \t");
+	len = strcspn(host, " \t#");
+
+	for (idx = 0; ignore[idx] != NULL; idx++) {
+		if ((strlen(ignore[idx]) == len) &&
+		    (strncmp(ignore[idx], host, len) == 0)) {
+			return NSERROR_OK;
+		}
+	}
+
+	if (!blocklist_is_host(host, len)) {
+		return NSERROR_OK;
+	}
+
+	return blocklist_add_domain(bc, host, len, BLOCKLIST_BLOCK);
+}
+
+
+/**
+ * Parse a filter list line
+ *
+ * \param bc The filter list being compiled.
+ * \param line The line, which is modified.
+ * \return NSERROR_OK on success or error code on failure.
+ */
+static nserror blocklist_parse_line(struct blocklist_compile *bc, char *line)
+{
+	uint16_t flags = BLOCKLIST_BLOCK;
+	size_t len;
+	bool handled;
+	nserror res;
+
+	/* trim */
+	line += strspn(line, " \t");
+	len = strlen(line);
+	while ((len > 0) && ascii_is_space(line[len - 1])) {
+		line[--len] = 0;
+	}
+
+	/* comments, headers and element hiding */
+	if ((len == 0) ||
+	    (line[0] == '!') ||
+	    (line[0] == '#') ||
+	    (line[0] == '[') ||
+	    (strstr(line, "##") != NULL) ||
+	    (strstr(line, "#@#") != NULL) ||
+	    (strstr(line, "#?#") != NULL)) {
+		return NSERROR_OK;
+	}
+
+	res = blocklist_parse_hosts(bc, line, &handled);
+	if (handled) {
+		return res;
+	}
+
+	/* options restrict where a rule applies, applying the rule
+	 * everywhere would block too much.
+	 */
+	if (strchr(line, '$') != NULL) {
+		return NSERROR_OK;
+	}
+
+	if ((line[0] == '@') && (line[1] == '@')) {
+		flags = BLOCKLIST_ALLOW;
+		line += 2;
+		len -= 2;
+	}
+
+	if ((line[0] == '|') && (line[1] == '|')) {
+		line += 2;
+		len -= 2;
+		if ((len > 0) && (line[len - 1] == '^')) {
+			len--;
+		}
+		if (blocklist_is_host(line, len)) {
+			return blocklist_add_domain(bc, line, len, flags);
+		}
+	} else {
+		if (line[0] == '|') {
+			flags |= BLOCKLIST_ANCHOR_START;
+			line++;
+			len--;
+		}
+		if ((len > 0) && (line[len - 1] == '|')) {
+			flags |= BLOCKLIST_ANCHOR_END;
+			len--;
+		}
+	}
+
+	/* leading and trailing wildcards are implied */
+	while ((len > 0) && (line[0] == '*')) {
+		flags &= ~BLOCKLIST_ANCHOR_START;
+		line++;
+		len--;
+	}
+	while ((len > 0) && ((line[len - 1] == '*') || (line[len - 1] == '^'))) {
+		flags &= ~BLOCKLIST_ANCHOR_END;
+		len--;
+	}
+
+	/* wildcards and separators within a rule are not supported */
+	if ((len < BLOCKLIST_PATTERN_MIN) ||
+	    (len > UINT16_MAX) ||
+	    (memchr(line, '*', len) != NULL) ||
+	    (memchr(line, '^', len) != NULL)) {
+		return NSERROR_OK;
+	}
+
+	return blocklist_add_pattern(bc, line, len, flags);
+}
+
+
+/**
+ * Compute the failure and dictionary links of the URL matcher
+ */
+static nserror blocklist_build_links(struct blocklist_build *b)
+{
+	uint32_t *queue;
+	uint32_t head = 0;
+	uint32_t tail = 0;
+
+	queue = malloc(b->node_count * sizeof(*queue));
+	if (queue == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	queue[tail++] = 0;
+	while (head < tail) {
+		uint32_t u = queue[head++];
+		unsigned int idx;
+
+		for (idx = 0; idx < b->nodes[u].edge_count; idx++) {
+			uint8_t c = b->nodes[u].edges[idx].c;
+			uint32_t v = b->nodes[u].edges[idx].target;
+			uint32_t fail = 0;
+
+			if (u != 0) {
+				uint32_t f = b->nodes[u].fail;
+				for (;;) {
+					unsigned int e;
+					for (e = 0; e < b->nodes[f].edge_count; e++) {
+						if (b->nodes[f].edges[e].c == c) {
+							fail = b->nodes[f].edges[e].target;
+							break;
+						}
+					}
+					if ((fail != 0) || (f == 0)) {
+						break;
+					}
+					f = b->nodes[f].fail;
+				}
+			}
+
+			b->nodes[v].fail = fail;
+			b->nodes[v].dict = (b->nodes[fail].pattern != 0) ?
+				fail : b->nodes[fail].dict;
+			queue[tail++] = v;
+		}
+	}
+
+	free(queue);
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Flatten a matcher being built into compiled nodes and edges
+ *
+ * \param b The matcher.
+ * \param nodes The compiled node array to fill.
+ * \param edges The compiled edge array.
+ * \param edge_count The number of edges already used, updated.
+ */
+static void
+blocklist_flatten(struct blocklist_build *b,
+		  struct blocklist_node *nodes,
+		  struct blocklist_edge *edges,
+		  uint32_t *edge_count)
+{
+	uint32_t idx;
+
+	for (idx = 0; idx < b->node_count; idx++) {
+		struct blocklist_build_node *n = &b->nodes[idx];
+
+		nodes[idx].edge = *edge_count;
+		nodes[idx].edge_count = n->edge_count;
+		nodes[idx].fail = n->fail;
+		nodes[idx].dict = n->dict;
+		nodes[idx].pattern = n->pattern;
+		nodes[idx].flags = n->flags;
+
+		memcpy(edges + *edge_count, n->edges,
+		       n->edge_count * sizeof(*edges));
+		*edge_count += n->edge_count;
+	}
+}
+
+
+/**
+ * Free a matcher being built
+ */
+static void blocklist_build_free(struct blocklist_build *b)
+{
+	uint32_t idx;
+
+	for (idx = 0; idx < b->node_count; idx++) {
+		free(b->nodes[idx].edges);
+	}
+	free(b->nodes);
+}
+
+
+/**
+ * Allocate a compiled filter list and point its arrays into the data
+ *
+ * \param header The header giving the array sizes.
+ * \param bl_out Updated with the compiled filter list.
+ * \return NSERROR_OK on success or NSERROR_NOMEM.
+ */
+static nserror
+blocklist_alloc(const struct blocklist_header *header,
+		struct blocklist **bl_out)
+{
+	struct blocklist *bl;
+	size_t nodes_size;
+	size_t edges_size;
+
+	bl = calloc(1, sizeof(*bl));
+	if (bl == NULL) {
+		return NSERROR_NOMEM;
+	}
+	bl->header = *header;
+
+	nodes_size = (header->domain_node_count + header->match_node_count) *
+		sizeof(struct blocklist_node);
+	edges_size = header->edge_count * sizeof(struct blocklist_edge);
+	bl->data_size = nodes_size + edges_size +
+		header->pattern_count * sizeof(struct blocklist_pattern);
+
+	bl->data = malloc(bl->data_size);
+	if (bl->data == NULL) {
+		free(bl);
+		return NSERROR_NOMEM;
+	}
+
+	bl->domain_nodes = bl->data;
+	bl->match_nodes = bl->domain_nodes + header->domain_node_count;
+	bl->edges = (struct blocklist_edge *)
+		(bl->match_nodes + header->match_node_count);
+	bl->patterns = (struct blocklist_pattern *)
+		(bl->edges + header->edge_count);
+
+	*bl_out = bl;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Free a compiled filter list
+ */
+static void blocklist_free(struct blocklist *bl)
+{
+	if (bl != NULL) {
+		free(bl->data);
+		free(bl);
+	}
+}
+
+
+/**
+ * Compile a filter list
+ *
+ * \param path The filter list file.
+ * \param st The status of the filter list file.
+ * \param bl_out Updated with the compiled filter list.
+ * \return NSERROR_OK on success or error code on failure.
+ */
+static nserror
+blocklist_compile(const char *path,
+		  const struct stat *st,
+		  struct blocklist **bl_out)
+{
+	struct blocklist_compile bc;
+	struct blocklist_header header;
+	struct blocklist *bl = NULL;
+	char line[BLOCKLIST_LINE_MAX];
+	uint32_t edge_count = 0;
+	bool skip = false;
+	FILE *fp;
+	nserror res = NSERROR_OK;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		return NSERROR_NOT_FOUND;
+	}
+
+	memset(&bc, 0, sizeof(bc));
+
+	/* roots of the two matchers */
+	bc.domains.nodes = calloc(1024, sizeof(*bc.domains.nodes));
+	bc.matches.nodes = calloc(1024, sizeof(*bc.matches.nodes));
+	if ((bc.domains.nodes == NULL) || (bc.matches.nodes == NULL)) {
+		res = NSERROR_NOMEM;
+		goto compile_error;
+	}
+	bc.domains.node_alloc = bc.matches.node_alloc = 1024;
+	bc.domains.node_count = bc.matches.node_count = 1;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		size_t len = strlen(line);
+		bool complete = ((len > 0) && (line[len - 1] == '\n')) ||
+			feof(fp);
+
+		/* overlong lines are ignored */
+		if (!skip && complete) {
+			res = blocklist_parse_line(&bc, line);
+			if (res != NSERROR_OK) {
+				goto compile_error;
+			}
+		}
+		skip = !complete;
+	}
+
+	res = blocklist_build_links(&bc.matches);
+	if (res != NSERROR_OK) {
+		goto compile_error;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.magic = BLOCKLIST_MAGIC;
+	header.version = BLOCKLIST_VERSION;
+	header.source_size = st->st_size;
+	header.source_mtime = st->st_mtime;
+	header.domain_count = bc.domain_count;
+	header.pattern_count = bc.pattern_count;
+	header.domain_node_count = bc.domains.node_count;
+	header.match_node_count = bc.matches.node_count;
+	header.edge_count = (bc.domains.node_count - 1) +
+		(bc.matches.node_count - 1);
+
+	res = blocklist_alloc(&header, &bl);
+	if (res != NSERROR_OK) {
+		goto compile_error;
+	}
+
+	blocklist_flatten(&bc.domains, bl->domain_nodes, bl->edges, &edge_count);
+	blocklist_flatten(&bc.matches, bl->match_nodes, bl->edges, &edge_count);
+	if (bc.pattern_count > 0) {
+		memcpy(bl->patterns, bc.patterns,
+		       bc.pattern_count * sizeof(*bc.patterns));
+	}
+
+	*bl_out = bl;
+
+compile_error:
+	fclose(fp);
+	blocklist_build_free(&bc.domains);
+	blocklist_build_free(&bc.matches);
+	free(bc.patterns);
+
+	return res;
+}
+
+
+/**
+ * Check the nodes of a compiled matcher only refer within the arrays
+ *
+ * The edges must form a tree from the root, which gives each node a
+ *  depth. Failure and dictionary links must lead to a shallower node
+ *  so following them always ends at the root.
+ *
+ * \param bl The compiled filter list.
+ * \param nodes The node array of the matcher.
+ * \param node_count The number of nodes in the matcher.
+ * \return NSERROR_OK if the matcher is valid else NSERROR_INVALID.
+ */
+static nserror
+blocklist_validate_nodes(const struct blocklist *bl,
+			 const struct blocklist_node *nodes,
+			 uint32_t node_count)
+{
+	uint32_t *depth;
+	uint32_t *queue;
+	uint32_t head = 0;
+	uint32_t tail = 0;
+	uint32_t idx;
+	nserror res = NSERROR_INVALID;
+
+	depth = malloc(node_count * sizeof(*depth));
+	queue = malloc(node_count * sizeof(*queue));
+	if ((depth == NULL) || (queue == NULL)) {
+		free(depth);
+		free(queue);
+		return NSERROR_NOMEM;
+	}
+
+	for (idx = 0; idx < node_count; idx++) {
+		const struct blocklist_node *n = &nodes[idx];
+
+		if (((uint64_t)n->edge + n->edge_count >
+		     bl->header.edge_count) ||
+		    (n->fail >= node_count) ||
+		    (n->dict >= node_count) ||
+		    (n->pattern > bl->header.pattern_count)) {
+			goto validate_error;
+		}
+		depth[idx] = UINT32_MAX;
+	}
+
+	/* every node is reached from the root exactly once */
+	depth[0] = 0;
+	queue[tail++] = 0;
+	while (head < tail) {
+		const struct blocklist_node *n = &nodes[queue[head]];
+		uint32_t d = depth[queue[head++]] + 1;
+
+		for (idx = n->edge; idx < n->edge + n->edge_count; idx++) {
+			uint32_t target = bl->edges[idx].target;
+
+			if ((target == 0) ||
+			    (target >= node_count) ||
+			    (depth[target] != UINT32_MAX)) {
+				goto validate_error;
+			}
+			depth[target] = d;
+			queue[tail++] = target;
+		}
+	}
+	if (tail != node_count) {
+		goto validate_error;
+	}
+
+	for (idx = 1; idx < node_count; idx++) {
+		if ((depth[nodes[idx].fail] >= depth[idx]) ||
+		    (depth[nodes[idx].dict] >= depth[idx])) {
+			goto validate_error;
+		}
+	}
+	if ((nodes[0].fail != 0) || (nodes[0].dict != 0)) {
+		goto validate_error;
+	}
+
+	res = NSERROR_OK;
+
+validate_error:
+	free(depth);
+	free(queue);
+
+	return res;
+}
+
+
+/**
+ * Check a compiled filter list read from disc only refers within its
+ *  arrays and cannot cause matching to loop.
+ *
+ * \param bl The compiled filter list.
+ * \return NSERROR_OK if the filter list is valid else error code.
+ */
+static nserror blocklist_validate(const struct blocklist *bl)
+{
+	uint32_t idx;
+	nserror res;
+
+	/* each pattern may only link to an earlier one */
+	for (idx = 0; idx < bl->header.pattern_count; idx++) {
+		if (bl->patterns[idx].next > idx) {
+			return NSERROR_INVALID;
+		}
+	}
+
+	res = blocklist_validate_nodes(bl, bl->domain_nodes,
+				       bl->header.domain_node_count);
+	if (res != NSERROR_OK) {
+		return res;
+	}
+
+	return blocklist_validate_nodes(bl, bl->match_nodes,
+					bl->header.match_node_count);
+}
+
+
+/**
+ * Read the compiled form of a filter list
+ *
+ * \param path The compiled form file.
+ * \param st The status of the filter list the form must match.
+ * \param bl_out Updated with the compiled filter list.
+ * \return NSERROR_OK on success or error code if the compiled form
+ *          is missing, stale or damaged.
+ */
+static nserror
+blocklist_read(const char *path,
+	       const struct stat *st,
+	       struct blocklist **bl_out)
+{
+	struct blocklist_header header;
+	struct blocklist *bl;
+	struct stat compiled_st;
+	uint64_t expected_size;
+	FILE *fp;
+	nserror res;
+
+	fp = fopen(path, "rb");
+	if (fp == NULL) {
+		return NSERROR_NOT_FOUND;
+	}
+
+	if ((fread(&header, sizeof(header), 1, fp) != 1) ||
+	    (header.magic != BLOCKLIST_MAGIC) ||
+	    (header.version != BLOCKLIST_VERSION) ||
+	    (header.source_size != (uint64_t)st->st_size) ||
+	    (header.source_mtime != (int64_t)st->st_mtime) ||
+	    (header.domain_node_count == 0) ||
+	    (header.match_node_count == 0) ||
+	    (fstat(fileno(fp), &compiled_st) != 0)) {
+		fclose(fp);
+		return NSERROR_INVALID;
+	}
+
+	/* the counts must describe exactly the data in the file */
+	expected_size = sizeof(header) +
+		((uint64_t)header.domain_node_count +
+		 header.match_node_count) * sizeof(struct blocklist_node) +
+		(uint64_t)header.edge_count * sizeof(struct blocklist_edge) +
+		(uint64_t)header.pattern_count *
+		sizeof(struct blocklist_pattern);
+	if (expected_size != (uint64_t)compiled_st.st_size) {
+		fclose(fp);
+		return NSERROR_INVALID;
+	}
+
+	res = blocklist_alloc(&header, &bl);
+	if (res != NSERROR_OK) {
+		fclose(fp);
+		return res;
+	}
+
+	if (fread(bl->data, bl->data_size, 1, fp) != 1) {
+		fclose(fp);
+		blocklist_free(bl);
+		return NSERROR_INVALID;
+	}
+	fclose(fp);
+
+	res = blocklist_validate(bl);
+	if (res != NSERROR_OK) {
+		blocklist_free(bl);
+		return res;
+	}
+
+	*bl_out = bl;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Write the compiled form of a filter list
+ *
+ * The form is written to a temporary file which then replaces any
+ *  existing one so an interrupted write never leaves a partial file.
+ *
+ * \param path The compiled form file.
+ * \param bl The compiled filter list.
+ * \return NSERROR_OK on success or NSERROR_SAVE_FAILED.
+ */
+static nserror blocklist_write(const char *path, const struct blocklist *bl)
+{
+	char *tmp_path;
+	FILE *fp;
+	bool ok;
+
+	tmp_path = malloc(strlen(path) + SLEN(".tmp") + 1);
+	if (tmp_path == NULL) {
+		return NSERROR_SAVE_FAILED;
+	}
+	strcpy(tmp_path, path);
+	strcat(tmp_path, ".tmp");
+
+	fp = fopen(tmp_path, "wb");
+	if (fp == NULL) {
+		free(tmp_path);
+		return NSERROR_SAVE_FAILED;
+	}
+
+	ok = (fwrite(&bl->header, sizeof(bl->header), 1, fp) == 1) &&
+		(fwrite(bl->data, bl->data_size, 1, fp) == 1);
+
+	if ((fclose(fp) != 0) || !ok || (rename(tmp_path, path) != 0)) {
+		remove(tmp_path);
+		free(tmp_path);
+		return NSERROR_SAVE_FAILED;
+	}
+
+	free(tmp_path);
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in content/blocklist.h */
+nserror blocklist_init(const char *path)
+{
+	struct blocklist *bl = NULL;
+	struct stat st;
+	char *compiled;
+	nserror res;
+
+	if ((path == NULL) || (*path == 0)) {
+		return NSERROR_OK;
+	}
+
+	if (stat(path, &st) != 0) {
+		NSLOG(netsurf, WARNING, "Unable to read filter list %s", path);
+		return NSERROR_NOT_FOUND;
+	}
+
+	compiled = malloc(strlen(path) + sizeof(BLOCKLIST_COMPILED_SUFFIX));
+	if (compiled == NULL) {
+		return NSERROR_NOMEM;
+	}
+	strcpy(compiled, path);
+	strcat(compiled, BLOCKLIST_COMPILED_SUFFIX);
+
+	res = blocklist_read(compiled, &st, &bl);
+	if (res != NSERROR_OK) {
+		res = blocklist_compile(path, &st, &bl);
+		if (res != NSERROR_OK) {
+			NSLOG(netsurf, WARNING,
+			      "Unable to compile filter list %s", path);
+			free(compiled);
+			return res;
+		}
+
+		if (blocklist_write(compiled, bl) != NSERROR_OK) {
+			NSLOG(netsurf, INFO,
+			      "Unable to save compiled filter list %s",
+			      compiled);
+		}
+	}
+	free(compiled);
+
+	blocklist_free(blocklist);
+	blocklist = bl;
+
+	NSLOG(netsurf, INFO,
+	      "Filter list %s has %u domain and %u URL rules",
+	      path, bl->header.domain_count, bl->header.pattern_count);
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in content/blocklist.h */
+void blocklist_fini(void)
+{
+	blocklist_free(blocklist);
+	blocklist = NULL;
+}
+
+
+/* exported interface documented in content/blocklist.h */
+bool blocklist_match(struct nsurl *url)
+{
+	lwc_string *host;
+	uint16_t flags = 0;
+
+	if (blocklist == NULL) {
+		return false;
+	}
+
+	host = nsurl_get_component(url, NSURL_HOST);
+	if (host == NULL) {
+		/* only network requests are blocked */
+		return false;
+	}
+	flags = blocklist_match_host(blocklist,
+				     lwc_string_data(host),
+				     lwc_string_length(host));
+	lwc_string_unref(host);
+
+	if ((flags & BLOCKLIST_ALLOW) == 0) {
+		flags |= blocklist_match_url(blocklist,
+					     nsurl_access(url),
+					     nsurl_length(url));
+	}
+
+	return (flags & (BLOCKLIST_ALLOW | BLOCKLIST_BLOCK)) == BLOCKLIST_BLOCK;
+}
+
+
+/* exported interface documented in content/blocklist.h */
+void blocklist_get_stats(struct blocklist_stats *stats)
+{
+	if (blocklist == NULL) {
+		stats->domain_count = 0;
+		stats->pattern_count = 0;
+		return;
+	}
+	stats->domain_count = blocklist->header.domain_count;
+	stats->pattern_count = blocklist->header.pattern_count;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Network content blocking interface.
+ *
+ * A filter list is compiled into a domain suffix trie and an
+ *  Aho-Corasick automaton of URL substrings. Requests are checked
+ *  against both before any fetch is started.
+ *
+ * Filter lists may be in hosts file format or a subset of the Adblock
+ *  Plus format:
+ *  - `||example.com^` blocks a domain and all its subdomains.
+ *  - `/banner/ads.` blocks URLs containing the text.
+ *  - `|http://ads.` and `.swf|` anchor the text to the start or end.
+ *  - `@@` before a rule makes it an exception.
+ *  Rules with options, wildcards within them or element hiding are
+ *  ignored.
+ */
+
+#ifndef NETSURF_CONTENT_BLOCKLIST_H
+#define NETSURF_CONTENT_BLOCKLIST_H
+
+#include <stdbool.h>
+
+#include "utils/errors.h"
+
+struct nsurl;
+
+/**
+ * Content blocking rule counts
+ */
+struct blocklist_stats {
+	unsigned int domain_count; /**< number of domain rules */
+	unsigned int pattern_count; /**< number of URL text rules */
+};
+
+/**
+ * Initialise content blocking from a filter list.
+ *
+ * The compiled form of the list is kept beside it with a ".compiled"
+ *  suffix and is used in preference to the list while the list is
+ *  unchanged.
+ *
+ * \param path The filter list file.
+ * \return NSERROR_OK on success or error code on failure.
+ */
+nserror blocklist_init(const char *path);
+
+/**
+ * Finalise content blocking.
+ */
+void blocklist_fini(void);
+
+/**
+ * Check if requests to a URL are blocked.
+ *
+ * \param url The URL to check.
+ * \return true if the URL is blocked else false.
+ */
+bool blocklist_match(struct nsurl *url);
+
+/**
+ * Get the content blocking rule counts.
+ *
+ * \param stats Structure to fill with the counts.
+ */
+void blocklist_get_stats(struct blocklist_stats *stats);
+
+#endif
@@ -23,10 +23,12 @@
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <nsutils/time.h>
 
 #include "netsurf/inttypes.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/messages.h"
 #include "utils/corestrings.h"
 #include "netsurf/browser_window.h"
@@ -80,9 +82,11 @@ static void content_convert(struct content *c)
 
 	if (c->handler->data_complete != NULL) {
 		c->locked = true;
+		NSTRACE_BEGIN("content", "content_convert");
 		if (c->handler->data_complete(c) == false) {
 			content_set_error(c);
 		}
+		NSTRACE_END("content", "content_convert");
 		/* Conversion to the READY state will unlock the content */
 	} else {
 		content_set_ready(c);
@@ -91,6 +95,23 @@ static void content_convert(struct content *c)
 }
 
 
+/**
+ * Update the fetch phase times of a content from its low-level cache handle
+ *
+ * \param c The content to update.
+ */
+static void content_update_fetch_timing(struct content *c)
+{
+	struct llcache_timing fetch_timing;
+
+	if (llcache_handle_get_timing(c->llcache, &fetch_timing) == NSERROR_OK) {
+		c->timing.fetch_start = fetch_timing.fetch_start;
+		c->timing.response_start = fetch_timing.response_start;
+		c->timing.first_byte = fetch_timing.first_byte;
+	}
+}
+
+
 /**
  * Handler for low-level cache events
  *
@@ -132,6 +153,9 @@ content_llcache_callback(llcache_handle *llcache,
 
 			(void) llcache_handle_get_source_data(llcache, &source_size);
 
+			nsu_getmonotonic_ms(&c->timing.fetched);
+			content_update_fetch_timing(c);
+
 			content_set_status(c, messages_get("Processing"));
 			msg_data.explicit_status_text = NULL;
 			content_broadcast(c, CONTENT_MSG_STATUS, &msg_data);
@@ -224,6 +248,9 @@ content__init(struct content *c,
 	c->quirks = quirks;
 	c->refresh = 0;
 	nsu_getmonotonic_ms(&c->time);
+	memset(&c->timing, 0, sizeof(c->timing));
+	c->timing.created = c->time;
+	content_update_fetch_timing(c);
 	c->size = 0;
 	c->title = NULL;
 	c->active = 0;
@@ -288,6 +315,11 @@ void content_set_ready(struct content *c)
 	assert(c->locked);
 	c->locked = false;
 
+	/* handlers which parse incrementally record this themselves */
+	if (c->timing.parsed == 0) {
+		nsu_getmonotonic_ms(&c->timing.parsed);
+	}
+
 	c->status = CONTENT_STATUS_READY;
 	content_update_status(c);
 	content_broadcast(c, CONTENT_MSG_READY, NULL);
@@ -303,6 +335,9 @@ void content_set_done(struct content *c)
 
 	c->status = CONTENT_STATUS_DONE;
 	c->time = now_ms - c->time;
+	if (c->timing.done == 0) {
+		c->timing.done = now_ms;
+	}
 	content_update_status(c);
 	content_broadcast(c, CONTENT_MSG_DONE, NULL);
 }
@@ -343,6 +378,10 @@ content__reformat(struct content *c, bool background, int width, int height)
 		c->handler->reformat(c, width, height);
 		c->locked = false;
 
+		if (c->timing.laid_out == 0) {
+			nsu_getmonotonic_ms(&c->timing.laid_out);
+		}
+
 		data.background = background;
 		content_broadcast(c, CONTENT_MSG_REFORMAT, &data);
 	}
@@ -560,6 +599,7 @@ content_redraw(hlcache_handle *h,
 	       const struct redraw_context *ctx)
 {
 	struct content *c = hlcache_handle_get_content(h);
+	bool res;
 
 	assert(c != NULL);
 
@@ -573,7 +613,13 @@ content_redraw(hlcache_handle *h,
 		return true;
 	}
 
-	return c->handler->redraw(c, data, clip, ctx);
+	res = c->handler->redraw(c, data, clip, ctx);
+
+	if (c->timing.redrawn == 0) {
+		nsu_getmonotonic_ms(&c->timing.redrawn);
+	}
+
+	return res;
 }
 
 
@@ -1108,6 +1154,21 @@ const char *content_get_title(hlcache_handle *h)
 }
 
 
+/* exported interface documented in netsurf/content.h */
+nserror content_get_timing(hlcache_handle *h, struct content_timing *timing)
+{
+	struct content *c = hlcache_handle_get_content(h);
+
+	if (c == NULL) {
+		return NSERROR_BAD_PARAMETER;
+	}
+
+	*timing = c->timing;
+
+	return NSERROR_OK;
+}
+
+
 /* exported interface documented in content/content_protected.h */
 const char *content__get_title(struct content *c)
 {
@@ -1416,6 +1477,7 @@ nserror content__clone(const struct content *c, struct content *nc)
 
 	nc->time = c->time;
 	nc->reformat_time = c->reformat_time;
+	nc->timing = c->timing;
 	nc->size = c->size;
 
 	if (c->title != NULL) {
@@ -31,6 +31,7 @@
 #include <libwapcaplet/libwapcaplet.h>
 
 #include "netsurf/content_type.h"
+#include "netsurf/content.h"
 #include "desktop/search.h" /* search flags enum */
 #include "netsurf/mouse.h" /* mouse state enums */
 
@@ -246,6 +247,11 @@ struct content {
 	 */
 	uint64_t reformat_time;
 
+	/**
+	 * Times at which each phase of loading completed.
+	 */
+	struct content_timing timing;
+
 	/**
 	 * Estimated size of all data associated with this content
 	 */
@@ -39,11 +39,13 @@
 #include <strings.h>
 #include <time.h>
 #include <libwapcaplet/libwapcaplet.h>
+#include <nsutils/time.h>
 
 #include "utils/config.h"
 #include "utils/corestrings.h"
 #include "utils/nsoption.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/messages.h"
 #include "utils/nsurl.h"
 #include "utils/ring.h"
@@ -98,7 +100,9 @@ struct fetch {
 	int fetcherd;           /**< Fetcher descriptor for this fetch */
 	void *fetcher_handle;	/**< The handle for the fetcher. */
 	bool fetch_is_active;	/**< This fetch is active. */
+	bool reused;		/**< An existing connection was reused */
 	fetch_msg_type last_msg;/**< The last message sent for this fetch */
+	struct fetch_timing timing; /**< Times of each fetch phase */
 	struct fetch *r_prev;	/**< Previous active fetch in ::fetch_ring. */
 	struct fetch *r_next;	/**< Next active fetch in ::fetch_ring. */
 };
@@ -106,6 +110,18 @@ struct fetch {
 static struct fetch *fetch_ring = NULL;	/**< Ring of active fetches. */
 static struct fetch *queue_ring = NULL;	/**< Ring of queued fetches */
 
+/** Number of completed fetches remembered for enumeration */
+#define FETCH_HISTORY_SIZE 32
+
+/** Recently completed fetches, a ring indexed by ::fetch_history_next */
+static struct fetch_info fetch_history[FETCH_HISTORY_SIZE];
+static unsigned int fetch_history_next = 0;
+
+/** Fetch statistics totals */
+static uint64_t fetch_total_started = 0;
+static uint64_t fetch_total_finished = 0;
+static uint64_t fetch_total_reused = 0;
+
 /******************************************************************************
  * fetch internals							      *
  ******************************************************************************/
@@ -160,6 +176,8 @@ static bool fetch_dispatch_job(struct fetch *fetch)
 	} else {
 		RING_INSERT(fetch_ring, fetch);
 		fetch->fetch_is_active = true;
+		nsu_getmonotonic_ms(&fetch->timing.started);
+		fetch_total_started++;
 		return true;
 	}
 }
@@ -257,6 +275,9 @@ static bool fetch_dispatch_jobs(void)
 	NSLOG(fetch, DEBUG, "Fetch ring is now %d elements.", all_active);
 	NSLOG(fetch, DEBUG, "Queue ring is now %d elements.", all_queued);
 
+	NSTRACE_COUNTER("fetch", "active_fetches", all_active);
+	NSTRACE_COUNTER("fetch", "queued_fetches", all_queued);
+
 	return (all_active > 0);
 }
 
@@ -351,6 +372,18 @@ void fetcher_quit(void)
 			fetch_unref_fetcher(fetcherd);
 		}
 	}
+
+	for (fetcherd = 0; fetcherd < FETCH_HISTORY_SIZE; fetcherd++) {
+		struct fetch_info *info = &fetch_history[fetcherd];
+		if (info->url != NULL) {
+			nsurl_unref(info->url);
+			info->url = NULL;
+		}
+		if (info->host != NULL) {
+			lwc_string_unref(info->host);
+			info->host = NULL;
+		}
+	}
 }
 
 /* exported interface documented in content/fetchers.h */
@@ -562,6 +595,9 @@ fetch_start(nsurl *url,
 
 	/* Dump new fetch in the queue. */
 	RING_INSERT(queue_ring, fetch);
+	nsu_getmonotonic_ms(&fetch->timing.queued);
+
+	NSTRACE_ASYNC_BEGIN("fetch", "fetch", fetch);
 
 	/* Ask the queue to run. */
 	if (fetch_dispatch_jobs()) {
@@ -578,6 +614,9 @@ fetch_start(nsurl *url,
 void fetch_abort(struct fetch *f)
 {
 	assert(f);
+	if (f->last_msg < FETCH_MIN_FINISHED_MSG) {
+		NSTRACE_ASYNC_END("fetch", "fetch", f);
+	}
 	f->last_msg = FETCH__INTERNAL_ABORTED;
 	NSLOG(fetch, DEBUG,
 	      "fetch %p, fetcher %p, url '%s'", f, f->fetcher_handle,
@@ -585,6 +624,36 @@ void fetch_abort(struct fetch *f)
 	fetchers[f->fetcherd].ops.abort(f->fetcher_handle);
 }
 
+/**
+ * Remember a fetch which is being freed in the recent fetch history.
+ *
+ * \param f The fetch to remember.
+ */
+static void fetch_record_history(struct fetch *f)
+{
+	struct fetch_info *info = &fetch_history[fetch_history_next];
+
+	if (info->url != NULL) {
+		nsurl_unref(info->url);
+	}
+	if (info->host != NULL) {
+		lwc_string_unref(info->host);
+	}
+
+	info->url = nsurl_ref(f->url);
+	info->host = (f->host != NULL) ? lwc_string_ref(f->host) : NULL;
+	info->state = FETCH_INFO_FINISHED;
+	info->http_code = f->http_code;
+	info->reused = f->reused;
+	info->timing = f->timing;
+	if (info->timing.finished == 0) {
+		/* aborted before finishing */
+		nsu_getmonotonic_ms(&info->timing.finished);
+	}
+
+	fetch_history_next = (fetch_history_next + 1) % FETCH_HISTORY_SIZE;
+}
+
 /* exported interface documented in content/fetch.h */
 void fetch_free(struct fetch *f)
 {
@@ -607,6 +676,8 @@ void fetch_free(struct fetch *f)
 	      f,
 	      f->fetcher_handle);
 
+	fetch_record_history(f);
+
 	fetchers[f->fetcherd].ops.free(f->fetcher_handle);
 
 	fetch_unref_fetcher(f->fetcherd);
@@ -797,6 +868,20 @@ fetch_multipart_data_new_kv(struct fetch_multipart_data **list,
 void
 fetch_send_callback(const fetch_msg *msg, struct fetch *fetch)
 {
+	if ((msg->type >= FETCH_MIN_FINISHED_MSG) &&
+	    (fetch->last_msg < FETCH_MIN_FINISHED_MSG)) {
+		NSTRACE_ASYNC_END("fetch", "fetch", fetch);
+		nsu_getmonotonic_ms(&fetch->timing.finished);
+		fetch_total_finished++;
+		if (fetch->reused) {
+			fetch_total_reused++;
+		}
+	} else if ((fetch->timing.response == 0) &&
+		   ((msg->type == FETCH_HEADER) ||
+		    (msg->type == FETCH_DATA))) {
+		nsu_getmonotonic_ms(&fetch->timing.response);
+	}
+
 	/* Bump the last_msg to the greatest seen msg */
 	if (msg->type > fetch->last_msg)
 		fetch->last_msg = msg->type;
@@ -828,6 +913,82 @@ void fetch_remove_from_queues(struct fetch *fetch)
 
 	NSLOG(fetch, DEBUG, "Fetch ring is now %d elements.", all_active);
 	NSLOG(fetch, DEBUG, "Queue ring is now %d elements.", all_queued);
+
+	NSTRACE_COUNTER("fetch", "active_fetches", all_active);
+	NSTRACE_COUNTER("fetch", "queued_fetches", all_queued);
+}
+
+
+/* exported interface documented in content/fetch.h */
+void fetch_set_reused(struct fetch *fetch, bool reused)
+{
+	fetch->reused = reused;
+}
+
+
+/**
+ * Make the enumeration callback for each fetch in a ring.
+ */
+static void
+fetch_enumerate_ring(struct fetch *ring,
+		     enum fetch_info_state state,
+		     fetch_enumerate_cb *cb,
+		     void *pw)
+{
+	struct fetch *f = ring;
+	struct fetch_info info;
+
+	if (f == NULL) {
+		return;
+	}
+
+	do {
+		info.url = f->url;
+		info.host = f->host;
+		info.state = state;
+		info.http_code = f->http_code;
+		info.reused = f->reused;
+		info.timing = f->timing;
+		cb(&info, pw);
+		f = f->r_next;
+	} while (f != ring);
+}
+
+
+/* exported interface documented in content/fetch.h */
+void fetch_enumerate(fetch_enumerate_cb *cb, void *pw)
+{
+	unsigned int idx;
+
+	fetch_enumerate_ring(queue_ring, FETCH_INFO_QUEUED, cb, pw);
+	fetch_enumerate_ring(fetch_ring, FETCH_INFO_ACTIVE, cb, pw);
+
+	for (idx = 1; idx <= FETCH_HISTORY_SIZE; idx++) {
+		struct fetch_info *info;
+
+		info = &fetch_history[(fetch_history_next +
+				       FETCH_HISTORY_SIZE - idx) %
+				      FETCH_HISTORY_SIZE];
+		if (info->url == NULL) {
+			break;
+		}
+		cb(info, pw);
+	}
+}
+
+
+/* exported interface documented in content/fetch.h */
+void fetch_get_stats(struct fetch_stats *stats)
+{
+	int size;
+
+	RING_GETSIZE(struct fetch, queue_ring, size);
+	stats->queued = size;
+	RING_GETSIZE(struct fetch, fetch_ring, size);
+	stats->active = size;
+	stats->started = fetch_total_started;
+	stats->finished = fetch_total_finished;
+	stats->reused = fetch_total_reused;
 }
 
 
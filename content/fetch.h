@@ -24,6 +24,7 @@
 #define _NETSURF_DESKTOP_FETCH_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "utils/config.h"
 #include "utils/nsurl.h"
@@ -229,6 +230,11 @@ void fetch_free(struct fetch *f);
  */
 void fetch_set_http_code(struct fetch *fetch, long http_code);
 
+/**
+ * set whether a fetch reused an existing connection
+ */
+void fetch_set_reused(struct fetch *fetch, bool reused);
+
 /**
  * get the referer from the fetch
  */
@@ -239,6 +245,76 @@ const char *fetch_get_referer_to_send(struct fetch *fetch);
  */
 void fetch_set_cookie(struct fetch *fetch, const char *data);
 
+/**
+ * Times a fetch reached each phase, in monotonic milliseconds.
+ *
+ * A phase which has not been reached is zero.
+ */
+struct fetch_timing {
+	uint64_t queued; /**< fetch was queued */
+	uint64_t started; /**< fetch was dispatched to its fetcher */
+	uint64_t response; /**< first header or data was received */
+	uint64_t finished; /**< fetch finished or was aborted */
+};
+
+/**
+ * State of a fetch being enumerated.
+ */
+enum fetch_info_state {
+	FETCH_INFO_QUEUED, /**< waiting to be dispatched */
+	FETCH_INFO_ACTIVE, /**< dispatched to its fetcher */
+	FETCH_INFO_FINISHED, /**< recently completed */
+};
+
+/**
+ * Information about a fetch.
+ */
+struct fetch_info {
+	nsurl *url; /**< URL being fetched */
+	lwc_string *host; /**< host of URL, may be NULL */
+	enum fetch_info_state state; /**< state of the fetch */
+	long http_code; /**< HTTP response code, or 0 */
+	bool reused; /**< an existing connection was reused */
+	struct fetch_timing timing; /**< phase times */
+};
+
+/**
+ * Fetch statistics.
+ */
+struct fetch_stats {
+	unsigned int queued; /**< number of queued fetches */
+	unsigned int active; /**< number of active fetches */
+	uint64_t started; /**< total fetches dispatched */
+	uint64_t finished; /**< total fetches completed */
+	uint64_t reused; /**< total fetches reusing a connection */
+};
+
+/**
+ * Callback for each fetch from fetch_enumerate()
+ *
+ * \param info The fetch information, only valid during the call.
+ * \param pw The context passed to fetch_enumerate()
+ */
+typedef void (fetch_enumerate_cb)(const struct fetch_info *info, void *pw);
+
+/**
+ * Enumerate fetches.
+ *
+ * The callback is made for each queued and active fetch and then for
+ * the recently completed fetches, most recent first.
+ *
+ * \param cb The callback to make for each fetch.
+ * \param pw The context to pass to the callback.
+ */
+void fetch_enumerate(fetch_enumerate_cb *cb, void *pw);
+
+/**
+ * Get fetch statistics.
+ *
+ * \param stats Structure to fill with the statistics.
+ */
+void fetch_get_stats(struct fetch_stats *stats);
+
 /**
  * Get the set of file descriptors the fetchers are currently using.
  *
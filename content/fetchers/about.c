@@ -30,6 +30,7 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <nsutils/time.h>
 
 #include "netsurf/inttypes.h"
 #include "netsurf/plot_style.h"
@@ -46,6 +47,10 @@
 #include "content/fetch.h"
 #include "content/fetchers.h"
 #include "content/fetchers/about.h"
+#include "content/backing_store.h"
+#include "content/llcache.h"
+#include "content/hlcache.h"
+#include "content/blocklist.h"
 #include "image/image_cache.h"
 
 #include "desktop/system_colour.h"
@@ -436,6 +441,462 @@ fetch_about_imagecache_handler_aborted:
 	return false;
 }
 
+
+/**
+ * Compute a count as a percentage of a total.
+ *
+ * \param count The count.
+ * \param total The total the count is part of.
+ * \return The percentage or zero if the total is zero.
+ */
+static unsigned int about_percent(uint64_t count, uint64_t total)
+{
+	if (total == 0) {
+		return 0;
+	}
+	return (unsigned int)((count * 100) / total);
+}
+
+
+/**
+ * Handler to generate about:cache page.
+ *
+ * Shows the statistics of the low and high level caches, content
+ *  blocking and the persistent backing store.
+ *
+ * \param ctx The fetcher context.
+ * \return true if handled false if aborted.
+ */
+static bool fetch_about_cache_handler(struct fetch_about_context *ctx)
+{
+	struct llcache_stats ll;
+	struct hlcache_stats hl;
+	struct backing_store_stats bs;
+	struct blocklist_stats bl;
+	uint64_t lookups;
+	nserror res;
+
+	/* content is going to return ok */
+	fetch_set_http_code(ctx->fetchh, 200);
+
+	/* content type */
+	if (fetch_about_send_header(ctx, "Content-Type: text/html")) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	res = ssenddataf(ctx,
+			"<html>\n<head>\n"
+			"<title>Cache Status</title>\n"
+			"<link rel=\"stylesheet\" type=\"text/css\" "
+			"href=\"resource:internal.css\">\n"
+			"</head>\n"
+			"<body id =\"cachestats\" "
+				"class=\"ns-even-bg ns-even-fg ns-border\">\n"
+			"<h1 class=\"ns-border\">Cache Status</h1>\n");
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	/* low level cache */
+	res = llcache_get_stats(&ll);
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+	lookups = ll.hit_count + ll.revalidate_count + ll.miss_count;
+
+	res = ssenddataf(ctx,
+			"<h2 class=\"ns-border\">Memory cache</h2>\n"
+			"<table class=\"stats\">\n"
+			"<tr><th>Configured limit</th><td>%"PRIsizet"</td></tr>\n"
+			"<tr><th>Size in use</th><td>%"PRIsizet" (%u%%)</td></tr>\n"
+			"<tr><th>Cacheable objects</th><td>%u</td></tr>\n"
+			"<tr><th>Uncacheable objects</th><td>%u</td></tr>\n"
+			"<tr><th>Objects in backing store</th><td>%u</td></tr>\n"
+			"<tr><th>Hit/revalidate/miss</th>"
+				"<td>%"PRIu64"/%"PRIu64"/%"PRIu64" "
+				"(%u%%/%u%%/%u%%)</td></tr>\n"
+			"<tr><th>Evictions</th>"
+				"<td>%"PRIu64" (%"PRIu64" bytes)</td></tr>\n"
+			"</table>\n",
+			ll.limit,
+			ll.size, about_percent(ll.size, ll.limit),
+			ll.cached_count,
+			ll.uncached_count,
+			ll.disc_count,
+			ll.hit_count, ll.revalidate_count, ll.miss_count,
+			about_percent(ll.hit_count, lookups),
+			about_percent(ll.revalidate_count, lookups),
+			about_percent(ll.miss_count, lookups),
+			ll.evict_count, ll.evict_size);
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	/* high level cache */
+	res = hlcache_get_stats(&hl);
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	res = ssenddataf(ctx,
+			"<h2 class=\"ns-border\">Content cache</h2>\n"
+			"<table class=\"stats\">\n"
+			"<tr><th>Contents</th><td>%u (%u in use)</td></tr>\n"
+			"<tr><th>Awaiting type</th><td>%u</td></tr>\n"
+			"<tr><th>Hit/miss</th><td>%u/%u (%u%%/%u%%)</td></tr>\n"
+			"<tr><th>Retained stylesheets</th>"
+				"<td>%u (%"PRIsizet" bytes)</td></tr>\n"
+			"</table>\n",
+			hl.content_count, hl.user_count,
+			hl.retrieving_count,
+			hl.hit_count, hl.miss_count,
+			about_percent(hl.hit_count,
+				      hl.hit_count + hl.miss_count),
+			about_percent(hl.miss_count,
+				      hl.hit_count + hl.miss_count),
+			hl.retained_count, hl.retained_size);
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	/* content blocking */
+	blocklist_get_stats(&bl);
+	res = ssenddataf(ctx,
+			"<h2 class=\"ns-border\">Content blocking</h2>\n"
+			"<table class=\"stats\">\n"
+			"<tr><th>Domain/URL rules</th><td>%u/%u</td></tr>\n"
+			"<tr><th>Blocked requests</th><td>%"PRIu64"</td></tr>\n"
+			"<tr><th>Estimated data saved</th>"
+				"<td>%"PRIu64" bytes</td></tr>\n"
+			"</table>\n",
+			bl.domain_count, bl.pattern_count,
+			ll.blocked_count,
+			ll.blocked_size);
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	/* persistent storage */
+	res = ssenddataf(ctx,
+			"<h2 class=\"ns-border\">Persistence</h2>\n"
+			"<table class=\"stats\">\n"
+			"<tr><th>Written</th>"
+				"<td>%"PRIu64" bytes in %"PRIu64"ms</td></tr>\n"
+			"<tr><th>Average bandwidth</th>"
+				"<td>%"PRIu64" bytes/s</td></tr>\n"
+			"<tr><th>Minimum/maximum bandwidth</th>"
+				"<td>%"PRIsizet"/%"PRIsizet" bytes/s</td></tr>\n"
+			"</table>\n",
+			ll.total_written, ll.total_elapsed,
+			(ll.total_elapsed == 0) ? 0 :
+				(ll.total_written * 1000) / ll.total_elapsed,
+			ll.minimum_bandwidth, ll.maximum_bandwidth);
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	if (llcache_get_store_stats(&bs) == NSERROR_OK) {
+		res = ssenddataf(ctx,
+			"<h2 class=\"ns-border\">Backing store</h2>\n"
+			"<table class=\"stats\">\n"
+			"<tr><th>Configured limit</th><td>%"PRIsizet"</td></tr>\n"
+			"<tr><th>Size in use</th><td>%"PRIu64"</td></tr>\n"
+			"<tr><th>Entries</th><td>%"PRIsizet"</td></tr>\n"
+			"<tr><th>Hit/miss</th>"
+				"<td>%"PRIsizet"/%"PRIsizet" (%u%%/%u%%)</td></tr>\n"
+			"<tr><th>Data served</th><td>%"PRIu64" bytes</td></tr>\n"
+			"<tr><th>Evictions</th>"
+				"<td>%"PRIsizet" (%"PRIu64" bytes)</td></tr>\n"
+			"<tr><th>Data blocks used/extent</th>"
+				"<td>%u/%u (%u holes)</td></tr>\n"
+			"<tr><th>Metadata blocks used/extent</th>"
+				"<td>%u/%u (%u holes)</td></tr>\n"
+			"</table>\n",
+			bs.limit,
+			bs.size,
+			bs.entry_count,
+			bs.hit_count, bs.miss_count,
+			about_percent(bs.hit_count,
+				      bs.hit_count + bs.miss_count),
+			about_percent(bs.miss_count,
+				      bs.hit_count + bs.miss_count),
+			bs.hit_size,
+			bs.evict_count, bs.evict_size,
+			bs.blocks_used[0], bs.blocks_extent[0],
+			bs.blocks_extent[0] - bs.blocks_used[0],
+			bs.blocks_used[1], bs.blocks_extent[1],
+			bs.blocks_extent[1] - bs.blocks_used[1]);
+		if (res != NSERROR_OK) {
+			goto fetch_about_cache_handler_aborted;
+		}
+	}
+
+	res = ssenddataf(ctx,
+			"<p>Decoded images are shown by "
+			"<a href=\"about:imagecache\">about:imagecache</a></p>\n"
+			"</body>\n</html>\n");
+	if (res != NSERROR_OK) {
+		goto fetch_about_cache_handler_aborted;
+	}
+
+	fetch_about_send_finished(ctx);
+
+	return true;
+
+fetch_about_cache_handler_aborted:
+	return false;
+}
+
+
+/**
+ * Fetch counts for one host on the about:fetch page
+ */
+struct about_fetch_host {
+	lwc_string *host; /**< host name */
+	unsigned int queued; /**< number of queued fetches */
+	unsigned int active; /**< number of active fetches */
+};
+
+
+/**
+ * State used while enumerating fetches for the about:fetch page
+ */
+struct about_fetch_ctx {
+	struct fetch_about_context *ctx; /**< fetcher context */
+	struct about_fetch_host *hosts; /**< per host counts */
+	unsigned int host_count; /**< number of entries in hosts */
+	uint64_t now; /**< time the page was generated */
+	bool even; /**< the next row is even */
+	nserror res; /**< first error encountered */
+};
+
+
+/**
+ * Fetch enumeration callback accumulating the per host counts.
+ */
+static void about_fetch_host_cb(const struct fetch_info *info, void *pw)
+{
+	struct about_fetch_ctx *afc = pw;
+	struct about_fetch_host *hosts;
+	unsigned int idx;
+	bool match;
+
+	if ((info->host == NULL) ||
+	    (info->state == FETCH_INFO_FINISHED) ||
+	    (afc->res != NSERROR_OK)) {
+		return;
+	}
+
+	for (idx = 0; idx < afc->host_count; idx++) {
+		if ((lwc_string_caseless_isequal(afc->hosts[idx].host,
+						 info->host,
+						 &match) == lwc_error_ok) &&
+		    match) {
+			break;
+		}
+	}
+
+	if (idx == afc->host_count) {
+		hosts = realloc(afc->hosts, (idx + 1) * sizeof(*hosts));
+		if (hosts == NULL) {
+			afc->res = NSERROR_NOMEM;
+			return;
+		}
+		afc->hosts = hosts;
+		afc->hosts[idx].host = info->host;
+		afc->hosts[idx].queued = 0;
+		afc->hosts[idx].active = 0;
+		afc->host_count++;
+	}
+
+	if (info->state == FETCH_INFO_QUEUED) {
+		afc->hosts[idx].queued++;
+	} else {
+		afc->hosts[idx].active++;
+	}
+}
+
+
+/**
+ * Fetch enumeration callback generating a row of the fetch table.
+ */
+static void about_fetch_row_cb(const struct fetch_info *info, void *pw)
+{
+	struct about_fetch_ctx *afc = pw;
+	const struct fetch_timing *t = &info->timing;
+	const char *state;
+	uint64_t end;
+	char wait[24] = "";
+	char response[24] = "";
+	char total[24] = "";
+
+	if (afc->res != NSERROR_OK) {
+		return;
+	}
+
+	switch (info->state) {
+	case FETCH_INFO_QUEUED:
+		state = "queued";
+		snprintf(wait, sizeof(wait), "%"PRIu64, afc->now - t->queued);
+		break;
+
+	case FETCH_INFO_ACTIVE:
+		state = "active";
+		break;
+
+	default:
+		state = "finished";
+		break;
+	}
+
+	if (info->state != FETCH_INFO_QUEUED) {
+		end = (t->finished != 0) ? t->finished : afc->now;
+		/* a fetch aborted while queued never started */
+		if (t->started != 0) {
+			snprintf(wait, sizeof(wait), "%"PRIu64,
+				 t->started - t->queued);
+			if (t->response != 0) {
+				snprintf(response, sizeof(response), "%"PRIu64,
+					 t->response - t->started);
+			}
+		}
+		snprintf(total, sizeof(total), "%"PRIu64, end - t->queued);
+	}
+
+	afc->res = ssenddataf(afc->ctx,
+			"<tr%s><td>%s</td><td class=\"url\">%s</td>"
+			"<td>%ld</td><td>%s</td>"
+			"<td>%s</td><td>%s</td><td>%s</td></tr>\n",
+			afc->even ? "" : " class=\"ns-odd-bg\"",
+			state,
+			nsurl_access(info->url),
+			info->http_code,
+			info->reused ? "yes" : "no",
+			wait, response, total);
+	afc->even = !afc->even;
+}
+
+
+/**
+ * Handler to generate about:fetch page.
+ *
+ * Shows the fetch queue, per host connection use and the timing of
+ *  current and recently completed fetches.
+ *
+ * \param ctx The fetcher context.
+ * \return true if handled false if aborted.
+ */
+static bool fetch_about_fetch_handler(struct fetch_about_context *ctx)
+{
+	struct about_fetch_ctx afc = {
+		.ctx = ctx,
+		.res = NSERROR_OK,
+	};
+	struct fetch_stats stats;
+	unsigned int idx;
+	nserror res;
+
+	/* content is going to return ok */
+	fetch_set_http_code(ctx->fetchh, 200);
+
+	/* content type */
+	if (fetch_about_send_header(ctx, "Content-Type: text/html")) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	fetch_get_stats(&stats);
+	nsu_getmonotonic_ms(&afc.now);
+
+	res = ssenddataf(ctx,
+			"<html>\n<head>\n"
+			"<title>Fetch Status</title>\n"
+			"<link rel=\"stylesheet\" type=\"text/css\" "
+			"href=\"resource:internal.css\">\n"
+			"</head>\n"
+			"<body id =\"cachestats\" "
+				"class=\"ns-even-bg ns-even-fg ns-border\">\n"
+			"<h1 class=\"ns-border\">Fetch Status</h1>\n"
+			"<table class=\"stats\">\n"
+			"<tr><th>Queued</th><td>%u</td></tr>\n"
+			"<tr><th>Active</th><td>%u (limit %d, %d per host)</td></tr>\n"
+			"<tr><th>Started/finished</th>"
+				"<td>%"PRIu64"/%"PRIu64"</td></tr>\n"
+			"<tr><th>Connections reused</th>"
+				"<td>%"PRIu64" (%u%%)</td></tr>\n"
+			"</table>\n",
+			stats.queued,
+			stats.active,
+			nsoption_int(max_fetchers),
+			nsoption_int(max_fetchers_per_host),
+			stats.started, stats.finished,
+			stats.reused,
+			about_percent(stats.reused, stats.finished));
+	if (res != NSERROR_OK) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	/* per host counts */
+	fetch_enumerate(about_fetch_host_cb, &afc);
+	if (afc.res != NSERROR_OK) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	res = ssenddataf(ctx,
+			"<h2 class=\"ns-border\">Hosts</h2>\n"
+			"<table class=\"list\">\n"
+			"<tr><th>Host</th><th>Queued</th><th>Active</th></tr>\n");
+	if (res != NSERROR_OK) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	for (idx = 0; idx < afc.host_count; idx++) {
+		res = ssenddataf(ctx,
+				"<tr%s><td>%s</td><td>%u</td><td>%u</td></tr>\n",
+				(idx & 1) ? " class=\"ns-odd-bg\"" : "",
+				lwc_string_data(afc.hosts[idx].host),
+				afc.hosts[idx].queued,
+				afc.hosts[idx].active);
+		if (res != NSERROR_OK) {
+			goto fetch_about_fetch_handler_aborted;
+		}
+	}
+
+	/* individual fetches */
+	res = ssenddataf(ctx,
+			"</table>\n"
+			"<h2 class=\"ns-border\">Fetches</h2>\n"
+			"<p>Times are in milliseconds.</p>\n"
+			"<table class=\"list\">\n"
+			"<tr><th>State</th><th>URL</th><th>Code</th>"
+			"<th>Reused</th><th>Queued</th><th>Response</th>"
+			"<th>Total</th></tr>\n");
+	if (res != NSERROR_OK) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	afc.even = true;
+	fetch_enumerate(about_fetch_row_cb, &afc);
+	if (afc.res != NSERROR_OK) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	res = ssenddataf(ctx, "</table>\n</body>\n</html>\n");
+	if (res != NSERROR_OK) {
+		goto fetch_about_fetch_handler_aborted;
+	}
+
+	free(afc.hosts);
+
+	fetch_about_send_finished(ctx);
+
+	return true;
+
+fetch_about_fetch_handler_aborted:
+	free(afc.hosts);
+	return false;
+}
+
+
 /**
  * certificate name parameters
  */
@@ -2652,6 +3113,22 @@ struct about_handlers about_handler_list[] = {
 		fetch_about_imagecache_handler,
 		true
 	},
+	{
+		/* statistics of the caches */
+		"cache",
+		SLEN("cache"),
+		NULL,
+		fetch_about_cache_handler,
+		true
+	},
+	{
+		/* details of current and recent fetches */
+		"fetch",
+		SLEN("fetch"),
+		NULL,
+		fetch_about_fetch_handler,
+		true
+	},
 	{
 		/* The default blank page */
 		"blank",
@@ -1255,6 +1255,7 @@ static void fetch_curl_done(CURL *curl_handle, CURLcode result)
 	struct curl_fetch_info *f;
 	char **_hideous_hack = (char **) (void *) &f;
 	CURLcode code;
+	long num_connects;
 
 	/* find the structure associated with this fetch */
 	/* For some reason, cURL thinks CURLINFO_PRIVATE should be a string?! */
@@ -1264,6 +1265,13 @@ static void fetch_curl_done(CURL *curl_handle, CURLcode result)
 	abort_fetch = f->abort;
 	NSLOG(netsurf, INFO, "done %s", nsurl_access(f->url));
 
+	/* a fetch which needed no new connection reused an existing one */
+	code = curl_easy_getinfo(curl_handle, CURLINFO_NUM_CONNECTS,
+				 &num_connects);
+	if (code == CURLE_OK) {
+		fetch_set_reused(f->fetch_handle, num_connects == 0);
+	}
+
 	if ((abort_fetch == false) &&
 	    (result == CURLE_OK ||
 	     ((result == CURLE_WRITE_ERROR) && (f->stopped == false)))) {
@@ -22,6 +22,11 @@
  * file scheme URL handling. Based on the data fetcher by Rob Kendrick
  *
  * output dates and directory ordering are affected by the current locale
+ *
+ * Fetches are processed incrementally from the poll loop. Each poll
+ *  reads a bounded chunk of a plain file, or a bounded batch of
+ *  directory entries, for every active fetch so neither large files
+ *  nor large directories block the browser.
  */
 
 #include "utils/config.h"
@@ -39,10 +44,8 @@
 #include <time.h>
 #include <stdio.h>
 #include <stdarg.h>
-#ifdef HAVE_MMAP
-#include <sys/mman.h>
-#endif
 #include <libwapcaplet/libwapcaplet.h>
+#include <nsutils/time.h>
 
 #include "netsurf/inttypes.h"
 #include "utils/nsurl.h"
@@ -65,6 +68,21 @@
 /* Maximum size of read buffer */
 #define FETCH_FILE_MAX_BUF_SIZE (1024 * 1024)
 
+/* Number of directory entries read or output in one step */
+#define FETCH_FILE_DIR_BATCH 64
+
+/* Time in ms a fetch may be processed for in one poll */
+#define FETCH_FILE_POLL_TIME 5
+
+/** Progress of a file fetch */
+enum fetch_file_state {
+	FETCH_FILE_STATE_START, /**< fetch has not been started */
+	FETCH_FILE_STATE_PLAIN, /**< reading plain file data */
+	FETCH_FILE_STATE_DIR_READ, /**< reading directory entry names */
+	FETCH_FILE_STATE_DIR_LIST, /**< generating directory listing rows */
+	FETCH_FILE_STATE_DONE, /**< fetch is complete */
+};
+
 /** Context for a fetch */
 struct fetch_file_context {
 	struct fetch_file_context *r_next, *r_prev;
@@ -78,6 +96,21 @@ struct fetch_file_context {
 	char *path; /**< The actual path to be used with open() */
 
 	time_t file_etag; /**< Request etag for file (previous st.m_time) */
+
+	enum fetch_file_state state; /**< Progress of the fetch */
+
+	int fd; /**< The file descriptor of a plain file or -1 */
+	off_t size; /**< Size of the plain file */
+	off_t offset; /**< Offset of the next read from the plain file */
+	uint8_t *buf; /**< Plain file read buffer */
+	size_t buf_size; /**< Size of the read buffer */
+
+	DIR *dir; /**< Directory being listed or NULL */
+	char **names; /**< Names of the directory entries */
+	size_t name_count; /**< Number of directory entry names */
+	size_t name_alloc; /**< Allocated size of names */
+	size_t name_next; /**< Index of next name to output */
+	bool even; /**< Next directory listing row is even */
 };
 
 static struct fetch_file_context *ring = NULL;
@@ -157,6 +190,7 @@ fetch_file_setup(struct fetch *fetchh,
 	}
 
 	ctx->url = nsurl_ref(url);
+	ctx->fd = -1;
 
 	/* Scan request headers looking for If-None-Match */
 	for (i = 0; headers[i] != NULL; i++) {
@@ -193,6 +227,19 @@ fetch_file_setup(struct fetch *fetchh,
 static void fetch_file_free(void *ctx)
 {
 	struct fetch_file_context *c = ctx;
+	size_t i;
+
+	if (c->fd >= 0) {
+		close(c->fd);
+	}
+	free(c->buf);
+	if (c->dir != NULL) {
+		closedir(c->dir);
+	}
+	for (i = 0; i < c->name_count; i++) {
+		free(c->names[i]);
+	}
+	free(c->names);
 	nsurl_unref(c->url);
 	free(c->path);
 	free(ctx);
@@ -268,16 +315,18 @@ fetch_file_process_error_aborted:
 }
 
 
-/** Process object as a regular file */
-static void fetch_file_process_plain(struct fetch_file_context *ctx,
-				     struct stat *fdstat)
+/**
+ * Start processing object as a regular file
+ *
+ * Opens the file and sends the headers; the data is read by
+ *  fetch_file_process_plain() in chunks.
+ */
+static void fetch_file_start_plain(struct fetch_file_context *ctx,
+				   struct stat *fdstat)
 {
-#ifdef HAVE_MMAP
 	fetch_msg msg;
-	char *buf = NULL;
-	size_t buf_size;
 
-	int fd; /**< The file descriptor of the object */
+	ctx->state = FETCH_FILE_STATE_DONE;
 
 	/* Check if we can just return not modified */
 	if (ctx->file_etag != 0 && ctx->file_etag == fdstat->st_mtime) {
@@ -287,25 +336,33 @@ static void fetch_file_process_plain(struct fetch_file_context *ctx,
 		return;
 	}
 
-	fd = open(ctx->path, O_RDONLY);
-	if (fd < 0) {
+	ctx->fd = open(ctx->path, O_RDONLY);
+	if (ctx->fd < 0) {
 		/* process errors as appropriate */
 		fetch_file_process_error(ctx,
 				fetch_file_errno_to_http_code(errno));
 		return;
 	}
 
+#ifdef HAVE_POSIX_FADVISE
+	/* the whole file is read in order so let the OS read ahead */
+	posix_fadvise(ctx->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
 	/* set buffer size */
-	buf_size = fdstat->st_size;
+	ctx->size = fdstat->st_size;
+	ctx->buf_size = fdstat->st_size;
+	if (ctx->buf_size > FETCH_FILE_MAX_BUF_SIZE)
+		ctx->buf_size = FETCH_FILE_MAX_BUF_SIZE;
 
 	/* allocate the buffer storage */
-	if (buf_size > 0) {
-		buf = mmap(NULL, buf_size, PROT_READ, MAP_SHARED, fd, 0);
-		if (buf == MAP_FAILED) {
+	if (ctx->buf_size > 0) {
+		ctx->buf = malloc(ctx->buf_size);
+		if (ctx->buf == NULL) {
 			msg.type = FETCH_ERROR;
-			msg.data.error = "Unable to map memory for file data buffer";
+			msg.data.error =
+				"Unable to allocate memory for file data buffer";
 			fetch_file_send_callback(&msg, ctx);
-			close(fd);
 			return;
 		}
 	}
@@ -319,142 +376,80 @@ static void fetch_file_process_plain(struct fetch_file_context *ctx,
 	 */
 
 	/* content type */
-	if (fetch_file_send_header(ctx, "Content-Type: %s", 
+	if (fetch_file_send_header(ctx, "Content-Type: %s",
 				   guit->fetch->filetype(ctx->path))) {
-		goto fetch_file_process_aborted;
+		return;
 	}
 
 	/* content length */
 	if (fetch_file_send_header(ctx, "Content-Length: %" PRIsizet,
 				   fdstat->st_size)) {
-		goto fetch_file_process_aborted;
+		return;
 	}
 
 	/* create etag */
 	if (fetch_file_send_header(ctx, "ETag: \"%10" PRId64 "\"",
 				   (int64_t) fdstat->st_mtime)) {
-		goto fetch_file_process_aborted;
+		return;
 	}
 
-	msg.type = FETCH_DATA;
-	msg.data.header_or_data.buf = (const uint8_t *) buf;
-	msg.data.header_or_data.len = buf_size;
-	fetch_file_send_callback(&msg, ctx);
-
-	if (ctx->aborted == false) {
-		msg.type = FETCH_FINISHED;
-		fetch_file_send_callback(&msg, ctx);
-	}
+	ctx->state = FETCH_FILE_STATE_PLAIN;
+}
 
-fetch_file_process_aborted:
 
-	if (buf != NULL)
-		munmap(buf, buf_size);
-	close(fd);
-#else
+/**
+ * Process the next chunk of a regular file
+ */
+static void fetch_file_process_plain(struct fetch_file_context *ctx)
+{
 	fetch_msg msg;
-	char *buf;
-	size_t buf_size;
-
-	ssize_t tot_read = 0;
+	size_t len;
 	ssize_t res;
 
-	FILE *infile;
-
-	/* Check if we can just return not modified */
-	if (ctx->file_etag != 0 && ctx->file_etag == fdstat->st_mtime) {
-		fetch_set_http_code(ctx->fetchh, 304);
-		msg.type = FETCH_NOTMODIFIED;
-		fetch_file_send_callback(&msg, ctx);
-		return;
-	}
-
-	infile = fopen(ctx->path, "rb");
-	if (infile == NULL) {
-		/* process errors as appropriate */
-		fetch_file_process_error(ctx,
-				fetch_file_errno_to_http_code(errno));
-		return;
-	}
-
-	/* set buffer size */
-	buf_size = fdstat->st_size;
-	if (buf_size > FETCH_FILE_MAX_BUF_SIZE)
-		buf_size = FETCH_FILE_MAX_BUF_SIZE;
-
-	/* allocate the buffer storage */
-	buf = malloc(buf_size);
-	if (buf == NULL) {
-		msg.type = FETCH_ERROR;
-		msg.data.error =
-			"Unable to allocate memory for file data buffer";
-		fetch_file_send_callback(&msg, ctx);
-		fclose(infile);
-		return;
-	}
-
-	/* fetch is going to be successful */
-	fetch_set_http_code(ctx->fetchh, 200);
-
-	/* Any callback can result in the fetch being aborted.
-	 * Therefore, we _must_ check for this after _every_ call to
-	 * fetch_file_send_callback().
-	 */
-
-	/* content type */
-	if (fetch_file_send_header(ctx, "Content-Type: %s", 
-				   guit->fetch->filetype(ctx->path))) {
-		goto fetch_file_process_aborted;
-	}
-
-	/* content length */
-	if (fetch_file_send_header(ctx, "Content-Length: %" PRIsizet,
-				   fdstat->st_size)) {
-		goto fetch_file_process_aborted;
-	}
-
-	/* create etag */
-	if (fetch_file_send_header(ctx, "ETag: \"%10" PRId64 "\"", 
-				   (int64_t) fdstat->st_mtime)) {
-		goto fetch_file_process_aborted;
-	}
+	if (ctx->offset < ctx->size) {
+		len = ctx->buf_size;
+		if ((off_t)len > ctx->size - ctx->offset) {
+			len = ctx->size - ctx->offset;
+		}
 
-	/* main data loop */
-	while (tot_read < fdstat->st_size) {
-		res = fread(buf, 1, buf_size, infile);
-		if (res == 0) {
-			if (feof(infile)) {
-				msg.type = FETCH_ERROR;
+		res = read(ctx->fd, ctx->buf, len);
+		if (res < 0 && errno == EINTR) {
+			/* try again on the next step */
+			return;
+		}
+		if (res <= 0) {
+			ctx->state = FETCH_FILE_STATE_DONE;
+			msg.type = FETCH_ERROR;
+			if (res == 0) {
 				msg.data.error = "Unexpected EOF reading file";
-				fetch_file_send_callback(&msg, ctx);
-				goto fetch_file_process_aborted;
 			} else {
-				msg.type = FETCH_ERROR;
 				msg.data.error = "Error reading file";
-				fetch_file_send_callback(&msg, ctx);
-				goto fetch_file_process_aborted;
 			}
+			fetch_file_send_callback(&msg, ctx);
+			return;
 		}
-		tot_read += res;
+		ctx->offset += res;
+
+#ifdef HAVE_POSIX_FADVISE
+		/* start reading the next chunk while this one is handled */
+		if (ctx->offset < ctx->size) {
+			posix_fadvise(ctx->fd, ctx->offset, ctx->buf_size,
+				      POSIX_FADV_WILLNEED);
+		}
+#endif
 
 		msg.type = FETCH_DATA;
-		msg.data.header_or_data.buf = (const uint8_t *) buf;
+		msg.data.header_or_data.buf = ctx->buf;
 		msg.data.header_or_data.len = res;
 		if (fetch_file_send_callback(&msg, ctx))
-			break;
+			return;
 	}
 
-	if (ctx->aborted == false) {
+	if (ctx->offset >= ctx->size) {
+		ctx->state = FETCH_FILE_STATE_DONE;
 		msg.type = FETCH_FINISHED;
 		fetch_file_send_callback(&msg, ctx);
 	}
-
-fetch_file_process_aborted:
-
-	fclose(infile);
-	free(buf);
-#endif
-	return;
 }
 
 static char *gen_nice_title(char *path)
@@ -514,7 +509,7 @@ static char *gen_nice_title(char *path)
  * Generate an output row of the directory listing.
  *
  * \param ctx The file fetching context.
- * \param ent current directory entry.
+ * \param name current directory entry name.
  * \param even is the row an even row.
  * \param buffer The output buffer.
  * \param buffer_len The space available in the output buffer.
@@ -522,7 +517,7 @@ static char *gen_nice_title(char *path)
  */
 static nserror
 process_dir_ent(struct fetch_file_context *ctx,
-		 struct dirent *ent,
+		 char *name,
 		 bool even,
 		 char *buffer,
 		 size_t buffer_len)
@@ -534,12 +529,7 @@ process_dir_ent(struct fetch_file_context *ctx,
 	char timebuf[64]; /* buffer for time text */
 	nsurl *url;
 
-	/* skip hidden files */
-	if (ent->d_name[0] == '.') {
-		return NSERROR_BAD_PARAMETER;
-	}
-
-	ret = netsurf_mkpath(&urlpath, NULL, 2, ctx->path, ent->d_name);
+	ret = netsurf_mkpath(&urlpath, NULL, 2, ctx->path, name);
 	if (ret != NSERROR_OK) {
 		return ret;
 	}
@@ -577,7 +567,7 @@ process_dir_ent(struct fetch_file_context *ctx,
 		dirlist_generate_row(even,
 				     false,
 				     url,
-				     ent->d_name,
+				     name,
 				     guit->fetch->filetype(urlpath),
 				     ent_stat.st_size,
 				     datebuf, timebuf,
@@ -587,7 +577,7 @@ process_dir_ent(struct fetch_file_context *ctx,
 		dirlist_generate_row(even,
 				     true,
 				     url,
-				     ent->d_name,
+				     name,
 				     messages_get("FileDirectory"),
 				     -1,
 				     datebuf, timebuf,
@@ -597,7 +587,7 @@ process_dir_ent(struct fetch_file_context *ctx,
 		dirlist_generate_row(even,
 				     false,
 				     url,
-				     ent->d_name,
+				     name,
 				     "",
 				     -1,
 				     datebuf, timebuf,
@@ -616,13 +606,13 @@ process_dir_ent(struct fetch_file_context *ctx,
  * Correctly orders non zero-padded numerical parts.
  * ie. produces "file1, file2, file10" rather than "file1, file10, file2".
  *
- * \param d1 first directory entry
- * \param d2 second directory entry
+ * \param a first directory entry name
+ * \param b second directory entry name
  */
-static int dir_sort_alpha(const struct dirent **d1, const struct dirent **d2)
+static int dir_sort_alpha(const void *a, const void *b)
 {
-	const char *s1 = (*d1)->d_name;
-	const char *s2 = (*d2)->d_name;
+	const char *s1 = *(char * const *)a;
+	const char *s2 = *(char * const *)b;
 
 	while (*s1 != '\0' && *s2 != '\0') {
 		if ((*s1 >= '0' && *s1 <= '9') &&
@@ -652,37 +642,54 @@ static int dir_sort_alpha(const struct dirent **d1, const struct dirent **d2)
 	return tolower(*s1) - tolower(*s2);
 }
 
-static void fetch_file_process_dir(struct fetch_file_context *ctx,
-				   struct stat *fdstat)
+/**
+ * Start processing object as a directory
+ *
+ * Opens the directory; the entry names are read by fetch_file_read_dir()
+ *  and output by fetch_file_process_dir() in batches.
+ */
+static void fetch_file_start_dir(struct fetch_file_context *ctx,
+				 struct stat *fdstat)
+{
+	ctx->state = FETCH_FILE_STATE_DONE;
+
+	ctx->dir = opendir(ctx->path);
+	if (ctx->dir == NULL) {
+		fetch_file_process_error(ctx,
+			fetch_file_errno_to_http_code(errno));
+		return;
+	}
+
+	ctx->state = FETCH_FILE_STATE_DIR_READ;
+}
+
+
+/**
+ * Send the top of a directory listing
+ *
+ * Called once every entry name has been read so a failure to read
+ *  them can still be reported as an error.
+ */
+static void fetch_file_start_listing(struct fetch_file_context *ctx)
 {
 	fetch_msg msg;
 	char buffer[1024]; /* Output buffer */
-	bool even = false; /* formatting flag */
 	char *title; /* pretty printed title */
 	nserror err; /* result from url routines */
 	nsurl *up; /* url of parent */
 
-	struct dirent **listing = NULL; /* directory entry listing */
-	int i; /* directory entry index */
-	int n; /* number of directory entries */
-
-	n = scandir(ctx->path, &listing, 0, dir_sort_alpha);
-	if (n < 0) {
-		fetch_file_process_error(ctx,
-			fetch_file_errno_to_http_code(errno));
-		return;
-	}
+	ctx->state = FETCH_FILE_STATE_DONE;
 
 	/* fetch is going to be successful */
 	fetch_set_http_code(ctx->fetchh, 200);
 
 	/* force no-cache */
 	if (fetch_file_send_header(ctx, "Cache-Control: no-cache"))
-		goto fetch_file_process_dir_aborted;
+		return;
 
 	/* content type */
 	if (fetch_file_send_header(ctx, "Content-Type: text/html"))
-		goto fetch_file_process_dir_aborted;
+		return;
 
 	msg.type = FETCH_DATA;
 	msg.data.header_or_data.buf = (const uint8_t *) buffer;
@@ -691,7 +698,7 @@ static void fetch_file_process_dir(struct fetch_file_context *ctx,
 	dirlist_generate_top(buffer, sizeof buffer);
 	msg.data.header_or_data.len = strlen(buffer);
 	if (fetch_file_send_callback(&msg, ctx))
-		goto fetch_file_process_dir_aborted;
+		return;
 
 	/* directory listing title */
 	title = gen_nice_title(ctx->path);
@@ -699,7 +706,7 @@ static void fetch_file_process_dir(struct fetch_file_context *ctx,
 	free(title);
 	msg.data.header_or_data.len = strlen(buffer);
 	if (fetch_file_send_callback(&msg, ctx))
-		goto fetch_file_process_dir_aborted;
+		return;
 
 	/* Print parent directory link */
 	err = nsurl_parent(ctx->url, &up);
@@ -715,7 +722,7 @@ static void fetch_file_process_dir(struct fetch_file_context *ctx,
 		nsurl_unref(up);
 
 		if (ctx->aborted)
-			goto fetch_file_process_dir_aborted;
+			return;
 
 	}
 
@@ -723,49 +730,140 @@ static void fetch_file_process_dir(struct fetch_file_context *ctx,
 	dirlist_generate_headings(buffer, sizeof buffer);
 	msg.data.header_or_data.len = strlen(buffer);
 	if (fetch_file_send_callback(&msg, ctx))
-		goto fetch_file_process_dir_aborted;
+		return;
+
+	ctx->state = FETCH_FILE_STATE_DIR_LIST;
+}
 
-	for (i = 0; i < n; i++) {
 
-		err = process_dir_ent(ctx, listing[i], even, buffer,
-				       sizeof(buffer));
+/**
+ * Read the next batch of directory entry names
+ *
+ * Once every name has been read they are sorted and the top of the
+ *  listing is sent. If the names cannot be read or stored the fetch
+ *  fails with an error instead.
+ */
+static void fetch_file_read_dir(struct fetch_file_context *ctx)
+{
+	struct dirent *ent;
+	unsigned int count;
+	int code = 0;
+
+	for (count = 0; count < FETCH_FILE_DIR_BATCH; count++) {
+		errno = 0;
+		ent = readdir(ctx->dir);
+		if (ent == NULL) {
+			if (errno != 0) {
+				code = fetch_file_errno_to_http_code(errno);
+			}
+			break;
+		}
+
+		/* skip hidden files */
+		if (ent->d_name[0] == '.') {
+			continue;
+		}
+
+		if (ctx->name_count == ctx->name_alloc) {
+			size_t alloc = ctx->name_alloc * 2;
+			char **names;
+
+			if (alloc == 0) {
+				alloc = FETCH_FILE_DIR_BATCH;
+			}
+			names = realloc(ctx->names, alloc * sizeof(*names));
+			if (names == NULL) {
+				code = 500;
+				break;
+			}
+			ctx->names = names;
+			ctx->name_alloc = alloc;
+		}
+
+		ctx->names[ctx->name_count] = strdup(ent->d_name);
+		if (ctx->names[ctx->name_count] == NULL) {
+			code = 500;
+			break;
+		}
+		ctx->name_count++;
+	}
+
+	if (count == FETCH_FILE_DIR_BATCH) {
+		/* more names to read on the next step */
+		return;
+	}
+
+	closedir(ctx->dir);
+	ctx->dir = NULL;
+
+	if (code != 0) {
+		ctx->state = FETCH_FILE_STATE_DONE;
+		fetch_file_process_error(ctx, code);
+		return;
+	}
+
+	if (ctx->name_count > 1) {
+		qsort(ctx->names, ctx->name_count,
+		      sizeof(*ctx->names), dir_sort_alpha);
+	}
+
+	fetch_file_start_listing(ctx);
+}
+
+
+/**
+ * Output the next batch of directory listing rows
+ */
+static void fetch_file_process_dir(struct fetch_file_context *ctx)
+{
+	fetch_msg msg;
+	char buffer[1024]; /* Output buffer */
+	nserror err; /* result from url routines */
+	unsigned int count;
+
+	msg.type = FETCH_DATA;
+	msg.data.header_or_data.buf = (const uint8_t *) buffer;
+
+	for (count = 0;
+	     count < FETCH_FILE_DIR_BATCH && ctx->name_next < ctx->name_count;
+	     count++) {
+		err = process_dir_ent(ctx, ctx->names[ctx->name_next++],
+				      ctx->even, buffer, sizeof(buffer));
 
 		if (err == NSERROR_OK) {
 			msg.data.header_or_data.len = strlen(buffer);
 			if (fetch_file_send_callback(&msg, ctx))
-				goto fetch_file_process_dir_aborted;
+				return;
 
-			even = !even;
+			ctx->even = !ctx->even;
 		}
 	}
 
+	if (ctx->name_next < ctx->name_count) {
+		return;
+	}
+
+	ctx->state = FETCH_FILE_STATE_DONE;
+
 	/* directory listing bottom */
 	dirlist_generate_bottom(buffer, sizeof buffer);
 	msg.data.header_or_data.len = strlen(buffer);
 	if (fetch_file_send_callback(&msg, ctx))
-		goto fetch_file_process_dir_aborted;
+		return;
 
 	msg.type = FETCH_FINISHED;
 	fetch_file_send_callback(&msg, ctx);
-
-fetch_file_process_dir_aborted:
-
-	if (listing != NULL) {
-		for (i = 0; i < n; i++) {
-			free(listing[i]);
-		}
-		free(listing);
-	}
 }
 
 
-/* process a file fetch */
-static void fetch_file_process(struct fetch_file_context *ctx)
+/* start a file fetch */
+static void fetch_file_start_process(struct fetch_file_context *ctx)
 {
 	struct stat fdstat; /**< The objects stat */
 
 	if (stat(ctx->path, &fdstat) != 0) {
 		/* process errors as appropriate */
+		ctx->state = FETCH_FILE_STATE_DONE;
 		fetch_file_process_error(ctx,
 				fetch_file_errno_to_http_code(errno));
 		return;
@@ -773,20 +871,65 @@ static void fetch_file_process(struct fetch_file_context *ctx)
 
 	if (S_ISDIR(fdstat.st_mode)) {
 		/* directory listing */
-		fetch_file_process_dir(ctx, &fdstat);
+		fetch_file_start_dir(ctx, &fdstat);
 		return;
 	} else if (S_ISREG(fdstat.st_mode)) {
 		/* regular file */
-		fetch_file_process_plain(ctx, &fdstat);
+		fetch_file_start_plain(ctx, &fdstat);
 		return;
 	} else {
 		/* unhandled type of file */
+		ctx->state = FETCH_FILE_STATE_DONE;
 		fetch_file_process_error(ctx, 501);
 	}
 
 	return;
 }
 
+
+/**
+ * process a file fetch
+ *
+ * Steps are performed until the fetch completes, is aborted, or has
+ *  been processed for FETCH_FILE_POLL_TIME.
+ */
+static void fetch_file_process(struct fetch_file_context *ctx)
+{
+	uint64_t start_ms;
+	uint64_t now_ms;
+
+	nsu_getmonotonic_ms(&start_ms);
+
+	do {
+		switch (ctx->state) {
+		case FETCH_FILE_STATE_START:
+			fetch_file_start_process(ctx);
+			break;
+
+		case FETCH_FILE_STATE_PLAIN:
+			fetch_file_process_plain(ctx);
+			break;
+
+		case FETCH_FILE_STATE_DIR_READ:
+			fetch_file_read_dir(ctx);
+			break;
+
+		case FETCH_FILE_STATE_DIR_LIST:
+			fetch_file_process_dir(ctx);
+			break;
+
+		case FETCH_FILE_STATE_DONE:
+			break;
+		}
+
+		if (ctx->aborted || ctx->state == FETCH_FILE_STATE_DONE) {
+			break;
+		}
+
+		nsu_getmonotonic_ms(&now_ms);
+	} while (now_ms - start_ms < FETCH_FILE_POLL_TIME);
+}
+
 /** callback to poll for additional file fetch contents */
 static void fetch_file_poll(lwc_string *scheme)
 {
@@ -810,18 +953,24 @@ static void fetch_file_poll(lwc_string *scheme)
 
 		/* Only process non-aborted fetches */
 		if (c->aborted == false) {
-			/* file fetches can be processed in one go */
 			fetch_file_process(c);
 		}
 
+		/* Unfinished fetches are continued on the next poll */
+		if (c->aborted == false &&
+		    c->state != FETCH_FILE_STATE_DONE) {
+			RING_INSERT(save_ring, c);
+			continue;
+		}
+
 		/* And now finish */
 		fetch_remove_from_queues(c->fetchh);
 		fetch_free(c->fetchh);
 
 	}
 
-	/* Finally, if we saved any fetches which were locked, put them back
-	 * into the ring for next time
+	/* Finally, if we saved any fetches which were locked or are
+	 * unfinished, put them back into the ring for next time
 	 */
 	ring = save_ring;
 }
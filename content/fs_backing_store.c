@@ -238,6 +238,8 @@ struct store_state {
 	size_t hit_count; /**< number of cache hits */
 	uint64_t hit_size; /**< size of storage served */
 	size_t miss_count; /**< number of cache misses */
+	size_t evict_count; /**< number of entries evicted */
+	uint64_t evict_size; /**< size of entries evicted */
 
 };
 
@@ -636,6 +638,8 @@ static nserror store_evict(struct store_state *state)
 			break;
 		}
 
+		state->evict_count++;
+
 		if (removed > state->hysteresis) {
 			break;
 		}
@@ -643,6 +647,8 @@ static nserror store_evict(struct store_state *state)
 
 	free(estate.elist);
 
+	state->evict_size += removed;
+
 	NSLOG(netsurf, INFO,
 	      "removed %"PRIsizet" in %"PRIsizet" entries, %"PRIu64" remaining in %"PRIsizet" entries",
 	      removed, ent, state->total_alloc, old_count - ent);
@@ -2017,6 +2023,61 @@ invalidate(nsurl *url)
 }
 
 
+/**
+ * Get statistics about the backing store.
+ *
+ * The small block use maps are scanned to find how many blocks are in
+ * use and how far into the block files they extend. Block zero is
+ * reserved and not counted.
+ *
+ * @param[out] stats The structure to fill with the statistics.
+ * @return NSERROR_OK on success or error code on failure.
+ */
+static nserror
+get_stats(struct backing_store_stats *stats)
+{
+	int elem_idx;
+
+	/* check backing store is initialised */
+	if (storestate == NULL) {
+		return NSERROR_INIT_FAILED;
+	}
+
+	stats->limit = storestate->limit;
+	stats->size = storestate->total_alloc;
+	stats->entry_count = hashmap_count(storestate->entries);
+	stats->hit_count = storestate->hit_count;
+	stats->hit_size = storestate->hit_size;
+	stats->miss_count = storestate->miss_count;
+	stats->evict_count = storestate->evict_count;
+	stats->evict_size = storestate->evict_size;
+
+	for (elem_idx = 0; elem_idx < ENTRY_ELEM_COUNT; elem_idx++) {
+		unsigned int used = 0;
+		unsigned int extent = 0;
+		unsigned int block;
+
+		for (block = 1;
+		     block < (BLOCK_FILE_COUNT * BLOCK_USE_MAP_SIZE * 8);
+		     block++) {
+			uint8_t *map;
+
+			map = &storestate->blocks[elem_idx][block /
+					(BLOCK_USE_MAP_SIZE * 8)].use_map[0];
+			if ((map[(block / 8) % BLOCK_USE_MAP_SIZE] &
+			     (1U << (block & 7))) != 0) {
+				used++;
+				extent = block;
+			}
+		}
+		stats->blocks_used[elem_idx] = used;
+		stats->blocks_extent[elem_idx] = extent;
+	}
+
+	return NSERROR_OK;
+}
+
+
 static struct gui_llcache_table llcache_table = {
 	.initialise = initialise,
 	.finalise = finalise,
@@ -2024,6 +2085,7 @@ static struct gui_llcache_table llcache_table = {
 	.fetch = fetch,
 	.invalidate = invalidate,
 	.release = release,
+	.stats = get_stats,
 };
 
 struct gui_llcache_table *filesystem_llcache_table = &llcache_table;
@@ -35,6 +35,7 @@
 #include "css/css.h"
 #include "css/hints.h"
 #include "css/internal.h"
+#include "css/select.h"
 
 /* Define to trace import fetches */
 #undef NSCSS_IMPORT_TRACE
@@ -591,7 +592,12 @@ css_error nscss_handle_import(void *pw, css_stylesheet *parent,
 				0, ns_ref, NULL, nscss_import, ctx,
 				&child, accept,
 				&c->imports[c->import_count].c);
-		if (nerror != NSERROR_OK) {
+		if (nerror == NSERROR_BLOCKED) {
+			/* Blocked imports are treated as empty */
+			c->imports[c->import_count].c = NULL;
+			free(ctx);
+			ctx = NULL;
+		} else if (nerror != NSERROR_OK) {
 			free(ctx);
 			return CSS_NOMEM;
 		}
@@ -794,6 +800,7 @@ static void nscss_fini(void)
 		blank_import = NULL;
 	}
 	css_hint_fini();
+	nscss_select_fini();
 }
 
 static const content_handler css_content_handler = {
@@ -822,6 +829,10 @@ nserror nscss_init(void)
 	if (error != NSERROR_OK)
 		goto error;
 
+	error = nscss_select_init();
+	if (error != NSERROR_OK)
+		goto error;
+
 	return NSERROR_OK;
 
 error:
@@ -23,9 +23,11 @@
 #include "utils/nsoption.h"
 #include "utils/corestrings.h"
 #include "utils/log.h"
+#include "utils/hashmap.h"
 #include "utils/nsurl.h"
 #include "netsurf/plot_style.h"
 #include "netsurf/url_db.h"
+#include "content/urldb.h"
 #include "desktop/system_colour.h"
 
 #include "css/internal.h"
@@ -140,6 +142,310 @@ static css_select_handler selection_handler = {
 	get_libcss_node_data
 };
 
+/**
+ * Additional references held on shared selection results
+ *
+ * Keyed on the results pointer, the value is the count of references held
+ * beyond the original owner's.  Results which are not shared have no entry.
+ */
+static hashmap_t *nscss_shared_results = NULL;
+
+static void *nscss_shared_results_key_clone(void *key)
+{
+	return key;
+}
+
+static void nscss_shared_results_key_destroy(void *key)
+{
+}
+
+static uint32_t nscss_shared_results_key_hash(void *key)
+{
+	uintptr_t ptr = (uintptr_t)key;
+
+	return (uint32_t)(ptr >> 4) ^ (uint32_t)((uint64_t)ptr >> 32);
+}
+
+static bool nscss_shared_results_key_eq(void *key1, void *key2)
+{
+	return key1 == key2;
+}
+
+static void *nscss_shared_results_value_alloc(void *key)
+{
+	return calloc(1, sizeof(uint32_t));
+}
+
+static void nscss_shared_results_value_destroy(void *value)
+{
+	free(value);
+}
+
+static hashmap_parameters_t nscss_shared_results_parameters = {
+	.key_clone = nscss_shared_results_key_clone,
+	.key_destroy = nscss_shared_results_key_destroy,
+	.key_hash = nscss_shared_results_key_hash,
+	.key_eq = nscss_shared_results_key_eq,
+	.value_alloc = nscss_shared_results_value_alloc,
+	.value_destroy = nscss_shared_results_value_destroy,
+};
+
+/**
+ * Initialise style selection
+ *
+ * \return NSERROR_OK on success or error code on failure
+ */
+nserror nscss_select_init(void)
+{
+	nscss_shared_results = hashmap_create(&nscss_shared_results_parameters);
+	if (nscss_shared_results == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	return NSERROR_OK;
+}
+
+/**
+ * Finalise style selection
+ */
+void nscss_select_fini(void)
+{
+	if (nscss_shared_results != NULL) {
+		hashmap_destroy(nscss_shared_results);
+		nscss_shared_results = NULL;
+	}
+}
+
+/**
+ * Resolved link target, stored as libdom node user data on anchors
+ */
+struct nscss_link_data {
+	dom_string *href; /**< href attribute the URL was resolved from */
+	nsurl *base_url; /**< Base URL the href was resolved against */
+	nsurl *url; /**< Absolute link target */
+};
+
+/**
+ * Per-document cache of link visited state
+ */
+struct nscss_visited_cache {
+	hashmap_t *urls; /**< Visited state, keyed by absolute URL */
+	unsigned int generation; /**< urldb visit generation of entries */
+};
+
+static uint32_t nscss_visited_key_hash(void *key)
+{
+	return nsurl_hash((nsurl *)key);
+}
+
+static bool nscss_visited_key_eq(void *key1, void *key2)
+{
+	return nsurl_compare((nsurl *)key1, (nsurl *)key2, NSURL_COMPLETE);
+}
+
+static void *nscss_visited_value_alloc(void *key)
+{
+	return calloc(1, sizeof(bool));
+}
+
+static void nscss_visited_value_destroy(void *value)
+{
+	free(value);
+}
+
+static hashmap_parameters_t nscss_visited_parameters = {
+	.key_clone = (hashmap_key_clone_t)nsurl_ref,
+	.key_destroy = (hashmap_key_destroy_t)nsurl_unref,
+	.key_hash = nscss_visited_key_hash,
+	.key_eq = nscss_visited_key_eq,
+	.value_alloc = nscss_visited_value_alloc,
+	.value_destroy = nscss_visited_value_destroy,
+};
+
+/**
+ * Create a link visited state cache
+ *
+ * \param cache  Pointer to location to receive cache
+ * \return NSERROR_OK on success or error code on failure
+ */
+nserror nscss_visited_cache_create(struct nscss_visited_cache **cache)
+{
+	struct nscss_visited_cache *c;
+
+	c = malloc(sizeof(*c));
+	if (c == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	c->urls = hashmap_create(&nscss_visited_parameters);
+	if (c->urls == NULL) {
+		free(c);
+		return NSERROR_NOMEM;
+	}
+	c->generation = urldb_get_visit_generation();
+
+	*cache = c;
+
+	return NSERROR_OK;
+}
+
+/**
+ * Destroy a link visited state cache
+ *
+ * \param cache  Cache to destroy
+ */
+void nscss_visited_cache_destroy(struct nscss_visited_cache *cache)
+{
+	if (cache->urls != NULL) {
+		hashmap_destroy(cache->urls);
+	}
+	free(cache);
+}
+
+/**
+ * Look up whether a URL has been visited
+ *
+ * \param cache  Visited state cache, or NULL
+ * \param url    Absolute URL to look up
+ * \return true if the URL is in the global history
+ */
+static bool nscss_visited_cache_lookup(struct nscss_visited_cache *cache,
+		nsurl *url)
+{
+	const struct url_data *data;
+	unsigned int generation;
+	bool *visited;
+
+	if (cache != NULL) {
+		generation = urldb_get_visit_generation();
+		if (cache->generation != generation) {
+			/* Global history has changed; discard everything */
+			hashmap_destroy(cache->urls);
+			cache->urls = hashmap_create(&nscss_visited_parameters);
+			cache->generation = generation;
+		}
+
+		if (cache->urls != NULL) {
+			visited = hashmap_lookup(cache->urls, url);
+			if (visited != NULL) {
+				return *visited;
+			}
+		}
+	}
+
+	/* Visited if in the db and has non-zero visit count */
+	data = urldb_get_url_data(url);
+
+	if (cache != NULL && cache->urls != NULL) {
+		visited = hashmap_insert(cache->urls, url);
+		if (visited != NULL) {
+			*visited = (data != NULL && data->visits > 0);
+		}
+	}
+
+	return (data != NULL && data->visits > 0);
+}
+
+/**
+ * Destroy resolved link target data
+ */
+static void nscss_link_data_destroy(struct nscss_link_data *link)
+{
+	dom_string_unref(link->href);
+	nsurl_unref(link->base_url);
+	nsurl_unref(link->url);
+	free(link);
+}
+
+/* Handler for link data, stored as libdom node user data */
+static void nscss_link_user_data_handler(dom_node_operation operation,
+		dom_string *key, void *data, struct dom_node *src,
+		struct dom_node *dst)
+{
+	if (dom_string_isequal(corestring_dom___ns_key_link_node_data,
+			key) == false || data == NULL) {
+		return;
+	}
+
+	switch (operation) {
+	case DOM_NODE_CLONED:
+	case DOM_NODE_RENAMED:
+	case DOM_NODE_IMPORTED:
+	case DOM_NODE_ADOPTED:
+		/* Validated against the href and base URL on use */
+		break;
+
+	case DOM_NODE_DELETED:
+		nscss_link_data_destroy(data);
+		break;
+
+	default:
+		NSLOG(netsurf, INFO, "User data operation not handled.");
+		assert(0);
+	}
+}
+
+/**
+ * Get the absolute URL of an anchor's link target
+ *
+ * The resolved URL is kept on the DOM node, so it only needs resolving
+ * again if the href attribute or the document's base URL changes.
+ *
+ * \param n         Anchor element
+ * \param href      Value of the element's href attribute
+ * \param base_url  Document base URL
+ * \param url       Pointer to location to receive URL, not referenced
+ * \return NSERROR_OK on success or error code on failure
+ */
+static nserror nscss_link_url(dom_node *n, dom_string *href,
+		nsurl *base_url, nsurl **url)
+{
+	struct nscss_link_data *link = NULL;
+	struct nscss_link_data *old_link = NULL;
+	dom_exception exc;
+	nserror error;
+	nsurl *joined;
+
+	exc = dom_node_get_user_data(n, corestring_dom___ns_key_link_node_data,
+			(void *) &link);
+	if (exc == DOM_NO_ERR && link != NULL &&
+			link->base_url == base_url &&
+			dom_string_isequal(link->href, href)) {
+		*url = link->url;
+		return NSERROR_OK;
+	}
+
+	error = nsurl_join(base_url, dom_string_data(href), &joined);
+	if (error != NSERROR_OK) {
+		return error;
+	}
+
+	link = malloc(sizeof(*link));
+	if (link == NULL) {
+		nsurl_unref(joined);
+		return NSERROR_NOMEM;
+	}
+	link->href = dom_string_ref(href);
+	link->base_url = nsurl_ref(base_url);
+	link->url = joined;
+
+	exc = dom_node_set_user_data(n, corestring_dom___ns_key_link_node_data,
+			link, nscss_link_user_data_handler,
+			(void *) &old_link);
+	if (exc != DOM_NO_ERR) {
+		nscss_link_data_destroy(link);
+		return NSERROR_NOMEM;
+	}
+
+	if (old_link != NULL) {
+		nscss_link_data_destroy(old_link);
+	}
+
+	*url = link->url;
+
+	return NSERROR_OK;
+}
+
 /**
  * Create an inline style
  *
@@ -262,10 +568,22 @@ css_select_results *nscss_get_style(nscss_select_ctx *ctx, dom_node *n,
 	int pseudo_element;
 	css_error error;
 
+	/* Track whether the results depend on the node's siblings
+	 * or children, and so may not be shared */
+	ctx->node = n;
+	ctx->sibling = NULL;
+	ctx->sibling_used = false;
+	ctx->sharable = (inline_style == NULL);
+
 	/* Select style for node */
 	error = css_select_style(ctx->ctx, n, media, inline_style,
 			&selection_handler, ctx, &styles);
 
+	if (ctx->sibling_used) {
+		ctx->sharable = false;
+	}
+	ctx->node = NULL;
+
 	if (error != CSS_OK || styles == NULL) {
 		/* Failed selecting partial style -- bail out */
 		return NULL;
@@ -340,6 +658,11 @@ css_computed_style *nscss_get_blank_style(nscss_select_ctx *ctx,
 	css_computed_style *partial, *composed;
 	css_error error;
 
+	ctx->node = NULL;
+	ctx->sibling = NULL;
+	ctx->sibling_used = false;
+	ctx->visited = NULL;
+
 	error = css_select_default_style(ctx->ctx,
 			&selection_handler, ctx, &partial);
 	if (error != CSS_OK) {
@@ -359,6 +682,156 @@ css_computed_style *nscss_get_blank_style(nscss_select_ctx *ctx,
 	return composed;
 }
 
+/**
+ * Determine whether an element may share a sibling's selection results
+ *
+ * The elements must have the same name and identical attributes, and
+ * neither may have an id.  The caller is responsible for ensuring the
+ * elements have the same parent and that the candidate's selection did not
+ * depend on its position among its siblings or on its children.
+ *
+ * \param n          Element to select for
+ * \param candidate  Preceding sibling element whose results may be shared
+ * \return true if the elements' selection results are interchangeable
+ */
+bool nscss_can_share_style(dom_node *n, dom_node *candidate)
+{
+	dom_string *name, *candidate_name;
+	dom_namednodemap *attrs, *candidate_attrs;
+	dom_ulong count, candidate_count, i;
+	bool has_id;
+	bool share;
+	dom_exception err;
+
+	err = dom_node_get_node_name(n, &name);
+	if (err != DOM_NO_ERR || name == NULL)
+		return false;
+
+	err = dom_node_get_node_name(candidate, &candidate_name);
+	if (err != DOM_NO_ERR || candidate_name == NULL) {
+		dom_string_unref(name);
+		return false;
+	}
+
+	share = dom_string_isequal(name, candidate_name);
+
+	dom_string_unref(candidate_name);
+	dom_string_unref(name);
+
+	if (share == false)
+		return false;
+
+	/* Elements with ids are unique, so never share */
+	err = dom_element_has_attribute(n, corestring_dom_id, &has_id);
+	if (err != DOM_NO_ERR || has_id)
+		return false;
+
+	err = dom_node_get_attributes(n, &attrs);
+	if (err != DOM_NO_ERR || attrs == NULL)
+		return false;
+
+	err = dom_node_get_attributes(candidate, &candidate_attrs);
+	if (err != DOM_NO_ERR || candidate_attrs == NULL) {
+		dom_namednodemap_unref(attrs);
+		return false;
+	}
+
+	if (dom_namednodemap_get_length(attrs, &count) != DOM_NO_ERR ||
+			dom_namednodemap_get_length(candidate_attrs,
+					&candidate_count) != DOM_NO_ERR ||
+			count != candidate_count) {
+		share = false;
+	}
+
+	/* Every attribute must be present on the candidate with the
+	 * same value; this covers classes and anything an attribute
+	 * selector or presentational hint could examine */
+	for (i = 0; share && i < count; i++) {
+		dom_attr *attr;
+		dom_string *attr_name, *value, *candidate_value;
+
+		share = false;
+
+		err = dom_namednodemap_item(attrs, i, &attr);
+		if (err != DOM_NO_ERR || attr == NULL)
+			break;
+
+		err = dom_attr_get_name(attr, &attr_name);
+		if (err != DOM_NO_ERR) {
+			dom_node_unref(attr);
+			break;
+		}
+
+		err = dom_attr_get_value(attr, &value);
+		dom_node_unref(attr);
+		if (err != DOM_NO_ERR) {
+			dom_string_unref(attr_name);
+			break;
+		}
+
+		err = dom_element_get_attribute(candidate, attr_name,
+				&candidate_value);
+		dom_string_unref(attr_name);
+		if (err == DOM_NO_ERR && candidate_value != NULL) {
+			share = dom_string_isequal(value, candidate_value);
+			dom_string_unref(candidate_value);
+		}
+
+		if (value != NULL)
+			dom_string_unref(value);
+	}
+
+	dom_namednodemap_unref(candidate_attrs);
+	dom_namednodemap_unref(attrs);
+
+	return share;
+}
+
+/**
+ * Take an additional reference to selection results
+ *
+ * \param styles  Selection results to share
+ * \return \a styles on success, or NULL on memory exhaustion
+ */
+css_select_results *nscss_select_results_ref(css_select_results *styles)
+{
+	uint32_t *refs;
+
+	refs = hashmap_lookup(nscss_shared_results, styles);
+	if (refs == NULL) {
+		refs = hashmap_insert(nscss_shared_results, styles);
+		if (refs == NULL) {
+			return NULL;
+		}
+	}
+
+	(*refs)++;
+
+	return styles;
+}
+
+/**
+ * Release a reference to selection results
+ *
+ * The results are destroyed once no references remain.
+ *
+ * \param styles  Selection results to release
+ */
+void nscss_select_results_destroy(css_select_results *styles)
+{
+	uint32_t *refs;
+
+	refs = hashmap_lookup(nscss_shared_results, styles);
+	if (refs != NULL) {
+		if (--(*refs) == 0) {
+			hashmap_remove(nscss_shared_results, styles);
+		}
+		return;
+	}
+
+	css_select_results_destroy(styles);
+}
+
 /**
  * Font size computation callback for libcss
  *
@@ -640,12 +1113,16 @@ css_error named_parent_node(void *pw, void *node,
 css_error named_sibling_node(void *pw, void *node,
 		const css_qname *qname, void **sibling)
 {
+	nscss_select_ctx *ctx = pw;
 	dom_node *n = node;
 	dom_node *prev;
 	dom_exception err;
 
 	*sibling = NULL;
 
+	if (ctx != NULL && node == ctx->node)
+		ctx->sharable = false;
+
 	/* Find sibling element */
 	err = dom_node_get_previous_sibling(n, &n);
 	if (err != DOM_NO_ERR)
@@ -708,12 +1185,16 @@ css_error named_sibling_node(void *pw, void *node,
 css_error named_generic_sibling_node(void *pw, void *node,
 		const css_qname *qname, void **sibling)
 {
+	nscss_select_ctx *ctx = pw;
 	dom_node *n = node;
 	dom_node *prev;
 	dom_exception err;
 
 	*sibling = NULL;
 
+	if (ctx != NULL && node == ctx->node)
+		ctx->sharable = false;
+
 	err = dom_node_get_previous_sibling(n, &n);
 	if (err != DOM_NO_ERR)
 		return CSS_OK;
@@ -787,6 +1268,7 @@ css_error parent_node(void *pw, void *node, void **parent)
  */
 css_error sibling_node(void *pw, void *node, void **sibling)
 {
+	nscss_select_ctx *ctx = pw;
 	dom_node *n = node;
 	dom_node *prev;
 	dom_exception err;
@@ -827,6 +1309,14 @@ css_error sibling_node(void *pw, void *node, void **sibling)
 		*sibling = n;
 	}
 
+	if (ctx != NULL && node == ctx->node) {
+		/* libcss also fetches the preceding sibling when looking
+		 * for a style to share, in which case it goes on to fetch
+		 * the sibling's node data; see get_libcss_node_data() */
+		ctx->sibling = *sibling;
+		ctx->sibling_used = true;
+	}
+
 	return CSS_OK;
 }
 
@@ -1445,10 +1935,14 @@ node_count_siblings_check(dom_node *node,
 css_error node_count_siblings(void *pw, void *n, bool same_name,
 		bool after, int32_t *count)
 {
+	nscss_select_ctx *ctx = pw;
 	int32_t cnt = 0;
 	dom_exception exc;
 	dom_string *node_name = NULL;
 
+	if (ctx != NULL && n == ctx->node)
+		ctx->sharable = false;
+
 	if (same_name) {
 		dom_node *node = n;
 		exc = dom_node_get_node_name(node, &node_name);
@@ -1508,11 +2002,15 @@ css_error node_count_siblings(void *pw, void *n, bool same_name,
  */
 css_error node_is_empty(void *pw, void *node, bool *match)
 {
+	nscss_select_ctx *ctx = pw;
 	dom_node *n = node, *next;
 	dom_exception err;
 
 	*match = true;
 
+	if (ctx != NULL && node == ctx->node)
+		ctx->sharable = false;
+
 	err = dom_node_get_first_child(n, &n);
 	if (err != DOM_NO_ERR) {
 		return CSS_BADPARM;
@@ -1599,7 +2097,6 @@ css_error node_is_visited(void *pw, void *node, bool *match)
 	nscss_select_ctx *ctx = pw;
 	nsurl *url;
 	nserror error;
-	const struct url_data *data;
 
 	dom_exception exc;
 	dom_node *n = node;
@@ -1628,10 +2125,8 @@ css_error node_is_visited(void *pw, void *node, bool *match)
 		return CSS_OK;
 	}
 
-	/* Make href absolute */
-	/* TODO: this duplicates what we do for box->href
-	 *       should we put the absolute URL on the dom node? */
-	error = nsurl_join(ctx->base_url, dom_string_data(s), &url);
+	/* Get absolute URL, which is cached on the node */
+	error = nscss_link_url(n, s, ctx->base_url, &url);
 
 	/* Finished with href string */
 	dom_string_unref(s);
@@ -1641,14 +2136,7 @@ css_error node_is_visited(void *pw, void *node, bool *match)
 		return CSS_NOMEM;
 	}
 
-	data = urldb_get_url_data(url);
-
-	/* Visited if in the db and has
-	 * non-zero visit count */
-	if (data != NULL && data->visits > 0)
-		*match = true;
-
-	nsurl_unref(url);
+	*match = nscss_visited_cache_lookup(ctx->visited, url);
 
 	return CSS_OK;
 }
@@ -1877,9 +2365,16 @@ css_error set_libcss_node_data(void *pw, void *node, void *libcss_node_data)
 
 css_error get_libcss_node_data(void *pw, void *node, void **libcss_node_data)
 {
+	nscss_select_ctx *ctx = pw;
 	dom_node *n = node;
 	dom_exception err;
 
+	if (ctx != NULL && ctx->sibling_used && node == ctx->sibling) {
+		/* The sibling was fetched to look for a style to share,
+		 * not to match a selector */
+		ctx->sibling_used = false;
+	}
+
 	/* Get this node's node data */
 	err = dom_node_get_user_data(n,
 			corestring_dom___ns_key_libcss_node_data,
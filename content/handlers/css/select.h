@@ -25,8 +25,11 @@
 
 #include <libcss/libcss.h>
 
+#include "utils/errors.h"
+
 struct content;
 struct nsurl;
+struct nscss_visited_cache;
 
 /**
  * Selection context
@@ -37,10 +40,23 @@ typedef struct nscss_select_ctx
 	bool quirks;
 	struct nsurl *base_url;
 	lwc_string *universal;
+	struct nscss_visited_cache *visited; /**< Link state cache, or NULL */
 	const css_computed_style *root_style;
 	const css_computed_style *parent_style;
+	dom_node *node; /**< Element being selected for, or NULL */
+	void *sibling; /**< Sibling of node last handed to libcss */
+	bool sibling_used; /**< Whether selection looked at node's sibling */
+	bool sharable; /**< Whether the results may be shared by siblings */
 } nscss_select_ctx;
 
+nserror nscss_select_init(void);
+
+void nscss_select_fini(void);
+
+nserror nscss_visited_cache_create(struct nscss_visited_cache **cache);
+
+void nscss_visited_cache_destroy(struct nscss_visited_cache *cache);
+
 css_stylesheet *nscss_create_inline_style(const uint8_t *data, size_t len,
 		const char *charset, const char *url, bool allow_quirks);
 
@@ -50,6 +66,12 @@ css_select_results *nscss_get_style(nscss_select_ctx *ctx, dom_node *n,
 css_computed_style *nscss_get_blank_style(nscss_select_ctx *ctx,
 		const css_computed_style *parent);
 
+bool nscss_can_share_style(dom_node *n, dom_node *candidate);
+
+css_select_results *nscss_select_results_ref(css_select_results *styles);
+
+void nscss_select_results_destroy(css_select_results *styles);
+
 
 css_error named_ancestor_node(void *pw, void *node,
 		const css_qname *qname, void **ancestor);
@@ -86,7 +86,8 @@ typedef enum {
 	REPLACE_DIM = 1 << 9,	/* replaced element has given dimensions */
 	IFRAME      = 1 << 10,	/* box contains an iframe */
 	CONVERT_CHILDREN = 1 << 11,  /* wanted children converting */
-	IS_REPLACED = 1 << 12	/* box is a replaced element */
+	IS_REPLACED = 1 << 12,	/* box is a replaced element */
+	STYLE_SHARABLE = 1 << 13 /* styles may be shared with siblings */
 } box_flags;
 
 
@@ -169,6 +170,29 @@ struct object_params {
 };
 
 
+/**
+ * Entry in a box's child index.
+ */
+struct box_child_index_entry {
+	struct box *box;	/**< in-flow child */
+	int y0;	/**< top of the child and its descendants */
+	int y1;	/**< greatest bottom of this and all preceding entries */
+};
+
+
+/**
+ * Vertical extent index over the in-flow children of a box.
+ *
+ * Entries are in document order with non-decreasing y0 and y1, both
+ * relative to the parent box, so the children which may intersect a
+ * horizontal strip can be found by binary search.
+ */
+struct box_child_index {
+	unsigned int count;	/**< number of entries */
+	struct box_child_index_entry *entries;	/**< entries */
+};
+
+
 /**
  * Node in box tree. All dimensions are in pixels.
  */
@@ -445,6 +469,13 @@ struct box {
 	 */
 	struct browser_window *iframe;
 
+	/**
+	 * Index of in-flow children by vertical extent, rebuilt by each
+	 * layout, or NULL if there are few children or they are not in
+	 * vertical order.
+	 */
+	struct box_child_index *child_index;
+
 };
 
 
@@ -29,6 +29,8 @@
 
 #include "utils/errors.h"
 #include "utils/nsoption.h"
+#include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/corestrings.h"
 #include "utils/talloc.h"
 #include "utils/string.h"
@@ -45,7 +47,9 @@
 #include "html/box_construct.h"
 #include "html/box_special.h"
 #include "html/box_normalise.h"
+#include "html/box_inspect.h"
 #include "html/form_internal.h"
+#include "html/css.h"
 
 /**
  * Context for box tree construction
@@ -60,6 +64,9 @@ struct box_construct_ctx {
 	box_construct_complete_cb cb;	/**< Callback to invoke on completion */
 
 	int *bctx;			/**< talloc context */
+
+	unsigned int elements;		/**< Number of elements styled */
+	unsigned int shared_styles;	/**< Elements which shared styles */
 };
 
 /**
@@ -232,6 +239,71 @@ box_extract_properties(dom_node *n, struct box_construct_props *props)
 }
 
 
+/**
+ * Get the style of an element's preceding sibling, if it may be shared.
+ *
+ * Runs of identical sibling elements, such as table cells and list items,
+ * are common.  If the preceding sibling element has the same name and
+ * attributes and its selection did not depend on its position or children,
+ * the element's computed style will be the same, so the sibling's
+ * selection results are shared rather than selected again.
+ *
+ * Elements which share styles have no libcss node data, so selection for
+ * their children falls back to a saturated bloom filter.  This is valid,
+ * just slower.
+ *
+ * \param  n  node in xml tree
+ * \return  a new reference to the sibling's styles, or NULL if none
+ */
+static css_select_results *box_get_shared_style(dom_node *n)
+{
+	dom_node *prev, *next;
+	dom_node_type type;
+	dom_exception err;
+	struct box *sibling;
+	css_select_results *styles = NULL;
+
+	/* Find preceding sibling element */
+	err = dom_node_get_previous_sibling(n, &prev);
+	if (err != DOM_NO_ERR)
+		return NULL;
+
+	while (prev != NULL) {
+		err = dom_node_get_node_type(prev, &type);
+		if (err != DOM_NO_ERR) {
+			dom_node_unref(prev);
+			return NULL;
+		}
+
+		if (type == DOM_ELEMENT_NODE)
+			break;
+
+		err = dom_node_get_previous_sibling(prev, &next);
+		dom_node_unref(prev);
+		if (err != DOM_NO_ERR)
+			return NULL;
+
+		prev = next;
+	}
+
+	if (prev == NULL)
+		return NULL;
+
+	sibling = box_for_node(prev);
+	if (sibling != NULL &&
+			sibling->node == prev &&
+			sibling->styles != NULL &&
+			(sibling->flags & STYLE_SHARABLE) &&
+			nscss_can_share_style(n, prev)) {
+		styles = nscss_select_results_ref(sibling->styles);
+	}
+
+	dom_node_unref(prev);
+
+	return styles;
+}
+
+
 /**
  * Get the style for an element.
  *
@@ -239,53 +311,57 @@ box_extract_properties(dom_node *n, struct box_construct_props *props)
  * \param  parent_style    style at this point in xml tree, or NULL for root
  * \param  root_style      root node's style, or NULL for root
  * \param  n               node in xml tree
+ * \param  sharable        updated to whether the style may be shared
  * \return  the new style, or NULL on memory exhaustion
  */
 static css_select_results *
 box_get_style(html_content *c,
 	      const css_computed_style *parent_style,
 	      const css_computed_style *root_style,
-	      dom_node *n)
+	      dom_node *n,
+	      bool *sharable)
 {
 	dom_string *s;
 	dom_exception err;
+	nserror error;
 	css_stylesheet *inline_style = NULL;
 	css_select_results *styles;
 	nscss_select_ctx ctx;
 
-	/* Firstly, construct inline stylesheet, if any */
+	/* Firstly, find inline stylesheet, if any */
 	err = dom_element_get_attribute(n, corestring_dom_style, &s);
 	if (err != DOM_NO_ERR)
 		return NULL;
 
 	if (s != NULL) {
-		inline_style = nscss_create_inline_style(
-				(const uint8_t *) dom_string_data(s),
-				dom_string_byte_length(s),
-				c->encoding,
-				nsurl_access(c->base_url),
-				c->quirks != DOM_DOCUMENT_QUIRKS_MODE_NONE);
+		/* The sheet is owned by the content's inline style cache */
+		error = html_css_inline_style(c, s, &inline_style);
 
 		dom_string_unref(s);
 
-		if (inline_style == NULL)
+		if (error != NSERROR_OK)
 			return NULL;
 	}
 
+	/* Link visited state is cached for the lifetime of the content.
+	 * Without a cache, :visited is simply looked up each time. */
+	if (c->visited == NULL) {
+		nscss_visited_cache_create(&c->visited);
+	}
+
 	/* Populate selection context */
 	ctx.ctx = c->select_ctx;
 	ctx.quirks = (c->quirks == DOM_DOCUMENT_QUIRKS_MODE_FULL);
 	ctx.base_url = c->base_url;
 	ctx.universal = c->universal;
+	ctx.visited = c->visited;
 	ctx.root_style = root_style;
 	ctx.parent_style = parent_style;
 
 	/* Select style for element */
 	styles = nscss_get_style(&ctx, n, &c->media, inline_style);
 
-	/* No longer need inline style */
-	if (inline_style != NULL)
-		css_stylesheet_destroy(inline_style);
+	*sharable = ctx.sharable;
 
 	return styles;
 }
@@ -502,6 +578,7 @@ box_construct_element(struct box_construct_ctx *ctx, bool *convert_children)
 	dom_exception err;
 	struct box_construct_props props;
 	const css_computed_style *root_style = NULL;
+	bool sharable = false;
 
 	assert(ctx->n != NULL);
 
@@ -518,10 +595,18 @@ box_construct_element(struct box_construct_ctx *ctx, bool *convert_children)
 		root_style = ctx->root_box->style;
 	}
 
-	styles = box_get_style(ctx->content, props.parent_style, root_style,
-			ctx->n);
-	if (styles == NULL)
-		return false;
+	ctx->elements++;
+
+	styles = box_get_shared_style(ctx->n);
+	if (styles != NULL) {
+		ctx->shared_styles++;
+		sharable = true;
+	} else {
+		styles = box_get_style(ctx->content, props.parent_style,
+				root_style, ctx->n, &sharable);
+		if (styles == NULL)
+			return false;
+	}
 
 	/* Extract title attribute, if present */
 	err = dom_element_get_attribute(ctx->n, corestring_dom_title, &title0);
@@ -563,6 +648,9 @@ box_construct_element(struct box_construct_ctx *ctx, bool *convert_children)
 	if (box == NULL)
 		return false;
 
+	if (sharable)
+		box->flags |= STYLE_SHARABLE;
+
 	/* If this is the root box, add it to the context */
 	if (props.node_is_root)
 		ctx->root_box = box;
@@ -636,7 +724,7 @@ box_construct_element(struct box_construct_ctx *ctx, bool *convert_children)
 	    (ns_computed_display(box->style,
 				 props.node_is_root) == CSS_DISPLAY_NONE &&
 	     props.node_is_root == false)) {
-		css_select_results_destroy(styles);
+		nscss_select_results_destroy(styles);
 		box->styles = NULL;
 		box->style = NULL;
 
@@ -1290,6 +1378,10 @@ static void convert_xml_to_box(struct box_construct_ctx *ctx)
 			/* Conversion complete */
 			struct box root;
 
+			NSLOG(netsurf, INFO,
+			      "Shared computed styles for %u of %u elements",
+			      ctx->shared_styles, ctx->elements);
+
 			memset(&root, 0, sizeof(root));
 
 			root.type = BOX_BLOCK;
@@ -1304,6 +1396,13 @@ static void convert_xml_to_box(struct box_construct_ctx *ctx)
 				ctx->content->layout = root.children;
 				ctx->content->layout->parent = NULL;
 
+				if (box_id_index_build(ctx->content) !=
+				    NSERROR_OK) {
+					/* lookups fall back to the tree */
+					NSLOG(netsurf, INFO,
+					      "Unable to index box ids");
+				}
+
 				ctx->cb(ctx->content, true);
 			}
 
@@ -1348,9 +1447,13 @@ dom_to_box(dom_node *n,
 	ctx->root_box = NULL;
 	ctx->cb = cb;
 	ctx->bctx = c->bctx;
+	ctx->elements = 0;
+	ctx->shared_styles = 0;
 
 	*box_conversion_context = ctx;
 
+	NSTRACE_ASYNC_BEGIN("html", "dom_to_box", c);
+
 	return guit->misc->schedule(0, (void *)convert_xml_to_box, ctx);
 }
 
@@ -1366,6 +1469,8 @@ nserror cancel_dom_to_box(void *box_conversion_context)
 		return err;
 	}
 
+	NSTRACE_ASYNC_END("html", "dom_to_box", ctx->content);
+
 	dom_node_unref(ctx->n);
 	free(ctx);
 
@@ -23,10 +23,14 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <dom/dom.h>
 
 #include "utils/nsurl.h"
 #include "utils/errors.h"
+#include "utils/log.h"
+#include "utils/hashmap.h"
+#include "netsurf/inttypes.h"
 #include "netsurf/types.h"
 #include "netsurf/content.h"
 #include "netsurf/mouse.h"
@@ -627,6 +631,148 @@ struct box *box_find_by_id(struct box *box, lwc_string *id)
 }
 
 
+/**
+ * Clone a box id index key
+ */
+static void *box_id_index_key_clone(void *key)
+{
+	return lwc_string_ref((lwc_string *)key);
+}
+
+/**
+ * Destroy a box id index key
+ */
+static void box_id_index_key_destroy(void *key)
+{
+	lwc_string_unref((lwc_string *)key);
+}
+
+/**
+ * Hash a box id index key
+ */
+static uint32_t box_id_index_key_hash(void *key)
+{
+	return lwc_string_hash_value((lwc_string *)key);
+}
+
+/**
+ * Compare two box id index keys
+ *
+ * Keys are interned so pointer equality is sufficient.
+ */
+static bool box_id_index_key_eq(void *key1, void *key2)
+{
+	return key1 == key2;
+}
+
+/**
+ * Allocate a box id index entry
+ */
+static void *box_id_index_value_alloc(void *key)
+{
+	return calloc(1, sizeof(struct box *));
+}
+
+/**
+ * Destroy a box id index entry
+ */
+static void box_id_index_value_destroy(void *value)
+{
+	free(value);
+}
+
+static hashmap_parameters_t box_id_index_hashmap_parameters = {
+	.key_clone = box_id_index_key_clone,
+	.key_destroy = box_id_index_key_destroy,
+	.key_hash = box_id_index_key_hash,
+	.key_eq = box_id_index_key_eq,
+	.value_alloc = box_id_index_value_alloc,
+	.value_destroy = box_id_index_value_destroy,
+};
+
+
+/* Exported function documented in html/box_inspect.h */
+nserror box_id_index_build(struct html_content *html)
+{
+	struct box *box = html->layout;
+	struct box **entry;
+
+	box_id_index_free(html);
+
+	if (box == NULL) {
+		return NSERROR_OK;
+	}
+
+	html->box_ids = hashmap_create(&box_id_index_hashmap_parameters);
+	if (html->box_ids == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	/* walk the tree in the same order as box_find_by_id() so the
+	 * first box with an id is the one recorded
+	 */
+	while (box != NULL) {
+		if (box->id != NULL &&
+		    hashmap_lookup(html->box_ids, box->id) == NULL) {
+			entry = hashmap_insert(html->box_ids, box->id);
+			if (entry == NULL) {
+				box_id_index_free(html);
+				return NSERROR_NOMEM;
+			}
+			*entry = box;
+		}
+
+		if (box->children != NULL) {
+			box = box->children;
+			continue;
+		}
+
+		while (box != html->layout && box->next == NULL) {
+			box = box->parent;
+		}
+		box = (box == html->layout) ? NULL : box->next;
+	}
+
+	NSLOG(netsurf, INFO, "Indexed %"PRIsizet" box ids for content %p",
+	      hashmap_count(html->box_ids), html);
+
+	return NSERROR_OK;
+}
+
+
+/* Exported function documented in html/box_inspect.h */
+void box_id_index_free(struct html_content *html)
+{
+	if (html->box_ids != NULL) {
+		hashmap_destroy(html->box_ids);
+		html->box_ids = NULL;
+	}
+}
+
+
+/* Exported function documented in html/box_inspect.h */
+struct box *box_id_index_find(struct html_content *html, lwc_string *id)
+{
+	struct box **entry;
+
+	if (html->layout == NULL) {
+		return NULL;
+	}
+
+	if (html->box_ids == NULL) {
+		/* no index; search the tree */
+		return box_find_by_id(html->layout, id);
+	}
+
+	entry = hashmap_lookup(html->box_ids, id);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	return *entry;
+}
+
+
 /* Exported function documented in html/box.h */
 bool box_visible(struct box *box)
 {
@@ -80,6 +80,40 @@ struct box *box_at_point(const nscss_len_ctx *len_ctx, struct box *box, const in
 struct box *box_find_by_id(struct box *box, lwc_string *id);
 
 
+/**
+ * Index the ids of the boxes of a HTML content.
+ *
+ * Each id is mapped to the box box_find_by_id() would find for it. The
+ *  index is built when the box tree is constructed and must be freed
+ *  with box_id_index_free() before the box tree is.
+ *
+ * \param  html  content whose box tree to index
+ * \return NSERROR_OK on success or NSERROR_NOMEM on memory exhaustion
+ */
+nserror box_id_index_build(struct html_content *html);
+
+
+/**
+ * Discard the box id index of a HTML content.
+ *
+ * \param  html  content whose index to discard
+ */
+void box_id_index_free(struct html_content *html);
+
+
+/**
+ * Find a box of a HTML content based upon its id attribute.
+ *
+ * Uses the content's box id index, falling back to searching the box
+ *  tree if there is no index.
+ *
+ * \param  html  content to search
+ * \param  id    id to look for
+ * \return  the box or NULL if not found
+ */
+struct box *box_id_index_find(struct html_content *html, lwc_string *id);
+
+
 /**
  * Determine if a box is visible when the tree is rendered.
  *
@@ -32,6 +32,7 @@
 #include "netsurf/types.h"
 #include "netsurf/mouse.h"
 #include "desktop/scrollbar.h"
+#include "css/select.h"
 
 #include "html/private.h"
 #include "html/form_internal.h"
@@ -56,7 +57,7 @@ static int box_talloc_destructor(struct box *b)
 	}
 
 	if (b->styles != NULL) {
-		css_select_results_destroy(b->styles);
+		nscss_select_results_destroy(b->styles);
 		b->styles = NULL;
 	}
 
@@ -83,6 +84,8 @@ static int box_talloc_destructor(struct box *b)
 		free(data);
 	}
 
+	box_child_index_free(b);
+
 	return 0;
 }
 
@@ -153,11 +156,23 @@ box_create(css_select_results *styles,
 	box->object_params = NULL;
 	box->iframe = NULL;
 	box->node = NULL;
+	box->child_index = NULL;
 
 	return box;
 }
 
 
+/* Exported function documented in html/box_manipulate.h */
+void box_child_index_free(struct box *box)
+{
+	if (box->child_index != NULL) {
+		free(box->child_index->entries);
+		free(box->child_index);
+		box->child_index = NULL;
+	}
+}
+
+
 /* Exported function documented in html/box.h */
 void box_add_child(struct box *parent, struct box *child)
 {
@@ -203,6 +218,8 @@ void box_unlink_and_free(struct box *box)
 			parent->children = next;
 		if (parent->last == box)
 			parent->last = next ? next : prev;
+		/* index would refer to the freed box until next layout */
+		box_child_index_free(parent);
 	}
 
 	if (prev)
@@ -240,8 +257,10 @@ void box_free_box(struct box *box)
 			scrollbar_destroy(box->scroll_x);
 		if (box->scroll_y != NULL)
 			scrollbar_destroy(box->scroll_y);
-		if (box->styles != NULL)
-			css_select_results_destroy(box->styles);
+		if (box->styles != NULL) {
+			nscss_select_results_destroy(box->styles);
+			box->styles = NULL;
+		}
 	}
 
 	talloc_free(box);
@@ -89,6 +89,14 @@ void box_free(struct box *box);
 void box_free_box(struct box *box);
 
 
+/**
+ * Free the child index of a box, if it has one.
+ *
+ * \param box box to free the child index of
+ */
+void box_child_index_free(struct box *box);
+
+
 /**
  * Applies the given scroll setup to a box. This includes scroll
  * creation/deletion as well as scroll dimension updates.
@@ -33,6 +33,7 @@
 #include "utils/nsoption.h"
 #include "utils/corestrings.h"
 #include "utils/log.h"
+#include "utils/hashmap.h"
 #include "netsurf/misc.h"
 #include "netsurf/content.h"
 #include "content/hlcache.h"
@@ -48,6 +49,20 @@ static nsurl *html_adblock_stylesheet_url;
 static nsurl *html_quirks_stylesheet_url;
 static nsurl *html_user_stylesheet_url;
 
+/**
+ * Minimum time between applying modified style elements once the
+ *  document has been converted, in ms.
+ */
+#define HTML_CSS_UPDATE_DELAY 20
+
+/**
+ * Entry in an HTML content's inline style cache
+ */
+struct html_inline_style {
+	css_stylesheet *sheet; /**< Parsed inline stylesheet */
+	nsurl *base_url; /**< Base URL the sheet was parsed against */
+};
+
 /**
  * Convert css error to netsurf error.
  */
@@ -85,6 +100,122 @@ static nserror css_error_to_nserror(css_error error)
 }
 
 
+/**
+ * Find where a sheet belongs in the selection context.
+ *
+ * Sheets are in the selection context in document order, the position
+ *  is after the last sheet in the context from an earlier slot.
+ *
+ * \param c html content
+ * \param s stylesheet slot to find the position of
+ * \return index in the selection context to insert the sheet at
+ */
+static uint32_t
+html_css_sheet_position(html_content *c, struct html_stylesheet *s)
+{
+	const css_stylesheet *ctx_sheet;
+	struct html_stylesheet *prev;
+	uint32_t count = 0;
+	uint32_t position = 0;
+	uint32_t idx;
+
+	css_select_ctx_count_sheets(c->select_ctx, &count);
+	for (idx = 0; idx != count; idx++) {
+		if (css_select_ctx_get_sheet(c->select_ctx,
+					     idx,
+					     &ctx_sheet) != CSS_OK) {
+			continue;
+		}
+
+		for (prev = c->stylesheets; prev != s; prev++) {
+			if ((prev->sheet != NULL) &&
+			    (prev->unused == false) &&
+			    (nscss_get_stylesheet(prev->sheet) == ctx_sheet)) {
+				position = idx + 1;
+				break;
+			}
+		}
+	}
+
+	return position;
+}
+
+
+/**
+ * Replace a sheet with its completed replacement.
+ *
+ * If the selection context already exists the replacement takes the
+ *  place of the old sheet within it rather than the context being
+ *  rebuilt.
+ *
+ * \param c html content
+ * \param s stylesheet whose pending replacement has completed
+ */
+static void html_css_replace_sheet(html_content *c, struct html_stylesheet *s)
+{
+	css_stylesheet *old_sheet = NULL;
+	css_stylesheet *new_sheet;
+	const css_stylesheet *ctx_sheet;
+	uint32_t count = 0;
+	uint32_t idx;
+	css_error css_ret;
+
+	if ((c->select_ctx != NULL) && (s->unused == false)) {
+		if (s->sheet != NULL) {
+			old_sheet = nscss_get_stylesheet(s->sheet);
+		}
+		new_sheet = nscss_get_stylesheet(s->pending);
+
+		/* find the old sheet's position in the selection context */
+		css_select_ctx_count_sheets(c->select_ctx, &count);
+		for (idx = 0; idx != count; idx++) {
+			css_ret = css_select_ctx_get_sheet(c->select_ctx,
+							   idx,
+							   &ctx_sheet);
+			if ((old_sheet != NULL) &&
+			    (css_ret == CSS_OK) &&
+			    (ctx_sheet == old_sheet)) {
+				break;
+			}
+		}
+
+		if (idx != count) {
+			css_select_ctx_remove_sheet(c->select_ctx, old_sheet);
+		} else {
+			idx = html_css_sheet_position(c, s);
+		}
+
+		if (new_sheet != NULL) {
+			css_ret = css_select_ctx_insert_sheet(c->select_ctx,
+							      new_sheet,
+							      idx,
+							      CSS_ORIGIN_AUTHOR,
+							      "screen");
+			if (css_ret != CSS_OK) {
+				NSLOG(netsurf, INFO,
+				      "Failed to insert replacement sheet");
+			}
+		}
+	}
+
+	if (s->sheet != NULL) {
+		/* the old sheet may still be loading, e.g. its imports */
+		switch (content_get_status(s->sheet)) {
+		case CONTENT_STATUS_DONE:
+			break;
+		default:
+			hlcache_handle_abort(s->sheet);
+			c->base.active--;
+			NSLOG(netsurf, INFO, "%d fetches active",
+			      c->base.active);
+		}
+		hlcache_handle_release(s->sheet);
+	}
+	s->sheet = s->pending;
+	s->pending = NULL;
+}
+
+
 /**
  * Callback for fetchcache() for stylesheets.
  */
@@ -101,7 +232,7 @@ html_convert_css_callback(hlcache_handle *css,
 	for (i = 0, s = parent->stylesheets;
 	     i != parent->stylesheet_count;
 	     i++, s++) {
-		if (s->sheet == css)
+		if (s->sheet == css || s->pending == css)
 			break;
 	}
 
@@ -112,6 +243,9 @@ html_convert_css_callback(hlcache_handle *css,
 	case CONTENT_MSG_DONE:
 		NSLOG(netsurf, INFO, "done stylesheet slot %d '%s'", i,
 		      nsurl_access(hlcache_handle_get_url(css)));
+		if (s->pending == css) {
+			html_css_replace_sheet(parent, s);
+		}
 		parent->base.active--;
 		NSLOG(netsurf, INFO, "%d fetches active", parent->base.active);
 		break;
@@ -122,7 +256,12 @@ html_convert_css_callback(hlcache_handle *css,
 		      event->data.errordata.errormsg);
 
 		hlcache_handle_release(css);
-		s->sheet = NULL;
+		if (s->pending == css) {
+			/* keep the sheet the failed one was to replace */
+			s->pending = NULL;
+		} else {
+			s->sheet = NULL;
+		}
 		parent->base.active--;
 		NSLOG(netsurf, INFO, "%d fetches active", parent->base.active);
 		break;
@@ -135,7 +274,11 @@ html_convert_css_callback(hlcache_handle *css,
 		break;
 	}
 
-	if (html_can_begin_conversion(parent)) {
+	/* once the selection context exists conversion is complete and
+	 * replaced sheets have already been swapped into it.
+	 */
+	if ((parent->select_ctx == NULL) &&
+	    html_can_begin_conversion(parent)) {
 		html_begin_conversion(parent);
 	}
 
@@ -144,14 +287,12 @@ html_convert_css_callback(hlcache_handle *css,
 
 
 static nserror
-html_stylesheet_from_domnode(html_content *c,
-			     dom_node *node,
-			     hlcache_handle **sheet)
+html_stylesheet_from_text(html_content *c,
+			  dom_string *style,
+			  hlcache_handle **sheet)
 {
 	hlcache_child_context child;
-	dom_string *style;
 	nsurl *url;
-	dom_exception exc;
 	nserror error;
 	uint32_t key;
 	char urlbuf[64];
@@ -159,20 +300,11 @@ html_stylesheet_from_domnode(html_content *c,
 	child.charset = c->encoding;
 	child.quirks = c->base.quirks;
 
-	exc = dom_node_get_text_content(node, &style);
-	if ((exc != DOM_NO_ERR) || (style == NULL)) {
-		NSLOG(netsurf, INFO, "No text content");
-		return NSERROR_OK;
-	}
-
 	error = html_css_fetcher_add_item(style, c->base_url, &key);
 	if (error != NSERROR_OK) {
-		dom_string_unref(style);
 		return error;
 	}
 
-	dom_string_unref(style);
-
 	snprintf(urlbuf, sizeof(urlbuf), "x-ns-css:%u", key);
 
 	error = nsurl_create(urlbuf, &url);
@@ -249,6 +381,8 @@ html_create_style_element(html_content *c, dom_node *style)
 
 	c->stylesheets[c->stylesheet_count].node = dom_node_ref(style);
 	c->stylesheets[c->stylesheet_count].sheet = NULL;
+	c->stylesheets[c->stylesheet_count].pending = NULL;
+	c->stylesheets[c->stylesheet_count].text = NULL;
 	c->stylesheets[c->stylesheet_count].modified = false;
 	c->stylesheets[c->stylesheet_count].unused = false;
 	c->stylesheet_count++;
@@ -257,37 +391,69 @@ html_create_style_element(html_content *c, dom_node *style)
 }
 
 
+/**
+ * Start fetching a replacement for a modified stylesheet.
+ *
+ * The existing sheet is kept until the replacement has been fetched
+ *  and no replacement is made if the text is unchanged.
+ */
 static bool
 html_css_process_modified_style(html_content *c, struct html_stylesheet *s)
 {
 	hlcache_handle *sheet = NULL;
+	dom_string *style;
+	lwc_string *text;
+	dom_exception exc;
 	nserror error;
 
-	error = html_stylesheet_from_domnode(c, s->node, &sheet);
+	exc = dom_node_get_text_content(s->node, &style);
+	if ((exc != DOM_NO_ERR) || (style == NULL)) {
+		NSLOG(netsurf, INFO, "No text content");
+		s->modified = false;
+		return true;
+	}
+
+	exc = dom_string_intern(style, &text);
+	if (exc != DOM_NO_ERR) {
+		dom_string_unref(style);
+		NSLOG(netsurf, INFO, "Failed to update sheet");
+		content_broadcast_error(&c->base, NSERROR_NOMEM, NULL);
+		return false;
+	}
+
+	if (text == s->text) {
+		/* interned so pointer equality means identical text */
+		NSLOG(netsurf, DEBUG, "Sheet %p unchanged", s->sheet);
+		lwc_string_unref(text);
+		dom_string_unref(style);
+		s->modified = false;
+		return true;
+	}
+
+	error = html_stylesheet_from_text(c, style, &sheet);
+	dom_string_unref(style);
 	if (error != NSERROR_OK) {
+		lwc_string_unref(text);
 		NSLOG(netsurf, INFO, "Failed to update sheet");
 		content_broadcast_error(&c->base, error, NULL);
 		return false;
 	}
 
-	if (sheet != NULL) {
-		NSLOG(netsurf, INFO, "Updating sheet %p with %p", s->sheet,
-		      sheet);
+	NSLOG(netsurf, INFO, "Updating sheet %p with %p", s->sheet, sheet);
 
-		if (s->sheet != NULL) {
-			switch (content_get_status(s->sheet)) {
-			case CONTENT_STATUS_DONE:
-				break;
-			default:
-				hlcache_handle_abort(s->sheet);
-				c->base.active--;
-				NSLOG(netsurf, INFO, "%d fetches active",
-				      c->base.active);
-			}
-			hlcache_handle_release(s->sheet);
-		}
-		s->sheet = sheet;
+	if (s->pending != NULL) {
+		/* superseded before it was complete */
+		hlcache_handle_abort(s->pending);
+		hlcache_handle_release(s->pending);
+		c->base.active--;
+		NSLOG(netsurf, INFO, "%d fetches active", c->base.active);
 	}
+	s->pending = sheet;
+
+	if (s->text != NULL) {
+		lwc_string_unref(s->text);
+	}
+	s->text = text;
 
 	s->modified = false;
 
@@ -314,6 +480,9 @@ static void html_css_process_modified_styles(void *pw)
 	/* If we failed to process any sheet, schedule a retry */
 	if (all_done == false) {
 		guit->misc->schedule(1000, html_css_process_modified_styles, c);
+	} else if ((c->select_ctx == NULL) && html_can_begin_conversion(c)) {
+		/* unchanged sheets may have been all conversion waited on */
+		html_begin_conversion(c);
 	}
 }
 
@@ -339,9 +508,25 @@ bool html_css_update_style(html_content *c, dom_node *style)
 		return false;
 	}
 
+	/* Mutations are coalesced; an update is already scheduled if any
+	 * sheet is waiting to be processed.
+	 */
+	for (i = 0; i != c->stylesheet_count; i++) {
+		if (c->stylesheets[i].modified) {
+			break;
+		}
+	}
+
 	s->modified = true;
 
-	guit->misc->schedule(0, html_css_process_modified_styles, c);
+	if (i == c->stylesheet_count) {
+		/* Once the document is converted updates are applied at
+		 * most once per frame.
+		 */
+		guit->misc->schedule(
+			(c->select_ctx == NULL) ? 0 : HTML_CSS_UPDATE_DELAY,
+			html_css_process_modified_styles, c);
+	}
 
 	return true;
 }
@@ -458,6 +643,8 @@ bool html_css_process_link(html_content *htmlc, dom_node *node)
 
 	htmlc->stylesheets = stylesheets;
 	htmlc->stylesheets[htmlc->stylesheet_count].node = NULL;
+	htmlc->stylesheets[htmlc->stylesheet_count].pending = NULL;
+	htmlc->stylesheets[htmlc->stylesheet_count].text = NULL;
 	htmlc->stylesheets[htmlc->stylesheet_count].modified = false;
 	htmlc->stylesheets[htmlc->stylesheet_count].unused = false;
 
@@ -473,6 +660,11 @@ bool html_css_process_link(html_content *htmlc, dom_node *node)
 
 	nsurl_unref(joined);
 
+	if (ns_error == NSERROR_BLOCKED) {
+		/* blocked stylesheets are silently omitted */
+		return true;
+	}
+
 	if (ns_error != NSERROR_OK)
 		goto no_memory;
 
@@ -522,6 +714,130 @@ bool html_css_saw_insecure_stylesheets(html_content *html)
 }
 
 
+/**
+ * Clone an inline style cache key
+ */
+static void *html_inline_style_key_clone(void *key)
+{
+	return lwc_string_ref((lwc_string *)key);
+}
+
+/**
+ * Destroy an inline style cache key
+ */
+static void html_inline_style_key_destroy(void *key)
+{
+	lwc_string_unref((lwc_string *)key);
+}
+
+/**
+ * Hash an inline style cache key
+ */
+static uint32_t html_inline_style_key_hash(void *key)
+{
+	return lwc_string_hash_value((lwc_string *)key);
+}
+
+/**
+ * Compare two inline style cache keys
+ *
+ * Keys are interned so pointer equality is sufficient.
+ */
+static bool html_inline_style_key_eq(void *key1, void *key2)
+{
+	return key1 == key2;
+}
+
+/**
+ * Allocate an inline style cache entry
+ */
+static void *html_inline_style_value_alloc(void *key)
+{
+	return calloc(1, sizeof(struct html_inline_style));
+}
+
+/**
+ * Destroy an inline style cache entry
+ */
+static void html_inline_style_value_destroy(void *value)
+{
+	struct html_inline_style *entry = value;
+
+	if (entry->sheet != NULL) {
+		css_stylesheet_destroy(entry->sheet);
+	}
+	if (entry->base_url != NULL) {
+		nsurl_unref(entry->base_url);
+	}
+	free(entry);
+}
+
+static hashmap_parameters_t html_inline_style_hashmap_parameters = {
+	.key_clone = html_inline_style_key_clone,
+	.key_destroy = html_inline_style_key_destroy,
+	.key_hash = html_inline_style_key_hash,
+	.key_eq = html_inline_style_key_eq,
+	.value_alloc = html_inline_style_value_alloc,
+	.value_destroy = html_inline_style_value_destroy,
+};
+
+
+/* exported function documented in html/css.h */
+nserror
+html_css_inline_style(html_content *c,
+		      dom_string *style,
+		      css_stylesheet **sheet_out)
+{
+	struct html_inline_style *entry;
+	lwc_string *key;
+	dom_exception exc;
+
+	if (c->inline_styles == NULL) {
+		c->inline_styles = hashmap_create(
+				&html_inline_style_hashmap_parameters);
+		if (c->inline_styles == NULL) {
+			return NSERROR_NOMEM;
+		}
+	}
+
+	exc = dom_string_intern(style, &key);
+	if (exc != DOM_NO_ERR) {
+		return NSERROR_NOMEM;
+	}
+
+	entry = hashmap_lookup(c->inline_styles, key);
+	if ((entry != NULL) &&
+	    (entry->sheet != NULL) &&
+	    (entry->base_url == c->base_url)) {
+		lwc_string_unref(key);
+		*sheet_out = entry->sheet;
+		return NSERROR_OK;
+	}
+
+	/* Not cached, or cached against a stale base URL; (re)parse it */
+	entry = hashmap_insert(c->inline_styles, key);
+	lwc_string_unref(key);
+	if (entry == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	entry->sheet = nscss_create_inline_style(
+			(const uint8_t *) dom_string_data(style),
+			dom_string_byte_length(style),
+			c->encoding,
+			nsurl_access(c->base_url),
+			c->quirks != DOM_DOCUMENT_QUIRKS_MODE_NONE);
+	if (entry->sheet == NULL) {
+		return NSERROR_CSS;
+	}
+	entry->base_url = nsurl_ref(c->base_url);
+
+	*sheet_out = entry->sheet;
+
+	return NSERROR_OK;
+}
+
+
 /* exported function documented in html/css.h */
 nserror html_css_free_stylesheets(html_content *html)
 {
@@ -533,12 +849,23 @@ nserror html_css_free_stylesheets(html_content *html)
 		if (html->stylesheets[i].sheet != NULL) {
 			hlcache_handle_release(html->stylesheets[i].sheet);
 		}
+		if (html->stylesheets[i].pending != NULL) {
+			hlcache_handle_release(html->stylesheets[i].pending);
+		}
+		if (html->stylesheets[i].text != NULL) {
+			lwc_string_unref(html->stylesheets[i].text);
+		}
 		if (html->stylesheets[i].node != NULL) {
 			dom_node_unref(html->stylesheets[i].node);
 		}
 	}
 	free(html->stylesheets);
 
+	if (html->inline_styles != NULL) {
+		hashmap_destroy(html->inline_styles);
+		html->inline_styles = NULL;
+	}
+
 	return NSERROR_OK;
 }
 
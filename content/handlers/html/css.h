@@ -69,6 +69,21 @@ nserror html_css_quirks_stylesheets(struct html_content *c);
  */
 nserror html_css_free_stylesheets(struct html_content *html);
 
+/**
+ * Get the parsed stylesheet for an inline style attribute
+ *
+ * Parsed inline styles are cached on the content keyed by their interned
+ * text, so identical style attributes are only parsed once per document
+ * and are reused when the box tree is rebuilt.
+ *
+ * \param htmlc The HTML content.
+ * \param style The style attribute value.
+ * \param sheet_out Updated with the stylesheet, which is owned by the
+ *                  content and remains valid until its stylesheets are freed.
+ * \return NSERROR_OK on success and \a sheet_out updated else error code.
+ */
+nserror html_css_inline_style(struct html_content *htmlc, dom_string *style, css_stylesheet **sheet_out);
+
 /**
  * determine if any of the stylesheets were loaded insecurely
  *
@@ -59,6 +59,7 @@
 #include "html/box_inspect.h"
 #include "html/font.h"
 #include "html/form_internal.h"
+#include "html/textsearch.h"
 
 #define MAX_SELECT_HEIGHT 210
 #define SELECT_LINE_SPACING 0.2
@@ -1384,6 +1385,7 @@ form__select_process_selection(html_content *html,
 	}
 	inline_box->width = control->box->width;
 
+	html_textsearch_invalidate(html);
 	html__redraw_a_box(html, control->box);
 
 	return ret;
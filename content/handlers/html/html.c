@@ -35,6 +35,7 @@
 #include "utils/http.h"
 #include "utils/libdom.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/messages.h"
 #include "utils/talloc.h"
 #include "utils/utf8.h"
@@ -55,6 +56,7 @@
 #include "desktop/textarea.h"
 #include "netsurf/bitmap.h"
 #include "javascript/js.h"
+#include "css/select.h"
 #include "desktop/gui_internal.h"
 
 #include "html/html.h"
@@ -71,9 +73,14 @@
 #include "html/imagemap.h"
 #include "html/layout.h"
 #include "html/textselection.h"
+#include "html/textsearch.h"
+#include "html/preload.h"
 
 #define CHUNK 4096
 
+/** Maximum number of speculative preloads for a document */
+#define HTML_PRELOAD_MAX 64
+
 /* Change these to 1 to cause a dump to stderr of the frameset or box
  * when the trees have been built.
  */
@@ -207,6 +214,170 @@ bool fire_dom_keyboard_event(dom_string *type, dom_node *target,
 	return result;
 }
 
+/**
+ * Callback for hlcache_handle_retrieve() for speculative preloads.
+ *
+ * The fetch only exists to be shared with the document's own fetch so
+ *  nothing is done with the content. Failed fetches are dropped.
+ */
+static nserror
+html_preload_callback(hlcache_handle *handle,
+		      const hlcache_event *event,
+		      void *pw)
+{
+	html_content *htmlc = pw;
+	unsigned int i;
+
+	if (event->type != CONTENT_MSG_ERROR) {
+		return NSERROR_OK;
+	}
+
+	for (i = 0; i != htmlc->preload_count; i++) {
+		if (htmlc->preloads[i] == handle) {
+			hlcache_handle_release(handle);
+			htmlc->preloads[i] = NULL;
+			break;
+		}
+	}
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Reference found by the speculative preload scanner.
+ *
+ * References are only fetched while the parse is blocked on a
+ *  synchronous script as otherwise the parser finds them as soon.
+ *  They are fetched exactly as the document's own fetch will be so the
+ *  low level cache object, and where possible the content, are shared.
+ */
+static void
+html_preload_found(enum html_preload_type type, const char *url, void *pw)
+{
+	html_content *htmlc = pw;
+	hlcache_handle **preloads;
+	hlcache_child_context child;
+	content_type types;
+	uint32_t flags = 0;
+	nsurl *joined;
+	unsigned int i;
+	nserror err;
+
+	if (type == HTML_PRELOAD_BASE) {
+		if (htmlc->preload_base == NULL) {
+			err = nsurl_join(content_get_url(&htmlc->base), url,
+					 &htmlc->preload_base);
+			if (err != NSERROR_OK) {
+				htmlc->preload_base = NULL;
+			}
+		}
+		return;
+	}
+
+	if ((htmlc->aborted) ||
+	    (htmlc->preload_count == HTML_PRELOAD_MAX) ||
+	    (html_script_parse_blocked(htmlc) == false)) {
+		return;
+	}
+
+	switch (type) {
+	case HTML_PRELOAD_STYLESHEET:
+		types = CONTENT_CSS;
+		break;
+
+	case HTML_PRELOAD_SCRIPT:
+		types = CONTENT_SCRIPT;
+		break;
+
+	case HTML_PRELOAD_IMAGE:
+		if (nsoption_bool(foreground_images) == false) {
+			return;
+		}
+		flags = HLCACHE_RETRIEVE_SNIFF_TYPE;
+		types = CONTENT_IMAGE;
+		break;
+
+	default:
+		return;
+	}
+
+	err = nsurl_join((htmlc->preload_base != NULL) ?
+			 htmlc->preload_base : htmlc->base_url,
+			 url, &joined);
+	if (err != NSERROR_OK) {
+		return;
+	}
+
+	for (i = 0; i != htmlc->preload_count; i++) {
+		if ((htmlc->preloads[i] != NULL) &&
+		    nsurl_compare(hlcache_handle_get_url(htmlc->preloads[i]),
+				  joined, NSURL_COMPLETE)) {
+			nsurl_unref(joined);
+			return;
+		}
+	}
+
+	preloads = realloc(htmlc->preloads,
+			   sizeof(*preloads) * (htmlc->preload_count + 1));
+	if (preloads == NULL) {
+		nsurl_unref(joined);
+		return;
+	}
+	htmlc->preloads = preloads;
+
+	child.charset = htmlc->encoding;
+	child.quirks = htmlc->base.quirks;
+
+	err = hlcache_handle_retrieve(joined,
+				      flags,
+				      content_get_url(&htmlc->base),
+				      NULL,
+				      html_preload_callback,
+				      htmlc,
+				      &child,
+				      types,
+				      &preloads[htmlc->preload_count]);
+	if (err == NSERROR_OK) {
+		NSLOG(netsurf, INFO, "preload %u '%s'", htmlc->preload_count,
+		      nsurl_access(joined));
+		htmlc->preload_count++;
+	}
+
+	nsurl_unref(joined);
+}
+
+
+/**
+ * Release speculative preload state of a document.
+ *
+ * \param htmlc HTML content to release the preloads of
+ */
+static void html_preload_free(html_content *htmlc)
+{
+	unsigned int i;
+
+	if (htmlc->preload != NULL) {
+		html_preload_destroy(htmlc->preload);
+		htmlc->preload = NULL;
+	}
+
+	if (htmlc->preload_base != NULL) {
+		nsurl_unref(htmlc->preload_base);
+		htmlc->preload_base = NULL;
+	}
+
+	for (i = 0; i != htmlc->preload_count; i++) {
+		if (htmlc->preloads[i] != NULL) {
+			hlcache_handle_release(htmlc->preloads[i]);
+		}
+	}
+	free(htmlc->preloads);
+	htmlc->preloads = NULL;
+	htmlc->preload_count = 0;
+}
+
+
 /**
  * Perform post-box-creation conversion of a document
  *
@@ -220,9 +391,17 @@ static void html_box_convert_done(html_content *c, bool success)
 	dom_node *html;
 
 	NSLOG(netsurf, INFO, "DOM to box conversion complete (content %p)", c);
+	NSTRACE_ASYNC_END("html", "dom_to_box", c);
 
 	c->box_conversion_context = NULL;
 
+	/* the document's own fetches have been made */
+	html_preload_free(c);
+
+	if (success) {
+		nsu_getmonotonic_ms(&c->base.timing.constructed);
+	}
+
 	/* Clean up and report error if unsuccessful or aborted */
 	if ((success == false) || (c->aborted)) {
 		html_object_free_objects(c);
@@ -303,6 +482,92 @@ html_proceed_to_done(html_content *html)
 }
 
 
+/**
+ * Report the timing of one resource of a document
+ *
+ * \param h Handle of the resource content
+ * \param initiator Kind of element the resource is for
+ * \param cb Callback to report the resource to
+ * \param pw Context passed to callback
+ */
+static void
+html_report_resource_timing(struct hlcache_handle *h,
+			    const char *initiator,
+			    html_resource_timing_cb *cb,
+			    void *pw)
+{
+	struct html_resource_timing rt;
+
+	if (content_get_timing(h, &rt.timing) != NSERROR_OK) {
+		return;
+	}
+	rt.initiator = initiator;
+	rt.url = hlcache_handle_get_url(h);
+	(void) content_get_source_data(h, &rt.size);
+
+	cb(&rt, pw);
+}
+
+
+/* Documented in html_internal.h */
+void
+html_enumerate_resource_timing(html_content *htmlc,
+			       html_resource_timing_cb *cb,
+			       void *pw)
+{
+	struct content_html_object *object;
+	unsigned int idx;
+
+	for (idx = STYLESHEET_START; idx < htmlc->stylesheet_count; idx++) {
+		struct hlcache_handle *sheet = htmlc->stylesheets[idx].sheet;
+		lwc_string *scheme;
+		bool inline_sheet = false;
+
+		if (sheet == NULL) {
+			continue;
+		}
+
+		scheme = nsurl_get_component(hlcache_handle_get_url(sheet),
+					     NSURL_SCHEME);
+		if (scheme != NULL) {
+			inline_sheet = (scheme == corestring_lwc_x_ns_css);
+			lwc_string_unref(scheme);
+		}
+		if (inline_sheet == false) {
+			html_report_resource_timing(sheet, "link", cb, pw);
+		}
+	}
+
+	for (idx = 0; idx < htmlc->scripts_count; idx++) {
+		struct html_script *script = &htmlc->scripts[idx];
+
+		if ((script->type != HTML_SCRIPT_INLINE) &&
+		    (script->data.handle != NULL)) {
+			html_report_resource_timing(script->data.handle,
+						    "script", cb, pw);
+		}
+	}
+
+	for (object = htmlc->object_list;
+	     object != NULL;
+	     object = object->next) {
+		const char *initiator = "img";
+
+		if (object->content == NULL) {
+			continue;
+		}
+		if (object->background) {
+			initiator = "css";
+		} else if ((object->box != NULL) &&
+			   (object->box->object_params != NULL)) {
+			initiator = "object";
+		}
+		html_report_resource_timing(object->content,
+					    initiator, cb, pw);
+	}
+}
+
+
 static void html_get_dimensions(html_content *htmlc)
 {
 	unsigned w;
@@ -369,6 +634,7 @@ void html_finish_conversion(html_content *htmlc)
 	 * object, but with its target set to the Document object (and
 	 * the currentTarget set to the Window object)
 	 */
+	nsu_getmonotonic_ms(&htmlc->base.timing.load_event);
 	if (htmlc->jsthread != NULL) {
 		js_fire_event(htmlc->jsthread, "load", htmlc->document, NULL);
 	}
@@ -461,12 +727,16 @@ html_create_html_data(html_content *c, const http_parameter *params)
 	c->title = NULL;
 	c->bctx = NULL;
 	c->layout = NULL;
+	c->textsearch_index = NULL;
+	c->box_ids = NULL;
 	c->background_colour = NS_TRANSPARENT;
 	c->stylesheet_count = 0;
 	c->stylesheets = NULL;
 	c->select_ctx = NULL;
 	c->media.type = CSS_MEDIA_SCREEN;
 	c->universal = NULL;
+	c->inline_styles = NULL;
+	c->visited = NULL;
 	c->num_objects = 0;
 	c->object_list = NULL;
 	c->forms = NULL;
@@ -485,6 +755,10 @@ html_create_html_data(html_content *c, const http_parameter *params)
 	c->scripts_count = 0;
 	c->scripts = NULL;
 	c->jsthread = NULL;
+	c->preload = NULL;
+	c->preload_base = NULL;
+	c->preload_count = 0;
+	c->preloads = NULL;
 
 	c->enable_scripting = nsoption_bool(enable_javascript);
 	c->base.active = 1; /* The html content itself is active */
@@ -563,6 +837,16 @@ html_create_html_data(html_content *c, const http_parameter *params)
 
 	assert(old_node_data == NULL);
 
+	/* Only synchronous scripts block the parse, so there is nothing
+	 * for the preload scanner to gain without scripting.
+	 */
+	if (c->enable_scripting &&
+	    html_preload_create(html_preload_found, c,
+				&c->preload) != NSERROR_OK) {
+		NSLOG(netsurf, INFO, "Unable to create preload scanner.");
+		c->preload = NULL;
+	}
+
 	return NSERROR_OK;
 
 }
@@ -723,6 +1007,11 @@ html_process_data(struct content *c, const char *data, unsigned int size)
 		 err = html_process_encoding_change(c, data, size);
 	}
 
+	/* scan ahead of a parse blocked on a synchronous script */
+	if ((err == NSERROR_OK) && (html->preload != NULL)) {
+		html_preload_scan(html->preload, data, size);
+	}
+
 	/* broadcast the error if necessary */
 	if (err != NSERROR_OK) {
 		content_broadcast_error(c, err, NULL);
@@ -844,6 +1133,7 @@ html_begin_conversion(html_content *htmlc)
 			return false;
 		}
 		htmlc->parse_completed = true;
+		nsu_getmonotonic_ms(&htmlc->base.timing.parsed);
 	}
 
 	if (html_can_begin_conversion(htmlc) == false) {
@@ -870,6 +1160,7 @@ html_begin_conversion(html_content *htmlc)
 	/* fire a simple event that bubbles named DOMContentLoaded at
 	 * the Document.
 	 */
+	nsu_getmonotonic_ms(&htmlc->base.timing.dom_content_loaded);
 
 	/* get encoding */
 	if (htmlc->encoding == NULL) {
@@ -1039,9 +1330,14 @@ static void html_reformat(struct content *c, int width, int height)
 	htmlc->len_ctx.vh = nscss_pixels_physical_to_css(INTTOFIX(height));
 	htmlc->len_ctx.root_style = htmlc->layout->style;
 
+	NSTRACE_BEGIN("layout", "layout_document");
 	layout_document(htmlc, width, height);
+	NSTRACE_END("layout", "layout_document");
 	layout = htmlc->layout;
 
+	/* layout may have split text boxes differently */
+	html_textsearch_invalidate(htmlc);
+
 	/* width and height are at least margin box of document */
 	c->width = layout->x + layout->padding[LEFT] + layout->width +
 		layout->padding[RIGHT] + layout->border[RIGHT].width +
@@ -1260,16 +1556,26 @@ static void html_destroy(struct content *c)
 		html->universal = NULL;
 	}
 
+	if (html->visited != NULL) {
+		nscss_visited_cache_destroy(html->visited);
+		html->visited = NULL;
+	}
+
 	/* Free stylesheets */
 	html_css_free_stylesheets(html);
 
 	/* Free scripts */
 	html_script_free(html);
 
+	/* Free speculative preloads */
+	html_preload_free(html);
+
 	/* Free objects */
 	html_object_free_objects(html);
 
 	/* free layout */
+	html_textsearch_invalidate(html);
+	box_id_index_free(html);
 	html_free_layout(html);
 }
 
@@ -2039,14 +2345,13 @@ const char *html_get_base_target(hlcache_handle *h)
 bool html_get_id_offset(hlcache_handle *h, lwc_string *frag_id, int *x, int *y)
 {
 	struct box *pos;
-	struct box *layout;
 
 	if (content_get_type(h) != CONTENT_HTML)
 		return false;
 
-	layout = html_get_box_tree(h);
-
-	if ((pos = box_find_by_id(layout, frag_id)) != 0) {
+	pos = box_id_index_find((html_content *)hlcache_handle_get_content(h),
+				frag_id);
+	if (pos != NULL) {
 		box_coords(pos, x, y);
 		return true;
 	}
@@ -2182,130 +2487,6 @@ static void html_fini(void)
 	html_css_fini();
 }
 
-/**
- * Finds all occurrences of a given string in an html box
- *
- * \param pattern   the string pattern to search for
- * \param p_len     pattern length
- * \param cur       pointer to the current box
- * \param case_sens whether to perform a case sensitive search
- * \param context   The search context to add the entry to.
- * \return true on success, false on memory allocation failure
- */
-static nserror
-find_occurrences_html_box(const char *pattern,
-			  int p_len,
-			  struct box *cur,
-			  bool case_sens,
-			  struct textsearch_context *context)
-{
-	struct box *a;
-	nserror res = NSERROR_OK;
-
-	/* ignore this box, if there's no visible text */
-	if (!cur->object && cur->text) {
-		const char *text = cur->text;
-		unsigned length = cur->length;
-
-		while (length > 0) {
-			unsigned match_length;
-			unsigned match_offset;
-			const char *new_text;
-			const char *pos;
-
-			pos = content_textsearch_find_pattern(text,
-					   length,
-					   pattern,
-					   p_len,
-					   case_sens,
-					   &match_length);
-			if (!pos)
-				break;
-
-			/* found string in box => add to list */
-			match_offset = pos - cur->text;
-
-			res = content_textsearch_add_match(context,
-					cur->byte_offset + match_offset,
-					cur->byte_offset + match_offset + match_length,
-					cur,
-					cur);
-			if (res != NSERROR_OK) {
-				return res;
-			}
-
-			new_text = pos + match_length;
-			length -= (new_text - text);
-			text = new_text;
-		}
-	}
-
-	/* and recurse */
-	for (a = cur->children; a; a = a->next) {
-		res = find_occurrences_html_box(pattern,
-						p_len,
-						a,
-						case_sens,
-						context);
-		if (res != NSERROR_OK) {
-			return res;
-		}
-	}
-
-	return res;
-}
-
-/**
- * Finds all occurrences of a given string in the html box tree
- *
- * \param pattern   the string pattern to search for
- * \param p_len     pattern length
- * \param c The content to search
- * \param csens whether to perform a case sensitive search
- * \param context   The search context to add the entry to.
- * \return true on success, false on memory allocation failure
- */
-static nserror
-html_textsearch_find(struct content *c,
-		     struct textsearch_context *context,
-		     const char *pattern,
-		     int p_len,
-		     bool csens)
-{
-	html_content *html = (html_content *)c;
-
-	if (html->layout == NULL) {
-		return NSERROR_INVALID;
-	}
-
-	return find_occurrences_html_box(pattern,
-					 p_len,
-					 html->layout,
-					 csens,
-					 context);
-}
-
-
-static nserror
-html_textsearch_bounds(struct content *c,
-		       unsigned start_idx,
-		       unsigned end_idx,
-		       struct box *start_box,
-		       struct box *end_box,
-		       struct rect *bounds)
-{
-	/* get box position and jump to it */
-	box_coords(start_box, &bounds->x0, &bounds->y0);
-	/* \todo: move x0 in by correct idx */
-	box_coords(end_box, &bounds->x1, &bounds->y1);
-	/* \todo: move x1 in by correct idx */
-	bounds->x1 += end_box->width;
-	bounds->y1 += end_box->height;
-
-	return NSERROR_OK;
-}
-
-
 /**
  * HTML content handler function table
  */
@@ -58,6 +58,8 @@ struct plot_font_style;
 struct html_stylesheet {
 	struct dom_node *node; /**< dom node associated with sheet */
 	struct hlcache_handle *sheet;
+	struct hlcache_handle *pending; /**< replacement sheet being fetched */
+	struct lwc_string_s *text; /**< text the newest sheet was made from */
 	bool modified;
 	bool unused;
 };
@@ -78,6 +80,9 @@ struct html_script {
 	} data;	/**< Script data */
 	struct dom_string *mimetype;
 	struct dom_string *encoding;
+	/** compilation on a worker thread in progress */
+	struct html_script_precompile *precompile;
+	bool precompiled; /**< compilation has been attempted */
 	bool already_started;
 	bool parser_inserted;
 	bool force_async;
@@ -63,6 +63,7 @@
 #include "html/private.h"
 #include "html/box.h"
 #include "html/box_inspect.h"
+#include "html/box_manipulate.h"
 #include "html/font.h"
 #include "html/form_internal.h"
 #include "html/layout.h"
@@ -5292,6 +5293,98 @@ layout_update_descendant_bbox(
 }
 
 
+/**
+ * Minimum number of in-flow children for a box to get a child index
+ */
+#define LAYOUT_CHILD_INDEX_MIN 32
+
+
+/**
+ * Build the vertical extent index of a box's in-flow children.
+ *
+ * Must be called after the descendant bounding boxes of the children
+ * have been calculated. Any existing index is discarded. No index is
+ * built if there are too few children or if the tops of the children
+ * are not in document order, as happens with positioned children.
+ *
+ * \param  box  box to index the children of
+ */
+static void layout_index_children(struct box *box)
+{
+	struct box_child_index *index;
+	struct box *child;
+	unsigned int count = 0;
+	unsigned int i = 0;
+	int y0, y1;
+	int last_y0 = INT_MIN;
+	int max_y1 = INT_MIN;
+
+	box_child_index_free(box);
+
+	if (box->type != BOX_BLOCK &&
+			box->type != BOX_INLINE_BLOCK &&
+			box->type != BOX_TABLE_CELL)
+		return;
+
+	for (child = box->children; child; child = child->next) {
+		if (child->type != BOX_FLOAT_LEFT &&
+				child->type != BOX_FLOAT_RIGHT)
+			count++;
+	}
+
+	if (count < LAYOUT_CHILD_INDEX_MIN)
+		return;
+
+	index = malloc(sizeof *index);
+	if (index == NULL)
+		return;
+
+	index->entries = malloc(count * sizeof index->entries[0]);
+	if (index->entries == NULL) {
+		free(index);
+		return;
+	}
+
+	for (child = box->children; child; child = child->next) {
+		if (child->type == BOX_FLOAT_LEFT ||
+				child->type == BOX_FLOAT_RIGHT)
+			continue;
+
+		/* union of the child's border box and its descendants, which
+		 * contains whatever redraw may plot for the child */
+		y0 = -child->border[TOP].width;
+		if (child->descendant_y0 < y0)
+			y0 = child->descendant_y0;
+		y1 = child->padding[TOP] + child->height +
+				child->padding[BOTTOM] +
+				child->border[BOTTOM].width;
+		if (child->descendant_y1 > y1)
+			y1 = child->descendant_y1;
+		y0 += child->y;
+		y1 += child->y + 1;
+
+		if (y0 < last_y0) {
+			/* out of order; redraw must test every child */
+			free(index->entries);
+			free(index);
+			return;
+		}
+		last_y0 = y0;
+
+		if (y1 > max_y1)
+			max_y1 = y1;
+
+		index->entries[i].box = child;
+		index->entries[i].y0 = y0;
+		index->entries[i].y1 = max_y1;
+		i++;
+	}
+
+	index->count = count;
+	box->child_index = index;
+}
+
+
 /**
  * Recursively calculate the descendant_[xy][01] values for a laid-out box tree
  * and inform iframe browser windows of their size and position.
@@ -5373,6 +5466,8 @@ static void layout_calculate_descendant_bboxes(
 		layout_update_descendant_bbox(len_ctx, box, child, 0, 0);
 	}
 
+	layout_index_children(box);
+
 	for (child = box->float_children; child; child = child->next_float) {
 		assert(child->type == BOX_FLOAT_LEFT ||
 				child->type == BOX_FLOAT_RIGHT);
@@ -0,0 +1,528 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * HTML speculative preload scanner implementation.
+ *
+ * This is a cut down version of the HTML tokeniser states. The text of
+ *  each tag is collected into a buffer and examined once the tag ends,
+ *  which keeps the state carried between chunks small. Only the name
+ *  of a tag too long for the buffer is used.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/config.h"
+#include "utils/ascii.h"
+
+#include "html/preload.h"
+
+/** Longest tag text examined */
+#define PRELOAD_TAG_MAX 2048
+
+/** Longest tag or attribute name of interest, plus terminator */
+#define PRELOAD_NAME_MAX 16
+
+/** Tokeniser state */
+enum preload_state {
+	PRELOAD_DATA, /**< document text */
+	PRELOAD_TAG_OPEN, /**< after a '<' */
+	PRELOAD_TAG, /**< collecting tag text */
+	PRELOAD_DECL, /**< after "<!" */
+	PRELOAD_COMMENT, /**< within a comment */
+	PRELOAD_BOGUS, /**< skipping to the next '>' */
+};
+
+/** Preload scanner */
+struct html_preload {
+	html_preload_cb *cb; /**< reference callback */
+	void *pw; /**< callback client data */
+
+	enum preload_state state; /**< tokeniser state */
+
+	/** Raw text element whose end tag is awaited, or empty */
+	char rawtext[PRELOAD_NAME_MAX];
+
+	char tag[PRELOAD_TAG_MAX + 1]; /**< collected tag text */
+	size_t tag_len; /**< length of collected tag text */
+	bool tag_overflow; /**< tag text did not fit the buffer */
+	char quote; /**< quote ending the current attribute value or 0 */
+
+	unsigned int dashes; /**< consecutive '-' in comment or declaration */
+
+	char value[PRELOAD_TAG_MAX + 1]; /**< decoded attribute value */
+};
+
+/**
+ * Elements whose content is not markup.
+ *
+ * noscript is included as the scanner is only of use when scripting is
+ *  enabled.
+ */
+static const char *preload_rawtext[] = {
+	"script", "style", "textarea", "title", "noscript",
+	"xmp", "iframe", "noembed", "noframes", NULL
+};
+
+/** Named character references decoded in attribute values */
+static const struct {
+	const char *name;
+	char c;
+} preload_entities[] = {
+	{ "amp", '&' }, { "lt", '<' }, { "gt", '>' },
+	{ "quot", '"' }, { "apos", '\'' }, { NULL, 0 }
+};
+
+
+/**
+ * Copy a lower cased name from tag text.
+ *
+ * \param text The tag text to copy from.
+ * \param len The length of the tag text.
+ * \param idx The offset of the name, updated to the end of the name.
+ * \param name Buffer to receive the name, set empty if too long.
+ */
+static void
+preload_get_name(const char *text, size_t len, size_t *idx, char *name)
+{
+	size_t start = *idx;
+	size_t i;
+
+	/* an attribute name may begin with an '=' */
+	for (i = start; i < len; i++) {
+		if (ascii_is_space(text[i]) || (text[i] == '/') ||
+		    ((text[i] == '=') && (i != start))) {
+			break;
+		}
+	}
+	*idx = i;
+
+	if ((i - start) >= PRELOAD_NAME_MAX) {
+		name[0] = '\0';
+		return;
+	}
+	for (i = start; i < *idx; i++) {
+		*name++ = ascii_to_lower(text[i]);
+	}
+	*name = '\0';
+}
+
+
+/**
+ * Decode an attribute value.
+ *
+ * Character references for markup characters and ASCII code points
+ *  are decoded, others are left as they are. Surrounding whitespace
+ *  is removed.
+ *
+ * \param src The undecoded value.
+ * \param len The length of the undecoded value.
+ * \param dst Buffer to receive the value, at least len + 1 long.
+ */
+static void preload_decode(const char *src, size_t len, char *dst)
+{
+	const char *end = src + len;
+	char *out = dst;
+	const char *semi;
+	unsigned long cp;
+	char *cpend;
+	size_t e;
+
+	while (src != end) {
+		if ((*src != '&') ||
+		    ((semi = memchr(src, ';', end - src)) == NULL)) {
+			*out++ = *src++;
+			continue;
+		}
+
+		if ((src[1] == '#') && (semi - src > 2)) {
+			if ((src[2] == 'x') || (src[2] == 'X')) {
+				cp = strtoul(src + 3, &cpend, 16);
+			} else {
+				cp = strtoul(src + 2, &cpend, 10);
+			}
+			if ((cpend == semi) && (cp > 0) && (cp < 0x80)) {
+				*out++ = (char)cp;
+				src = semi + 1;
+				continue;
+			}
+		} else {
+			for (e = 0; preload_entities[e].name != NULL; e++) {
+				const char *name = preload_entities[e].name;
+				if (((size_t)(semi - src - 1) == strlen(name)) &&
+				    (strncmp(src + 1, name, semi - src - 1) == 0)) {
+					break;
+				}
+			}
+			if (preload_entities[e].name != NULL) {
+				*out++ = preload_entities[e].c;
+				src = semi + 1;
+				continue;
+			}
+		}
+
+		*out++ = *src++;
+	}
+
+	/* strip surrounding whitespace */
+	while ((out != dst) && ascii_is_space(out[-1])) {
+		out--;
+	}
+	*out = '\0';
+	for (out = dst; ascii_is_space(*out); out++) {
+	}
+	if (out != dst) {
+		memmove(dst, out, strlen(out) + 1);
+	}
+}
+
+
+/**
+ * Get an attribute value from the collected start tag.
+ *
+ * \param preload The scanner.
+ * \param name The lower case attribute name.
+ * \return The decoded value held in the scanner, or NULL if the
+ *         attribute is not present.
+ */
+static const char *
+preload_attribute(struct html_preload *preload, const char *name)
+{
+	const char *text = preload->tag;
+	size_t len = preload->tag_len;
+	char attr[PRELOAD_NAME_MAX];
+	size_t idx = 0;
+	size_t vstart;
+	size_t vend;
+
+	/* skip the tag name */
+	preload_get_name(text, len, &idx, attr);
+
+	while (idx < len) {
+		if (ascii_is_space(text[idx]) || (text[idx] == '/')) {
+			idx++;
+			continue;
+		}
+
+		preload_get_name(text, len, &idx, attr);
+
+		while ((idx < len) && ascii_is_space(text[idx])) {
+			idx++;
+		}
+
+		vstart = vend = idx;
+		if ((idx < len) && (text[idx] == '=')) {
+			idx++;
+			while ((idx < len) && ascii_is_space(text[idx])) {
+				idx++;
+			}
+			if ((idx < len) &&
+			    ((text[idx] == '"') || (text[idx] == '\''))) {
+				char *close;
+				vstart = idx + 1;
+				close = memchr(text + vstart, text[idx],
+					       len - vstart);
+				vend = (close != NULL) ? (size_t)(close - text) : len;
+				idx = vend + 1;
+			} else {
+				vstart = idx;
+				while ((idx < len) && !ascii_is_space(text[idx])) {
+					idx++;
+				}
+				vend = idx;
+			}
+		}
+
+		/* the first occurrence of an attribute is used */
+		if (strcmp(attr, name) == 0) {
+			preload_decode(text + vstart, vend - vstart,
+				       preload->value);
+			return preload->value;
+		}
+	}
+
+	return NULL;
+}
+
+
+/**
+ * Examine a link element for a stylesheet the parser will fetch.
+ *
+ * The checks match those made by html_css_process_link().
+ *
+ * \param preload The scanner.
+ */
+static void preload_link(struct html_preload *preload)
+{
+	const char *value;
+
+	value = preload_attribute(preload, "rel");
+	if ((value == NULL) ||
+	    (strcasestr(value, "stylesheet") == NULL) ||
+	    (strcasestr(value, "alternate") != NULL)) {
+		return;
+	}
+
+	value = preload_attribute(preload, "type");
+	if ((value != NULL) &&
+	    (ascii_strings_equal_caseless(value, "text/css") == false)) {
+		return;
+	}
+
+	value = preload_attribute(preload, "media");
+	if ((value != NULL) &&
+	    (strcasestr(value, "screen") == NULL) &&
+	    (strcasestr(value, "all") == NULL)) {
+		return;
+	}
+
+	value = preload_attribute(preload, "href");
+	if ((value != NULL) && (*value != '\0')) {
+		preload->cb(HTML_PRELOAD_STYLESHEET, value, preload->pw);
+	}
+}
+
+
+/**
+ * Report an attribute holding a reference.
+ *
+ * \param preload The scanner.
+ * \param name The attribute name.
+ * \param type The kind of reference.
+ */
+static void
+preload_report(struct html_preload *preload,
+	       const char *name,
+	       enum html_preload_type type)
+{
+	const char *value;
+
+	value = preload_attribute(preload, name);
+	if ((value != NULL) && (*value != '\0')) {
+		preload->cb(type, value, preload->pw);
+	}
+}
+
+
+/**
+ * Examine the collected tag.
+ *
+ * \param preload The scanner.
+ */
+static void preload_tag(struct html_preload *preload)
+{
+	char name[PRELOAD_NAME_MAX];
+	size_t idx;
+	size_t r;
+
+	preload->tag[preload->tag_len] = '\0';
+
+	if (preload->tag[0] == '/') {
+		/* end tag, only of interest to end raw text */
+		idx = 1;
+		preload_get_name(preload->tag, preload->tag_len, &idx, name);
+		if (strcmp(name, preload->rawtext) == 0) {
+			preload->rawtext[0] = '\0';
+		}
+		return;
+	}
+
+	if (preload->rawtext[0] != '\0') {
+		/* start tags are text within raw text elements */
+		return;
+	}
+
+	idx = 0;
+	preload_get_name(preload->tag, preload->tag_len, &idx, name);
+
+	if (preload->tag_overflow) {
+		/* attributes may be truncated, only the name is usable */
+	} else if (strcmp(name, "link") == 0) {
+		preload_link(preload);
+	} else if (strcmp(name, "script") == 0) {
+		preload_report(preload, "src", HTML_PRELOAD_SCRIPT);
+	} else if (strcmp(name, "img") == 0) {
+		preload_report(preload, "src", HTML_PRELOAD_IMAGE);
+	} else if (strcmp(name, "base") == 0) {
+		preload_report(preload, "href", HTML_PRELOAD_BASE);
+	}
+
+	for (r = 0; preload_rawtext[r] != NULL; r++) {
+		if (strcmp(name, preload_rawtext[r]) == 0) {
+			strcpy(preload->rawtext, name);
+			break;
+		}
+	}
+}
+
+
+/* exported interface documented in html/preload.h */
+nserror
+html_preload_create(html_preload_cb *cb,
+		    void *pw,
+		    struct html_preload **preload_out)
+{
+	struct html_preload *preload;
+
+	preload = malloc(sizeof(*preload));
+	if (preload == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	preload->cb = cb;
+	preload->pw = pw;
+	preload->state = PRELOAD_DATA;
+	preload->rawtext[0] = '\0';
+	preload->tag_len = 0;
+	preload->tag_overflow = false;
+	preload->quote = 0;
+	preload->dashes = 0;
+
+	*preload_out = preload;
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in html/preload.h */
+void html_preload_destroy(struct html_preload *preload)
+{
+	free(preload);
+}
+
+
+/* exported interface documented in html/preload.h */
+void
+html_preload_scan(struct html_preload *preload, const char *data, size_t size)
+{
+	const char *end = data + size;
+	const char *next;
+	char c;
+
+	while (data != end) {
+		switch (preload->state) {
+		case PRELOAD_DATA:
+			next = memchr(data, '<', end - data);
+			if (next == NULL) {
+				return;
+			}
+			data = next + 1;
+			preload->state = PRELOAD_TAG_OPEN;
+			break;
+
+		case PRELOAD_TAG_OPEN:
+			c = *data;
+			preload->tag_len = 0;
+			preload->tag_overflow = false;
+			preload->quote = 0;
+			preload->dashes = 0;
+
+			if (c == '/') {
+				preload->state = PRELOAD_TAG;
+			} else if (preload->rawtext[0] != '\0') {
+				/* only an end tag may close raw text */
+				preload->state = PRELOAD_DATA;
+				break;
+			} else if (ascii_is_alpha(c)) {
+				preload->state = PRELOAD_TAG;
+			} else if (c == '!') {
+				preload->state = PRELOAD_DECL;
+				data++;
+				break;
+			} else if (c == '?') {
+				preload->state = PRELOAD_BOGUS;
+				break;
+			} else {
+				preload->state = PRELOAD_DATA;
+				break;
+			}
+			/* fall through */
+
+		case PRELOAD_TAG:
+			c = *data++;
+			if (preload->quote != 0) {
+				if (c == preload->quote) {
+					preload->quote = 0;
+				}
+			} else if (c == '>') {
+				preload_tag(preload);
+				preload->state = PRELOAD_DATA;
+				break;
+			} else if (((c == '"') || (c == '\'')) &&
+				   (preload->tag_len != 0) &&
+				   (preload->tag[preload->tag_len - 1] == '=')) {
+				/* only quotes opening a value are
+				 * significant, whitespace around the '='
+				 * is not preserved to make this simple.
+				 */
+				preload->quote = c;
+			} else if (ascii_is_space(c) &&
+				   (preload->tag_len != 0) &&
+				   (preload->tag[preload->tag_len - 1] == '=')) {
+				break;
+			} else if (c == '=') {
+				while ((preload->tag_len != 0) &&
+				       ascii_is_space(preload->tag[preload->tag_len - 1])) {
+					preload->tag_len--;
+				}
+			}
+
+			if (preload->tag_len < PRELOAD_TAG_MAX) {
+				preload->tag[preload->tag_len++] = c;
+			} else {
+				preload->tag_overflow = true;
+			}
+			break;
+
+		case PRELOAD_DECL:
+			if (*data != '-') {
+				preload->state = PRELOAD_BOGUS;
+				break;
+			}
+			data++;
+			if (++preload->dashes == 2) {
+				preload->dashes = 0;
+				preload->state = PRELOAD_COMMENT;
+			}
+			break;
+
+		case PRELOAD_COMMENT:
+			c = *data++;
+			if ((c == '>') && (preload->dashes >= 2)) {
+				preload->state = PRELOAD_DATA;
+			} else if (c == '-') {
+				preload->dashes++;
+			} else {
+				preload->dashes = 0;
+			}
+			break;
+
+		case PRELOAD_BOGUS:
+			next = memchr(data, '>', end - data);
+			if (next == NULL) {
+				return;
+			}
+			data = next + 1;
+			preload->state = PRELOAD_DATA;
+			break;
+		}
+	}
+}
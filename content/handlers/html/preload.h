@@ -0,0 +1,91 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * HTML speculative preload scanner interface.
+ *
+ * The scanner is a lightweight tokeniser run over the raw document
+ *  source as it arrives. It finds the resources the document will
+ *  reference without building any tree, so they can be fetched while
+ *  the real parse is blocked on a synchronous script.
+ *
+ * Only ASCII compatible encodings are understood. Comments and the
+ *  content of raw text elements such as script and style are skipped.
+ */
+
+#ifndef NETSURF_HTML_PRELOAD_H
+#define NETSURF_HTML_PRELOAD_H
+
+#include <stddef.h>
+
+#include "utils/errors.h"
+
+struct html_preload;
+
+/** Kind of reference found by the scanner */
+enum html_preload_type {
+	HTML_PRELOAD_BASE, /**< base element href */
+	HTML_PRELOAD_STYLESHEET, /**< linked screen stylesheet */
+	HTML_PRELOAD_SCRIPT, /**< external script */
+	HTML_PRELOAD_IMAGE, /**< img element source */
+};
+
+/**
+ * Reference found by the scanner.
+ *
+ * \param type The kind of reference.
+ * \param url The attribute value, with entities decoded and surrounding
+ *            whitespace removed. It is not joined with any base.
+ * \param pw The client data passed to html_preload_create().
+ */
+typedef void (html_preload_cb)(enum html_preload_type type,
+		const char *url, void *pw);
+
+/**
+ * Create a preload scanner.
+ *
+ * \param cb Callback for references found by the scanner.
+ * \param pw Client data passed to the callback.
+ * \param preload_out Updated to the new scanner on success.
+ * \return NSERROR_OK on success or NSERROR_NOMEM.
+ */
+nserror html_preload_create(html_preload_cb *cb, void *pw,
+		struct html_preload **preload_out);
+
+/**
+ * Destroy a preload scanner.
+ *
+ * \param preload The scanner to destroy.
+ */
+void html_preload_destroy(struct html_preload *preload);
+
+/**
+ * Scan the next chunk of document source.
+ *
+ * Tokeniser state is kept between calls so markup may be split across
+ *  chunks arbitrarily. References are reported as their tags end.
+ *
+ * \param preload The scanner.
+ * \param data The source data.
+ * \param size The length of the source data.
+ */
+void html_preload_scan(struct html_preload *preload,
+		const char *data, size_t size);
+
+#endif
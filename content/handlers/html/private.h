@@ -35,6 +35,10 @@ struct gui_layout_table;
 struct scrollbar_msg_data;
 struct content_redraw_data;
 struct selection;
+struct hashmap_s;
+struct nscss_visited_cache;
+struct html_textsearch_index;
+struct html_preload;
 
 typedef enum {
 	HTML_DRAG_NONE,			/** No drag */
@@ -141,6 +145,10 @@ typedef struct html_content {
 	void *box_conversion_context;
 	/** Box tree, or NULL. */
 	struct box *layout;
+	/** Flattened box tree text for free text search, or NULL. */
+	struct html_textsearch_index *textsearch_index;
+	/** Box tree ids to boxes for fragment navigation, or NULL. */
+	struct hashmap_s *box_ids;
 	/** Document background colour. */
 	colour background_colour;
 
@@ -154,6 +162,17 @@ typedef struct html_content {
 	/** javascript thread in use */
 	struct jsthread *jsthread;
 
+	/** Speculative preload scanner, or NULL if not scanning */
+	struct html_preload *preload;
+	/** URL of the first base element found by the scanner, or NULL */
+	struct nsurl *preload_base;
+	/** Number of entries in preloads */
+	unsigned int preload_count;
+	/** Speculative fetches, held until box conversion has made the
+	 * document's own fetches so those share them. Each may be NULL.
+	 */
+	struct hlcache_handle **preloads;
+
 	/** Number of entries in stylesheet_content. */
 	unsigned int stylesheet_count;
 	/** Stylesheets. Each may be NULL. */
@@ -164,6 +183,10 @@ typedef struct html_content {
 	css_media media;
 	/**< Universal selector */
 	lwc_string *universal;
+	/** Parsed inline style attributes, keyed by interned style text */
+	struct hashmap_s *inline_styles;
+	/** Cache of link visited state for :visited selection */
+	struct nscss_visited_cache *visited;
 
 	/** Number of entries in object_list. */
 	unsigned int num_objects;
@@ -274,6 +297,15 @@ bool html_exec(struct content *c, const char *src, size_t srclen);
 nserror html_script_exec(html_content *htmlc, bool allow_defer);
 
 
+/**
+ * Determine if the parse is blocked on a synchronous script.
+ *
+ * \param htmlc html content.
+ * \return true if a synchronous script has yet to be fetched and run.
+ */
+bool html_script_parse_blocked(html_content *htmlc);
+
+
 /**
  * Free all script resources and references for a html content.
  *
@@ -295,6 +327,34 @@ bool html_saw_insecure_scripts(html_content *htmlc);
 nserror html_proceed_to_done(html_content *html);
 
 
+/**
+ * Timing of a resource fetched for an HTML document
+ */
+struct html_resource_timing {
+	const char *initiator; /**< kind of element the resource is for */
+	struct nsurl *url; /**< address of the resource */
+	size_t size; /**< size of the resource source data */
+	struct content_timing timing; /**< load phase times */
+};
+
+/**
+ * Callback for each resource enumerated by html_enumerate_resource_timing
+ */
+typedef void (html_resource_timing_cb)(const struct html_resource_timing *rt, void *pw);
+
+/**
+ * Enumerate the timing of the resources fetched for a document
+ *
+ * Stylesheets, scripts and objects are reported once each has a
+ *  content. The built in and inline stylesheets are not reported.
+ *
+ * \param htmlc HTML content
+ * \param cb Callback made for each resource
+ * \param pw Context passed to callback
+ */
+void html_enumerate_resource_timing(html_content *htmlc, html_resource_timing_cb *cb, void *pw);
+
+
 /* in html/redraw.c */
 bool html_redraw(struct content *c, struct content_redraw_data *data,
 		const struct rect *clip, const struct redraw_context *ctx);
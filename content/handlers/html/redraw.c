@@ -37,6 +37,7 @@
 #include <dom/dom.h>
 
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/messages.h"
 #include "utils/utils.h"
 #include "utils/nsoption.h"
@@ -1161,6 +1162,45 @@ bool html_redraw_box(const html_content *html, struct box *box,
 		colour current_background_color,
 		const struct redraw_context *ctx);
 
+/**
+ * Find the indexed children of a box which may intersect a clip rectangle.
+ *
+ * \param  index  child index of the box
+ * \param  y0     top of the clip, relative to the box
+ * \param  y1     bottom of the clip, relative to the box
+ * \param  first  updated to the first entry which may intersect
+ * \param  end    updated to one past the last entry which may intersect
+ */
+static void html_redraw_child_index_range(const struct box_child_index *index,
+		int y0, int y1, unsigned int *first, unsigned int *end)
+{
+	unsigned int lo, hi, mid;
+
+	/* first entry whose running bottom reaches the clip top */
+	lo = 0;
+	hi = index->count;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (index->entries[mid].y1 < y0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	*first = lo;
+
+	/* first entry whose top is below the clip bottom */
+	hi = index->count;
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (index->entries[mid].y0 <= y1)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	*end = lo;
+}
+
+
 /**
  * Draw the various children of a box.
  *
@@ -1174,33 +1214,52 @@ bool html_redraw_box(const html_content *html, struct box *box,
  * \param  ctx	     current redraw context
  * \return true if successful, false otherwise
  */
-
 static bool html_redraw_box_children(const html_content *html, struct box *box,
 		int x_parent, int y_parent,
 		const struct rect *clip, float scale,
 		colour current_background_color,
 		const struct redraw_context *ctx)
 {
+	const struct box_child_index *index = box->child_index;
+	int x_offset = x_parent + box->x - scrollbar_get_offset(box->scroll_x);
+	int y_offset = y_parent + box->y - scrollbar_get_offset(box->scroll_y);
 	struct box *c;
 
-	for (c = box->children; c; c = c->next) {
-
-		if (c->type != BOX_FLOAT_LEFT && c->type != BOX_FLOAT_RIGHT)
-			if (!html_redraw_box(html, c,
-					x_parent + box->x -
-					scrollbar_get_offset(box->scroll_x),
-					y_parent + box->y -
-					scrollbar_get_offset(box->scroll_y),
+	if (index != NULL) {
+		/* Only visit the children which may intersect the clip
+		 * rectangle, converted to unscaled box coordinates with
+		 * slack for rounding of the scaled child coordinates.
+		 */
+		int slack = 2 + (int)(2 / scale);
+		int y0 = (int)(clip->y0 / scale) - y_offset - slack;
+		int y1 = (int)(clip->y1 / scale) - y_offset + slack;
+		unsigned int first, end, i;
+
+		html_redraw_child_index_range(index, y0, y1, &first, &end);
+
+		for (i = first; i < end; i++) {
+			if (!html_redraw_box(html, index->entries[i].box,
+					x_offset, y_offset,
 					clip, scale, current_background_color,
 					ctx))
 				return false;
+		}
+	} else {
+		for (c = box->children; c; c = c->next) {
+
+			if (c->type != BOX_FLOAT_LEFT &&
+					c->type != BOX_FLOAT_RIGHT)
+				if (!html_redraw_box(html, c,
+						x_offset, y_offset,
+						clip, scale,
+						current_background_color,
+						ctx))
+					return false;
+		}
 	}
 	for (c = box->float_children; c; c = c->next_float)
 		if (!html_redraw_box(html, c,
-				x_parent + box->x -
-				scrollbar_get_offset(box->scroll_x),
-				y_parent + box->y -
-				scrollbar_get_offset(box->scroll_y),
+				x_offset, y_offset,
 				clip, scale, current_background_color,
 				ctx))
 			return false;
@@ -1956,6 +2015,8 @@ bool html_redraw(struct content *c, struct content_redraw_data *data,
 	box = html->layout;
 	assert(box);
 
+	NSTRACE_BEGIN("redraw", "html_redraw");
+
 	/* The select menu needs special treating because, when opened, it
 	 * reaches beyond its layout box.
 	 */
@@ -1996,6 +2057,8 @@ bool html_redraw(struct content *c, struct content_redraw_data *data,
 				data->scale, clip, ctx);
 	}
 
+	NSTRACE_END("redraw", "html_redraw");
+
 	return result;
 
 }
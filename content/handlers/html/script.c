@@ -33,6 +33,7 @@
 #include "utils/corestrings.h"
 #include "utils/log.h"
 #include "utils/messages.h"
+#include "utils/worker.h"
 #include "netsurf/content.h"
 #include "javascript/js.h"
 #include "content/content_protected.h"
@@ -45,6 +46,16 @@
 
 typedef bool (script_handler_t)(struct jsthread *jsthread, const uint8_t *data, size_t size, const char *name);
 
+/**
+ * Compilation of a fetched script on a worker thread
+ */
+struct html_script_precompile {
+	html_content *parent; /**< content the script belongs to */
+	hlcache_handle *handle; /**< the fetched script */
+	hlcache_handle_callback cb; /**< callback to deliver done to */
+	jsprecompile *job; /**< the compilation */
+};
+
 
 static script_handler_t *select_script_handler(content_type ctype)
 {
@@ -78,6 +89,12 @@ nserror html_script_exec(html_content *c, bool allow_defer)
 			if (s->data.handle == NULL)
 				continue;
 
+			/* the done event is still queued on the workers
+			 * and the script runs when it is delivered
+			 */
+			if (s->precompile != NULL)
+				continue;
+
 			/* ensure script content fetch status is not an error */
 			if (content_get_status(s->data.handle) ==
 					CONTENT_STATUS_ERROR)
@@ -138,6 +155,8 @@ html_process_new_script(html_content *c,
 	nscript = &c->scripts[c->scripts_count];
 	c->scripts_count++;
 
+	nscript->precompile = NULL;
+	nscript->precompiled = false;
 	nscript->already_started = false;
 	nscript->parser_inserted = false;
 	nscript->force_async = true;
@@ -152,6 +171,152 @@ html_process_new_script(html_content *c,
 	return nscript;
 }
 
+/**
+ * Compile a script on a worker thread
+ *
+ * \param pw The script compilation
+ */
+static void html_script_precompile_run(void *pw)
+{
+	struct html_script_precompile *pc = pw;
+
+	if (pc->job != NULL) {
+		js_precompile_run(pc->job);
+	}
+}
+
+/**
+ * Deliver the done event of a script once it has been compiled
+ *
+ * \param pw The script compilation
+ * \param cancelled true if the script's content has gone away
+ */
+static void html_script_precompile_done(void *pw, bool cancelled)
+{
+	struct html_script_precompile *pc = pw;
+	html_content *parent = pc->parent;
+	hlcache_event event;
+	unsigned int i;
+
+	if (pc->job != NULL) {
+		js_precompile_finish(pc->job, !cancelled);
+	}
+
+	if (cancelled == false) {
+		for (i = 0; i != parent->scripts_count; i++) {
+			if (parent->scripts[i].precompile == pc) {
+				parent->scripts[i].precompile = NULL;
+				break;
+			}
+		}
+
+		event.type = CONTENT_MSG_DONE;
+		pc->cb(pc->handle, &event, parent);
+	}
+
+	free(pc);
+}
+
+/**
+ * Determine if any script of a content is queued on the workers
+ *
+ * \param c The html content to check.
+ * \return true if a script's done event is yet to be delivered.
+ */
+static bool html_script_precompiling(html_content *c)
+{
+	unsigned int i;
+
+	for (i = 0; i != c->scripts_count; i++) {
+		if (c->scripts[i].precompile != NULL) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Start compiling a fetched script on a worker thread
+ *
+ * The script's done event is delivered again to its callback once
+ *  the compilation is complete. Scripts are only compiled in advance
+ *  once.
+ *
+ * While another script of the content is queued, a script with
+ *  nothing to compile is queued too. The workers deliver completions
+ *  in submission order so the done events, and so script execution,
+ *  keep the order the fetches completed in.
+ *
+ * \param c The html content the script belongs to.
+ * \param s The script whose fetch is done.
+ * \param cb The callback to deliver the done event to.
+ * \return true if the script is being compiled else false.
+ */
+static bool
+html_script_precompile(html_content *c,
+		       struct html_script *s,
+		       hlcache_handle_callback cb)
+{
+	struct html_script_precompile *pc;
+	jsprecompile *job = NULL;
+	const uint8_t *data;
+	size_t size;
+	nserror res;
+
+	if (s->precompiled || (worker_available() == false)) {
+		return false;
+	}
+	s->precompiled = true;
+
+	if ((c->jsthread != NULL) &&
+	    (select_script_handler(content_get_type(s->data.handle)) != NULL)) {
+		data = content_get_source_data(s->data.handle, &size);
+		res = js_precompile_create(data, size,
+				nsurl_access(hlcache_handle_get_url(s->data.handle)),
+				&job);
+		if (res != NSERROR_OK) {
+			job = NULL;
+		}
+	}
+
+	if ((job == NULL) && (html_script_precompiling(c) == false)) {
+		/* nothing to compile or to wait for */
+		return false;
+	}
+
+	pc = malloc(sizeof(*pc));
+	if (pc == NULL) {
+		if (job != NULL) {
+			js_precompile_finish(job, false);
+		}
+		return false;
+	}
+	pc->parent = c;
+	pc->handle = s->data.handle;
+	pc->cb = cb;
+	pc->job = job;
+
+	res = worker_submit(html_script_precompile_run,
+			    html_script_precompile_done,
+			    pc);
+	if (res != NSERROR_OK) {
+		if (job != NULL) {
+			js_precompile_finish(job, false);
+		}
+		free(pc);
+		return false;
+	}
+
+	s->precompile = pc;
+
+	NSLOG(netsurf, INFO, "%s script '%s'",
+	      (job != NULL) ? "compiling" : "queueing",
+	      nsurl_access(hlcache_handle_get_url(s->data.handle)));
+
+	return true;
+}
+
 /**
  * Callback for asyncronous scripts
  */
@@ -180,6 +345,11 @@ convert_script_async_cb(hlcache_handle *script,
 		break;
 
 	case CONTENT_MSG_DONE:
+		if (html_script_precompile(parent, s, convert_script_async_cb)) {
+			/* done is delivered again once compiled */
+			return NSERROR_OK;
+		}
+
 		NSLOG(netsurf, INFO, "script %d done '%s'", i,
 		      nsurl_access(hlcache_handle_get_url(script)));
 		parent->base.active--;
@@ -243,6 +413,11 @@ convert_script_defer_cb(hlcache_handle *script,
 	switch (event->type) {
 
 	case CONTENT_MSG_DONE:
+		if (html_script_precompile(parent, s, convert_script_defer_cb)) {
+			/* done is delivered again once compiled */
+			return NSERROR_OK;
+		}
+
 		NSLOG(netsurf, INFO, "script %d done '%s'", i,
 		      nsurl_access(hlcache_handle_get_url(script)));
 		parent->base.active--;
@@ -309,6 +484,11 @@ convert_script_sync_cb(hlcache_handle *script,
 
 	switch (event->type) {
 	case CONTENT_MSG_DONE:
+		if (html_script_precompile(parent, s, convert_script_sync_cb)) {
+			/* done is delivered again once compiled */
+			return NSERROR_OK;
+		}
+
 		NSLOG(netsurf, INFO, "script %d done '%s'", i,
 		      nsurl_access(hlcache_handle_get_url(script)));
 		parent->base.active--;
@@ -606,6 +786,21 @@ html_process_script(void *ctx, dom_node *node)
 	return err;
 }
 
+/* exported internal interface documented in html/private.h */
+bool html_script_parse_blocked(html_content *htmlc)
+{
+	struct html_script *s;
+	unsigned int i;
+
+	for (i = 0, s = htmlc->scripts; i != htmlc->scripts_count; i++, s++) {
+		if (s->type == HTML_SCRIPT_SYNC && s->already_started == false) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /* exported internal interface documented in html/html_internal.h */
 bool html_saw_insecure_scripts(html_content *htmlc)
 {
@@ -652,6 +847,9 @@ nserror html_script_free(html_content *html)
 		case HTML_SCRIPT_ASYNC:
 			/* fallthrough */
 		case HTML_SCRIPT_DEFER:
+			if (html->scripts[i].precompile != NULL) {
+				worker_cancel(html->scripts[i].precompile);
+			}
 			if (html->scripts[i].data.handle != NULL) {
 				hlcache_handle_release(html->scripts[i].data.handle);
 			}
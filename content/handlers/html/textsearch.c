@@ -0,0 +1,570 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * implementation of free text search for a HTML content.
+ *
+ * The text of every box is copied into a single flattened buffer in
+ *  the same order and at the same offsets used by the text selection
+ *  code, so a match offset within the buffer is directly usable as a
+ *  selection index. Matches may span several boxes provided they all
+ *  belong to the same run of inline content.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "utils/config.h"
+#include "utils/errors.h"
+#include "utils/log.h"
+#include "utils/utils.h"
+#include "netsurf/types.h"
+
+#include "content/textsearch.h"
+
+#include "html/private.h"
+#include "html/box.h"
+#include "html/box_inspect.h"
+#include "html/textsearch.h"
+
+#define SPACE_LEN(b) ((b->space == 0) ? 0 : 1)
+
+/**
+ * A text box within the index
+ */
+struct html_textsearch_segment {
+	unsigned start; /**< offset of the box text within the index */
+	unsigned block; /**< run of inline content the box belongs to */
+	struct box *box; /**< the text box */
+};
+
+/**
+ * Flattened text of a HTML content
+ */
+struct html_textsearch_index {
+	char *text; /**< text of all boxes, not NUL terminated */
+	char *folded; /**< upper cased text, built on first caseless use */
+	unsigned length; /**< length of text */
+	unsigned alloc; /**< allocated size of text */
+
+	struct html_textsearch_segment *segs; /**< boxes by offset */
+	unsigned seg_count; /**< number of entries in segs */
+	unsigned seg_alloc; /**< allocated entries in segs */
+
+	unsigned block; /**< current block number while building */
+
+	/**
+	 * Previous literal query, case folded when it was caseless.
+	 *
+	 * Every occurrence of an extension of this query must begin at
+	 *  one of the recorded occurrences.
+	 */
+	char *query;
+	unsigned query_len; /**< length of query */
+	bool query_case_sens; /**< whether query was case sensitive */
+
+	unsigned *occ; /**< offsets of all occurrences of query */
+	unsigned occ_count; /**< number of entries in occ */
+	unsigned occ_alloc; /**< allocated entries in occ */
+};
+
+
+/**
+ * Append a box's text to the index.
+ */
+static nserror
+index_add_text(struct html_textsearch_index *idx, struct box *box)
+{
+	unsigned length = box->length + SPACE_LEN(box);
+	struct html_textsearch_segment *seg;
+
+	if (length == 0) {
+		return NSERROR_OK;
+	}
+
+	if (idx->length + length > idx->alloc) {
+		unsigned alloc = idx->alloc ? idx->alloc : 4096;
+		char *text;
+
+		while (alloc < idx->length + length) {
+			alloc *= 2;
+		}
+		text = realloc(idx->text, alloc);
+		if (text == NULL) {
+			return NSERROR_NOMEM;
+		}
+		idx->text = text;
+		idx->alloc = alloc;
+	}
+
+	if (idx->seg_count == idx->seg_alloc) {
+		unsigned alloc = idx->seg_alloc ? idx->seg_alloc * 2 : 256;
+
+		seg = realloc(idx->segs, alloc * sizeof(*seg));
+		if (seg == NULL) {
+			return NSERROR_NOMEM;
+		}
+		idx->segs = seg;
+		idx->seg_alloc = alloc;
+	}
+
+	seg = &idx->segs[idx->seg_count++];
+	seg->start = idx->length;
+	seg->block = idx->block;
+	seg->box = box;
+
+	if (box->object != NULL) {
+		/* replaced content has no visible text; a NUL can never
+		 *  be part of a match */
+		memset(idx->text + idx->length, 0, box->length);
+	} else {
+		memcpy(idx->text + idx->length, box->text, box->length);
+	}
+	if (box->space != 0) {
+		idx->text[idx->length + box->length] = ' ';
+	}
+	idx->length += length;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Add a box subtree to the index.
+ *
+ * The traversal order matches the labelling of box byte offsets used
+ *  by text selection.
+ */
+static nserror
+index_add_subtree(struct html_textsearch_index *idx, struct box *box)
+{
+	struct box *child;
+	bool inline_box;
+	nserror res;
+
+	inline_box = (box->type == BOX_INLINE ||
+		      box->type == BOX_INLINE_END ||
+		      box->type == BOX_TEXT);
+
+	/* matches may not run into or out of anything other than
+	 *  inline content */
+	if (!inline_box) {
+		idx->block++;
+	}
+
+	if (box->text) {
+		res = index_add_text(idx, box);
+		if (res != NSERROR_OK) {
+			return res;
+		}
+	}
+
+	for (child = box->children; child != NULL; child = child->next) {
+		if (child->list_marker) {
+			res = index_add_subtree(idx, child->list_marker);
+			if (res != NSERROR_OK) {
+				return res;
+			}
+		}
+
+		res = index_add_subtree(idx, child);
+		if (res != NSERROR_OK) {
+			return res;
+		}
+	}
+
+	if (!inline_box) {
+		idx->block++;
+	}
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Free a text search index.
+ */
+static void index_free(struct html_textsearch_index *idx)
+{
+	free(idx->text);
+	free(idx->folded);
+	free(idx->segs);
+	free(idx->query);
+	free(idx->occ);
+	free(idx);
+}
+
+
+/**
+ * Get the text search index of a content, building it if required.
+ */
+static nserror
+index_get(html_content *html, struct html_textsearch_index **idx_out)
+{
+	struct html_textsearch_index *idx;
+	nserror res;
+
+	if (html->textsearch_index != NULL) {
+		*idx_out = html->textsearch_index;
+		return NSERROR_OK;
+	}
+
+	idx = calloc(1, sizeof(*idx));
+	if (idx == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	res = index_add_subtree(idx, html->layout);
+	if (res != NSERROR_OK) {
+		index_free(idx);
+		return res;
+	}
+
+	NSLOG(netsurf, DEBUG, "indexed %u bytes of text in %u boxes",
+	      idx->length, idx->seg_count);
+
+	html->textsearch_index = idx;
+	*idx_out = idx;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Get the case folded copy of the index text.
+ */
+static const char *index_folded(struct html_textsearch_index *idx)
+{
+	unsigned i;
+
+	if (idx->folded == NULL && idx->length > 0) {
+		idx->folded = malloc(idx->length);
+		if (idx->folded != NULL) {
+			for (i = 0; i < idx->length; i++) {
+				idx->folded[i] = toupper((unsigned char)idx->text[i]);
+			}
+		}
+	}
+
+	return idx->folded;
+}
+
+
+/**
+ * Find the segment containing an offset within the index text.
+ */
+static struct html_textsearch_segment *
+index_segment(struct html_textsearch_index *idx, unsigned offset)
+{
+	unsigned lo = 0;
+	unsigned hi = idx->seg_count;
+
+	/* find the last segment starting at or before offset */
+	while (hi - lo > 1) {
+		unsigned mid = lo + (hi - lo) / 2;
+
+		if (idx->segs[mid].start <= offset) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return &idx->segs[lo];
+}
+
+
+/**
+ * Record an occurrence of the current query.
+ */
+static nserror index_add_occurrence(struct html_textsearch_index *idx, unsigned offset)
+{
+	if (idx->occ_count == idx->occ_alloc) {
+		unsigned alloc = idx->occ_alloc ? idx->occ_alloc * 2 : 64;
+		unsigned *occ;
+
+		occ = realloc(idx->occ, alloc * sizeof(*occ));
+		if (occ == NULL) {
+			return NSERROR_NOMEM;
+		}
+		idx->occ = occ;
+		idx->occ_alloc = alloc;
+	}
+
+	idx->occ[idx->occ_count++] = offset;
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Add a match to the search context if it lies within a single run
+ *  of inline content.
+ *
+ * \return NSERROR_OK if the match was added, NSERROR_NOT_FOUND if it
+ *          spans blocks, else error code
+ */
+static nserror
+index_add_match(struct html_textsearch_index *idx,
+		struct textsearch_context *context,
+		unsigned start,
+		unsigned end)
+{
+	struct html_textsearch_segment *start_seg;
+	struct html_textsearch_segment *end_seg;
+
+	start_seg = index_segment(idx, start);
+	end_seg = index_segment(idx, end - 1);
+	if (start_seg->block != end_seg->block) {
+		return NSERROR_NOT_FOUND;
+	}
+
+	return content_textsearch_add_match(context,
+					    start,
+					    end,
+					    start_seg->box,
+					    end_seg->box);
+}
+
+
+/**
+ * Find all occurrences of a literal pattern.
+ *
+ * When the pattern extends the previous query only the occurrences of
+ *  that query are checked, otherwise the whole text is scanned.
+ */
+static nserror
+index_find_literal(struct html_textsearch_index *idx,
+		   struct textsearch_context *context,
+		   const char *pattern,
+		   unsigned p_len,
+		   bool case_sens)
+{
+	const char *text = idx->text;
+	char *query;
+	unsigned last_end = 0;
+	unsigned i;
+	nserror res;
+
+	query = malloc(p_len);
+	if (query == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	if (case_sens) {
+		memcpy(query, pattern, p_len);
+	} else {
+		text = index_folded(idx);
+		if (text == NULL) {
+			free(query);
+			return NSERROR_NOMEM;
+		}
+		for (i = 0; i < p_len; i++) {
+			query[i] = toupper((unsigned char)pattern[i]);
+		}
+	}
+
+	if (idx->query != NULL &&
+	    idx->query_case_sens == case_sens &&
+	    idx->query_len <= p_len &&
+	    memcmp(idx->query, query, idx->query_len) == 0) {
+		/* incremental search; filter previous occurrences */
+		unsigned count = 0;
+
+		for (i = 0; i < idx->occ_count; i++) {
+			unsigned offset = idx->occ[i];
+
+			if ((offset + p_len <= idx->length) &&
+			    (memcmp(text + offset, query, p_len) == 0)) {
+				idx->occ[count++] = offset;
+			}
+		}
+		idx->occ_count = count;
+	} else {
+		/* full scan, recording overlapping occurrences */
+		const char *pos = text;
+		const char *end = text + idx->length;
+
+		idx->occ_count = 0;
+		while ((pos = memmem(pos, end - pos, query, p_len)) != NULL) {
+			res = index_add_occurrence(idx, pos - text);
+			if (res != NSERROR_OK) {
+				free(query);
+				free(idx->query);
+				idx->query = NULL;
+				return res;
+			}
+			pos++;
+		}
+	}
+
+	free(idx->query);
+	idx->query = query;
+	idx->query_len = p_len;
+	idx->query_case_sens = case_sens;
+
+	/* report non overlapping matches */
+	for (i = 0; i < idx->occ_count; i++) {
+		unsigned offset = idx->occ[i];
+
+		if (offset < last_end) {
+			continue;
+		}
+
+		res = index_add_match(idx, context, offset, offset + p_len);
+		if (res == NSERROR_OK) {
+			last_end = offset + p_len;
+		} else if (res != NSERROR_NOT_FOUND) {
+			return res;
+		}
+	}
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Find all occurrences of a pattern containing wildcards.
+ *
+ * Each run of inline content is matched separately so a wildcard can
+ *  never extend a match across a block.
+ */
+static nserror
+index_find_pattern(struct html_textsearch_index *idx,
+		   struct textsearch_context *context,
+		   const char *pattern,
+		   int p_len,
+		   bool case_sens)
+{
+	unsigned seg = 0;
+	nserror res;
+
+	/* wildcard results cannot seed an incremental search */
+	free(idx->query);
+	idx->query = NULL;
+	idx->occ_count = 0;
+
+	while (seg < idx->seg_count) {
+		unsigned block = idx->segs[seg].block;
+		unsigned start = idx->segs[seg].start;
+		unsigned end;
+		const char *text;
+
+		while (seg < idx->seg_count && idx->segs[seg].block == block) {
+			seg++;
+		}
+		end = (seg < idx->seg_count) ? idx->segs[seg].start :
+				idx->length;
+
+		text = idx->text + start;
+		while (text < idx->text + end) {
+			unsigned match_length;
+			const char *pos;
+
+			pos = content_textsearch_find_pattern(text,
+					(idx->text + end) - text,
+					pattern,
+					p_len,
+					case_sens,
+					&match_length);
+			if (pos == NULL) {
+				break;
+			}
+
+			res = index_add_match(idx,
+					      context,
+					      pos - idx->text,
+					      pos - idx->text + match_length);
+			if (res != NSERROR_OK && res != NSERROR_NOT_FOUND) {
+				return res;
+			}
+
+			text = pos + match_length;
+		}
+	}
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in html/textsearch.h */
+nserror
+html_textsearch_find(struct content *c,
+		     struct textsearch_context *context,
+		     const char *pattern,
+		     int p_len,
+		     bool csens)
+{
+	html_content *html = (html_content *)c;
+	struct html_textsearch_index *idx;
+	nserror res;
+
+	if (html->layout == NULL) {
+		return NSERROR_INVALID;
+	}
+
+	res = index_get(html, &idx);
+	if (res != NSERROR_OK) {
+		return res;
+	}
+
+	if (idx->length == 0) {
+		/* no text, no matches */
+		return NSERROR_OK;
+	}
+
+	if ((memchr(pattern, '*', p_len) != NULL) ||
+	    (memchr(pattern, '#', p_len) != NULL)) {
+		return index_find_pattern(idx, context, pattern, p_len, csens);
+	}
+
+	return index_find_literal(idx, context, pattern, p_len, csens);
+}
+
+
+/* exported interface documented in html/textsearch.h */
+nserror
+html_textsearch_bounds(struct content *c,
+		       unsigned start_idx,
+		       unsigned end_idx,
+		       struct box *start_box,
+		       struct box *end_box,
+		       struct rect *bounds)
+{
+	/* get box position and jump to it */
+	box_coords(start_box, &bounds->x0, &bounds->y0);
+	/* \todo: move x0 in by correct idx */
+	box_coords(end_box, &bounds->x1, &bounds->y1);
+	/* \todo: move x1 in by correct idx */
+	bounds->x1 += end_box->width;
+	bounds->y1 += end_box->height;
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in html/textsearch.h */
+void html_textsearch_invalidate(struct html_content *htmlc)
+{
+	if (htmlc->textsearch_index != NULL) {
+		index_free(htmlc->textsearch_index);
+		htmlc->textsearch_index = NULL;
+	}
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * HTML free text search handling
+ */
+
+#ifndef NETSURF_HTML_TEXTSEARCH_H
+#define NETSURF_HTML_TEXTSEARCH_H
+
+struct content;
+struct box;
+struct rect;
+struct textsearch_context;
+struct html_content;
+
+/**
+ * Find all occurrences of a pattern in a HTML content.
+ *
+ * The text of the box tree is searched through a flattened index
+ *  which is built on first use and kept until the layout changes.
+ *
+ * \param c The content to search
+ * \param context The search context to add matches to.
+ * \param pattern The pattern to search for
+ * \param p_len The pattern length
+ * \param csens whether to perform a case sensitive search
+ * \return NSERROR_OK on success else error code
+ */
+nserror html_textsearch_find(struct content *c,
+		struct textsearch_context *context, const char *pattern,
+		int p_len, bool csens);
+
+/**
+ * Get the area of a HTML content covered by a search match.
+ *
+ * \param c The content the match was found in
+ * \param start_idx The byte offset of the match start within start_box
+ * \param end_idx The byte offset of the match end within end_box
+ * \param start_box The box containing the start of the match
+ * \param end_box The box containing the end of the match
+ * \param bounds Updated to the area covered by the match
+ * \return NSERROR_OK on success else error code
+ */
+nserror html_textsearch_bounds(struct content *c, unsigned start_idx,
+		unsigned end_idx, struct box *start_box, struct box *end_box,
+		struct rect *bounds);
+
+/**
+ * Discard the text search index of a HTML content.
+ *
+ * Must be called whenever the box tree text or its splitting into
+ *  boxes changes.
+ *
+ * \param htmlc The content to discard the index of.
+ */
+void html_textsearch_invalidate(struct html_content *htmlc);
+
+#endif
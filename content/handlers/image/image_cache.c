@@ -30,6 +30,7 @@
 #include "netsurf/inttypes.h"
 #include "utils/utils.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "netsurf/misc.h"
 #include "netsurf/bitmap.h"
 #include "content/llcache.h"
@@ -354,7 +355,9 @@ struct bitmap *image_cache_get_bitmap(const struct content *c)
 
 	if (centry->bitmap == NULL) {
 		if (centry->convert != NULL) {
+			NSTRACE_BEGIN("image", "image_decode");
 			centry->bitmap = centry->convert(centry->content);
+			NSTRACE_END("image", "image_decode");
 		}
 
 		if (centry->bitmap != NULL) {
@@ -548,7 +551,9 @@ nserror image_cache_add(struct content *content,
 		/* no bitmap, check to see if we should speculatively convert */
 		if ((centry->convert != NULL) &&
 		    (image_cache_speculate(content) == true)) {
+			NSTRACE_BEGIN("image", "image_decode");
 			centry->bitmap = centry->convert(centry->content);
+			NSTRACE_END("image", "image_decode");
 
 			if (centry->bitmap != NULL) {
 				image_cache_stats_bitmap_add(centry);
@@ -812,7 +817,9 @@ bool image_cache_redraw(struct content *c,
 
 	if (centry->bitmap == NULL) {
 		if (centry->convert != NULL) {
+			NSTRACE_BEGIN("image", "image_decode");
 			centry->bitmap = centry->convert(centry->content);
+			NSTRACE_END("image", "image_decode");
 		}
 
 		if (centry->bitmap != NULL) {
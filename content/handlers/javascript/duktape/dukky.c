@@ -25,13 +25,17 @@
  */
 
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include <nsutils/time.h>
 
 #include "netsurf/inttypes.h"
 #include "utils/utils.h"
 #include "utils/nsoption.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/corestrings.h"
+#include "utils/hashmap.h"
 #include "content/content.h"
 
 #include "javascript/js.h"
@@ -52,6 +56,19 @@
 #define EVENT_LISTENER_JS_MAGIC MAGIC(EVENT_LISTENER_JS_MAP)
 #define GENERICS_MAGIC MAGIC(GENERICS_TABLE)
 #define THREAD_MAP MAGIC(THREAD_MAP)
+#define NODE_MAP_MAGIC MAGIC(NODE_MAP)
+
+/**
+ * Smallest script source, in bytes, whose compiled bytecode is cached.
+ *
+ * Below this size recompiling costs less than comparing and copying.
+ */
+#define BYTECODE_CACHE_MIN_SOURCE 1024
+
+/**
+ * Total bytecode and source size above which the bytecode cache is flushed.
+ */
+#define BYTECODE_CACHE_LIMIT (8 * 1024 * 1024)
 
 /**
  * dukky javascript heap
@@ -73,6 +90,70 @@ struct jsthread {
 	jsheap *heap; /**< The heap this thread belongs to */
 	duk_context *ctx; /**< The duktape thread context */
 	duk_uarridx_t thread_idx; /**< The thread number */
+	hashmap_t *nodes; /**< dom_node to wrapper heap pointer map */
+};
+
+/**
+ * Compiled bytecode for an external script
+ *
+ * The source the bytecode was built from is kept so a later script
+ *  with the same URL only uses the bytecode if its source is identical.
+ */
+struct dukky_bytecode {
+	uint8_t *src; /**< source the bytecode was built from */
+	size_t srclen; /**< length of the source */
+	uint8_t *data; /**< dumped function bytecode */
+	size_t datalen; /**< length of the dumped bytecode */
+};
+
+/** Compiled script bytecode keyed by script URL */
+static hashmap_t *dukky_bytecode_cache = NULL;
+
+/** Total size of the bytecode and source held in the cache */
+static size_t dukky_bytecode_size = 0;
+
+static void *dukky_node_map_key_clone(void *key)
+{
+	return key;
+}
+
+static void dukky_node_map_key_destroy(void *key)
+{
+}
+
+static uint32_t dukky_node_map_key_hash(void *key)
+{
+	uintptr_t ptr = (uintptr_t)key;
+
+	return (uint32_t)(ptr >> 4) ^ (uint32_t)((uint64_t)ptr >> 32);
+}
+
+static bool dukky_node_map_key_eq(void *key1, void *key2)
+{
+	return key1 == key2;
+}
+
+static void *dukky_node_map_value_alloc(void *key)
+{
+	return calloc(1, sizeof(void *));
+}
+
+static void dukky_node_map_value_destroy(void *value)
+{
+	free(value);
+}
+
+/**
+ * Parameters of the per thread map from dom_node pointers to the heap
+ * pointers of their wrapper objects.
+ */
+static hashmap_parameters_t dukky_node_map_params = {
+	.key_clone = dukky_node_map_key_clone,
+	.key_destroy = dukky_node_map_key_destroy,
+	.key_hash = dukky_node_map_key_hash,
+	.key_eq = dukky_node_map_key_eq,
+	.value_alloc = dukky_node_map_value_alloc,
+	.value_destroy = dukky_node_map_value_destroy,
 };
 
 static duk_ret_t dukky_populate_object(duk_context *ctx, void *udata)
@@ -143,55 +224,129 @@ duk_ret_t dukky_create_object(duk_context *ctx, const char *name, int args)
 
 
 
+/**
+ * Find the node wrapper map of a context
+ *
+ * \param ctx duktape context
+ * \return The map from dom_node pointers to wrapper heap pointers or NULL
+ */
+static hashmap_t *dukky_node_map(duk_context *ctx)
+{
+	hashmap_t *map;
+
+	duk_get_global_string(ctx, NODE_MAP_MAGIC);
+	map = duk_get_pointer(ctx, -1);
+	duk_pop(ctx);
+
+	return map;
+}
+
+/**
+ * Push the memoised wrapper object of a node if there is one
+ *
+ * \param ctx duktape context
+ * \param node The node to find the wrapper of
+ * \return true and the wrapper on the stack if found else false
+ */
+static bool dukky_push_memoised_node(duk_context *ctx, struct dom_node *node)
+{
+	hashmap_t *map;
+	void **wrapper;
+
+	if (node == NULL) {
+		/* the NULL node is always represented by null */
+		duk_push_null(ctx);
+		return true;
+	}
+
+	map = dukky_node_map(ctx);
+	if (map == NULL) {
+		return false;
+	}
+
+	wrapper = hashmap_lookup(map, node);
+	if (wrapper == NULL) {
+		return false;
+	}
+
+	duk_push_heapptr(ctx, *wrapper);
+	return true;
+}
+
+/**
+ * Memoise the wrapper object on the stack top for a node
+ *
+ * The wrapper is anchored in the NODE_MAGIC array so the garbage
+ * collector cannot reclaim it while the heap pointer is in the map.
+ *
+ * \param ctx duktape context
+ * \param node The node the wrapper belongs to
+ */
+static void dukky_memoise_node(duk_context *ctx, struct dom_node *node)
+{
+	hashmap_t *map;
+	void **wrapper;
+
+	map = dukky_node_map(ctx);
+	if (map == NULL) {
+		return;
+	}
+
+	wrapper = hashmap_insert(map, node);
+	if (wrapper == NULL) {
+		NSLOG(dukky, ERROR, "Unable to memoise wrapper for %p", node);
+		return;
+	}
+
+	/* ... node */
+	duk_get_global_string(ctx, NODE_MAGIC);
+	/* ... node nodes */
+	duk_dup(ctx, -2);
+	/* ... node nodes node */
+	duk_put_prop_index(ctx, -2, (duk_uarridx_t)duk_get_length(ctx, -2));
+	/* ... node nodes */
+	duk_pop(ctx);
+	/* ... node */
+	*wrapper = duk_get_heapptr(ctx, -1);
+}
+
 duk_bool_t
 dukky_push_node_stacked(duk_context *ctx)
 {
 	int top_at_fail = duk_get_top(ctx) - 2;
+	struct dom_node *node = duk_get_pointer(ctx, -2);
 	/* ... nodeptr klass */
-	duk_get_global_string(ctx, NODE_MAGIC);
-	/* ... nodeptr klass nodes */
-	duk_dup(ctx, -3);
-	/* ... nodeptr klass nodes nodeptr */
-	duk_get_prop(ctx, -2);
-	/* ... nodeptr klass nodes node/undefined */
-	if (duk_is_undefined(ctx, -1)) {
-		/* ... nodeptr klass nodes undefined */
-		duk_pop(ctx);
-		/* ... nodeptr klass nodes */
+	if (dukky_push_memoised_node(ctx, node) == false) {
+		/* ... nodeptr klass */
 		duk_push_object(ctx);
-		/* ... nodeptr klass nodes obj */
+		/* ... nodeptr klass obj */
 		duk_push_object(ctx);
-		/* ... nodeptr klass nodes obj handlers */
+		/* ... nodeptr klass obj handlers */
 		duk_put_prop_string(ctx, -2, HANDLER_LISTENER_MAGIC);
-		/* ... nodeptr klass nodes obj */
+		/* ... nodeptr klass obj */
 		duk_push_object(ctx);
-		/* ... nodeptr klass nodes obj handlers */
+		/* ... nodeptr klass obj handlers */
 		duk_put_prop_string(ctx, -2, HANDLER_MAGIC);
-		/* ... nodeptr klass nodes obj */
-		duk_dup(ctx, -4);
-		/* ... nodeptr klass nodes obj nodeptr */
-		duk_dup(ctx, -4);
-		/* ... nodeptr klass nodes obj nodeptr klass */
+		/* ... nodeptr klass obj */
+		duk_dup(ctx, -3);
+		/* ... nodeptr klass obj nodeptr */
+		duk_dup(ctx, -3);
+		/* ... nodeptr klass obj nodeptr klass */
 		duk_push_int(ctx, 1);
-		/* ... nodeptr klass nodes obj nodeptr klass 1 */
+		/* ... nodeptr klass obj nodeptr klass 1 */
 		if (duk_safe_call(ctx, dukky_populate_object, NULL, 4, 1)
 		    != DUK_EXEC_SUCCESS) {
 			duk_set_top(ctx, top_at_fail);
 			NSLOG(dukky, ERROR, "Failed to populate object prototype");
 			return false;
 		}
-		/* ... nodeptr klass nodes node */
-		duk_dup(ctx, -4);
-		/* ... nodeptr klass nodes node nodeptr */
-		duk_dup(ctx, -2);
-		/* ... nodeptr klass nodes node nodeptr node */
-		duk_put_prop(ctx, -4);
-		/* ... nodeptr klass nodes node */
+		/* ... nodeptr klass node */
+		dukky_memoise_node(ctx, node);
 	}
-	/* ... nodeptr klass nodes node */
-	duk_insert(ctx, -4);
-	/* ... node nodeptr klass nodes */
-	duk_pop_3(ctx);
+	/* ... nodeptr klass node */
+	duk_insert(ctx, -3);
+	/* ... node nodeptr klass */
+	duk_pop_2(ctx);
 	/* ... node */
 	if (NSLOG_COMPILED_MIN_LEVEL <= NSLOG_LEVEL_DEEPDEBUG) {
 		duk_dup(ctx, -1);
@@ -484,17 +639,7 @@ dukky_push_node(duk_context *ctx, struct dom_node *node)
 	NSLOG(dukky, DEEPDEBUG, "Pushing node %p", node);
 	/* First check if we can find the node */
 	/* ... */
-	duk_get_global_string(ctx, NODE_MAGIC);
-	/* ... nodes */
-	duk_push_pointer(ctx, node);
-	/* ... nodes nodeptr */
-	duk_get_prop(ctx, -2);
-	/* ... nodes node/undefined */
-	if (!duk_is_undefined(ctx, -1)) {
-		/* ... nodes node */
-		duk_insert(ctx, -2);
-		/* ... node nodes */
-		duk_pop(ctx);
+	if (dukky_push_memoised_node(ctx, node)) {
 		/* ... node */
 		if (NSLOG_COMPILED_MIN_LEVEL <= NSLOG_LEVEL_DEEPDEBUG) {
 			duk_dup(ctx, -1);
@@ -504,8 +649,6 @@ dukky_push_node(duk_context *ctx, struct dom_node *node)
 		}
 		return true;
 	}
-	/* ... nodes undefined */
-	duk_pop_2(ctx);
 	/* ... */
 	/* We couldn't, so now we determine the node type and then
 	 * we ask for it to be created
@@ -589,7 +732,11 @@ void js_initialise(void)
 /* exported interface documented in js.h */
 void js_finalise(void)
 {
-	/* NADA for now */
+	if (dukky_bytecode_cache != NULL) {
+		hashmap_destroy(dukky_bytecode_cache);
+		dukky_bytecode_cache = NULL;
+		dukky_bytecode_size = 0;
+	}
 }
 
 
@@ -685,10 +832,15 @@ nserror js_newthread(jsheap *heap, void *win_priv, void *doc_priv, jsthread **th
 	duk_set_global_object(CTX);
 
 	/* Now we need to prepare our node mapping table */
-	duk_push_object(CTX);
-	duk_push_pointer(CTX, NULL);
-	duk_push_null(CTX);
-	duk_put_prop(CTX, -3);
+	ret->nodes = hashmap_create(&dukky_node_map_params);
+	if (ret->nodes == NULL) {
+		NSLOG(dukky, CRITICAL, "Unable to create node map, thread aborted");
+		js_destroythread(ret);
+		return NSERROR_NOMEM;
+	}
+	duk_push_pointer(CTX, ret->nodes);
+	duk_put_global_string(CTX, NODE_MAP_MAGIC);
+	duk_push_array(CTX);
 	duk_put_global_string(CTX, NODE_MAGIC);
 
 	/* And now the event mapping table */
@@ -798,6 +950,9 @@ static void dukky_destroythread(jsthread *thread)
 	duk_pop(heap->ctx); /* ... */
 
 	/* We can now free the thread object */
+	if (thread->nodes != NULL) {
+		hashmap_destroy(thread->nodes);
+	}
 	free(thread);
 
 	/* Finally give the heap a chance to clean up */
@@ -917,11 +1072,391 @@ void dukky_log_stack_frame(duk_context *ctx, const char * reason)
 }
 
 
+/**
+ * Compute the FNV-1a hash of a block of memory
+ */
+static uint32_t dukky_hash_data(const uint8_t *data, size_t len)
+{
+	uint32_t z = 0x811c9dc5;
+
+	while (len-- > 0) {
+		z ^= *data++;
+		z *= 0x01000193;
+	}
+
+	return z;
+}
+
+static void *dukky_bytecode_key_clone(void *key)
+{
+	return strdup(key);
+}
+
+static void dukky_bytecode_key_destroy(void *key)
+{
+	free(key);
+}
+
+static uint32_t dukky_bytecode_key_hash(void *key)
+{
+	return dukky_hash_data(key, strlen(key));
+}
+
+static bool dukky_bytecode_key_eq(void *a, void *b)
+{
+	return strcmp(a, b) == 0;
+}
+
+static void *dukky_bytecode_value_alloc(void *key)
+{
+	return calloc(1, sizeof(struct dukky_bytecode));
+}
+
+static void dukky_bytecode_value_destroy(void *value)
+{
+	struct dukky_bytecode *bc = value;
+
+	free(bc->src);
+	free(bc->data);
+	free(bc);
+}
+
+static hashmap_parameters_t dukky_bytecode_params = {
+	.key_clone = dukky_bytecode_key_clone,
+	.key_destroy = dukky_bytecode_key_destroy,
+	.key_hash = dukky_bytecode_key_hash,
+	.key_eq = dukky_bytecode_key_eq,
+	.value_alloc = dukky_bytecode_value_alloc,
+	.value_destroy = dukky_bytecode_value_destroy,
+};
+
+/**
+ * Safe call wrapper to turn cached bytecode back into a function
+ *
+ * \param ctx duktape context
+ * \param udata The cached bytecode to load
+ * \return 1 with the loaded function on the stack
+ */
+static duk_ret_t dukky_bytecode_load_safe(duk_context *ctx, void *udata)
+{
+	struct dukky_bytecode *bc = udata;
+	void *buf;
+
+	buf = duk_push_fixed_buffer(ctx, bc->datalen);
+	memcpy(buf, bc->data, bc->datalen);
+	duk_load_function(ctx);
+
+	return 1;
+}
+
+/**
+ * Safe call wrapper to dump the function on the stack top to bytecode
+ *
+ * \param ctx duktape context
+ * \param udata unused
+ * \return 1 with the bytecode buffer replacing the function
+ */
+static duk_ret_t dukky_bytecode_dump_safe(duk_context *ctx, void *udata)
+{
+	duk_dump_function(ctx);
+
+	return 1;
+}
+
+/**
+ * Find the cached compiled form of a script
+ *
+ * \param name URL of the script
+ * \param src script source
+ * \param srclen length of the script source
+ * \return the cache entry if it was built from identical source else NULL
+ */
+static struct dukky_bytecode *
+dukky_bytecode_lookup(const char *name, const uint8_t *src, size_t srclen)
+{
+	struct dukky_bytecode *bc;
+
+	if (dukky_bytecode_cache == NULL) {
+		return NULL;
+	}
+
+	bc = hashmap_lookup(dukky_bytecode_cache, (void *)name);
+	if ((bc == NULL) ||
+	    (bc->data == NULL) ||
+	    (bc->srclen != srclen) ||
+	    (memcmp(bc->src, src, srclen) != 0)) {
+		return NULL;
+	}
+
+	return bc;
+}
+
+/**
+ * Push the cached compiled form of a script if it is still valid
+ *
+ * \param ctx duktape context
+ * \param name URL of the script
+ * \param src script source
+ * \param srclen length of the script source
+ * \return true if the compiled function was pushed else false
+ */
+static bool
+dukky_bytecode_fetch(duk_context *ctx,
+		     const char *name,
+		     const uint8_t *src,
+		     size_t srclen)
+{
+	struct dukky_bytecode *bc;
+
+	bc = dukky_bytecode_lookup(name, src, srclen);
+	if (bc == NULL) {
+		return false;
+	}
+
+	if (duk_safe_call(ctx, dukky_bytecode_load_safe, bc, 0, 1) != 0) {
+		NSLOG(dukky, DEBUG, "Unable to load bytecode for %s", name);
+		duk_pop(ctx);
+		dukky_bytecode_size -= bc->srclen + bc->datalen;
+		hashmap_remove(dukky_bytecode_cache, (void *)name);
+		return false;
+	}
+
+	NSLOG(dukky, DEEPDEBUG, "Using cached bytecode for %s", name);
+	return true;
+}
+
+/**
+ * Insert dumped bytecode into the bytecode cache
+ *
+ * \param name URL of the script
+ * \param src script source
+ * \param srclen length of the script source
+ * \param data dumped function bytecode
+ * \param datalen length of the dumped bytecode
+ */
+static void
+dukky_bytecode_insert(const char *name,
+		      const uint8_t *src,
+		      size_t srclen,
+		      const void *data,
+		      size_t datalen)
+{
+	struct dukky_bytecode *bc;
+
+	if ((dukky_bytecode_cache != NULL) &&
+	    ((dukky_bytecode_size + srclen + datalen) > BYTECODE_CACHE_LIMIT)) {
+		NSLOG(dukky, DEBUG, "Flushing %"PRIsizet" bytes of bytecode",
+		      dukky_bytecode_size);
+		hashmap_destroy(dukky_bytecode_cache);
+		dukky_bytecode_cache = NULL;
+		dukky_bytecode_size = 0;
+	}
+
+	if (dukky_bytecode_cache == NULL) {
+		dukky_bytecode_cache = hashmap_create(&dukky_bytecode_params);
+		if (dukky_bytecode_cache == NULL) {
+			return;
+		}
+	}
+
+	bc = hashmap_lookup(dukky_bytecode_cache, (void *)name);
+	if (bc != NULL) {
+		dukky_bytecode_size -= bc->srclen + bc->datalen;
+	}
+
+	bc = hashmap_insert(dukky_bytecode_cache, (void *)name);
+	if (bc == NULL) {
+		/* a failed replacement leaves the stale entry in place */
+		hashmap_remove(dukky_bytecode_cache, (void *)name);
+		return;
+	}
+
+	bc->src = malloc(srclen);
+	bc->data = malloc(datalen);
+	if ((bc->src == NULL) || (bc->data == NULL)) {
+		hashmap_remove(dukky_bytecode_cache, (void *)name);
+		return;
+	}
+
+	memcpy(bc->src, src, srclen);
+	bc->srclen = srclen;
+	memcpy(bc->data, data, datalen);
+	bc->datalen = datalen;
+	dukky_bytecode_size += srclen + datalen;
+}
+
+/**
+ * Store the compiled function on the stack top in the bytecode cache
+ *
+ * The function is left on the stack.
+ *
+ * \param ctx duktape context
+ * \param name URL of the script
+ * \param src script source
+ * \param srclen length of the script source
+ */
+static void
+dukky_bytecode_store(duk_context *ctx,
+		     const char *name,
+		     const uint8_t *src,
+		     size_t srclen)
+{
+	duk_size_t datalen;
+	void *data;
+
+	duk_dup(ctx, -1);
+	if (duk_safe_call(ctx, dukky_bytecode_dump_safe, NULL, 1, 1) != 0) {
+		NSLOG(dukky, DEBUG, "Unable to dump bytecode for %s", name);
+		duk_pop(ctx);
+		return;
+	}
+
+	data = duk_get_buffer(ctx, -1, &datalen);
+	if ((data != NULL) && (datalen != 0)) {
+		dukky_bytecode_insert(name, src, srclen, data, datalen);
+	}
+
+	duk_pop(ctx);
+}
+
+/**
+ * Determine if a script's compiled bytecode should be cached
+ *
+ * Only external scripts, named by their URL, are worth caching as
+ *  inline and generated sources are rarely seen twice.
+ *
+ * \param name The script name.
+ * \param txtlen The length of the script source.
+ * \return true if the bytecode should be cached.
+ */
+static inline bool dukky_bytecode_cacheable(const char *name, size_t txtlen)
+{
+	return (name != NULL) &&
+		(name[0] != '?') &&
+		(txtlen >= BYTECODE_CACHE_MIN_SOURCE);
+}
+
+
+/**
+ * Script compilation prepared ahead of its execution
+ */
+struct jsprecompile {
+	char *name; /**< URL of the script */
+	uint8_t *src; /**< copy of the script source */
+	size_t srclen; /**< length of the script source */
+	void *data; /**< dumped function bytecode once compiled */
+	size_t datalen; /**< length of the dumped bytecode */
+};
+
+/* exported interface documented in js.h */
+nserror
+js_precompile_create(const uint8_t *txt,
+		     size_t txtlen,
+		     const char *name,
+		     jsprecompile **job_out)
+{
+	jsprecompile *job;
+
+	*job_out = NULL;
+
+	if ((txt == NULL) || (dukky_bytecode_cacheable(name, txtlen) == false)) {
+		return NSERROR_OK;
+	}
+
+	if (dukky_bytecode_lookup(name, txt, txtlen) != NULL) {
+		/* already compiled */
+		return NSERROR_OK;
+	}
+
+	job = calloc(1, sizeof(*job));
+	if (job == NULL) {
+		return NSERROR_NOMEM;
+	}
+
+	job->name = strdup(name);
+	job->src = malloc(txtlen);
+	if ((job->name == NULL) || (job->src == NULL)) {
+		free(job->name);
+		free(job->src);
+		free(job);
+		return NSERROR_NOMEM;
+	}
+	memcpy(job->src, txt, txtlen);
+	job->srclen = txtlen;
+
+	*job_out = job;
+
+	return NSERROR_OK;
+}
+
+/* exported interface documented in js.h */
+void js_precompile_run(jsprecompile *job)
+{
+	jsheap heap;
+	duk_context *ctx;
+	duk_size_t datalen;
+	void *data;
+
+	/* A private heap lets this run on any thread. Its user data is
+	 *  only consulted by the execution timeout check which must
+	 *  see no start time.
+	 */
+	memset(&heap, 0, sizeof(heap));
+	ctx = duk_create_heap(dukky_alloc_function,
+			      dukky_realloc_function,
+			      dukky_free_function,
+			      &heap,
+			      NULL);
+	if (ctx == NULL) {
+		return;
+	}
+
+	duk_push_string(ctx, job->name);
+	if (duk_pcompile_lstring_filename(ctx,
+					  DUK_COMPILE_EVAL,
+					  (const char *)job->src,
+					  job->srclen) == 0) {
+		if (duk_safe_call(ctx, dukky_bytecode_dump_safe,
+				  NULL, 1, 1) == 0) {
+			data = duk_get_buffer(ctx, -1, &datalen);
+			if ((data != NULL) && (datalen != 0)) {
+				job->data = malloc(datalen);
+				if (job->data != NULL) {
+					memcpy(job->data, data, datalen);
+					job->datalen = datalen;
+				}
+			}
+		}
+	}
+
+	duk_destroy_heap(ctx);
+}
+
+/* exported interface documented in js.h */
+void js_precompile_finish(jsprecompile *job, bool store)
+{
+	if (store && (job->data != NULL)) {
+		NSLOG(dukky, DEEPDEBUG, "Precompiled %s", job->name);
+		dukky_bytecode_insert(job->name,
+				      job->src,
+				      job->srclen,
+				      job->data,
+				      job->datalen);
+	}
+
+	free(job->data);
+	free(job->src);
+	free(job->name);
+	free(job);
+}
+
+
 /* exported interface documented in js.h */
 bool
 js_exec(jsthread *thread, const uint8_t *txt, size_t txtlen, const char *name)
 {
 	bool ret = false;
+	bool cacheable;
 	assert(thread);
 
 	if (txt == NULL || txtlen == 0) {
@@ -933,6 +1468,8 @@ js_exec(jsthread *thread, const uint8_t *txt, size_t txtlen, const char *name)
 		return false;
 	}
 
+	NSTRACE_BEGIN("js", "js_exec");
+
 	dukky_enter_thread(thread);
 
 	duk_set_top(CTX, 0);
@@ -940,6 +1477,12 @@ js_exec(jsthread *thread, const uint8_t *txt, size_t txtlen, const char *name)
 	/* NSLOG(dukky, DEEPDEBUG, "\n%s\n", txt); */
 
 	dukky_reset_start_time(CTX);
+
+	cacheable = dukky_bytecode_cacheable(name, txtlen);
+	if (cacheable && dukky_bytecode_fetch(CTX, name, txt, txtlen)) {
+		goto execute;
+	}
+
 	if (name != NULL) {
 		duk_push_string(CTX, name);
 	} else {
@@ -953,6 +1496,11 @@ js_exec(jsthread *thread, const uint8_t *txt, size_t txtlen, const char *name)
 		goto handle_error;
 	}
 
+	if (cacheable) {
+		dukky_bytecode_store(CTX, name, txt, txtlen);
+	}
+
+execute:
 	if (duk_pcall(CTX, 0/*nargs*/) == DUK_EXEC_ERROR) {
 		NSLOG(dukky, DEBUG, "Failed to execute JavaScript");
 		goto handle_error;
@@ -968,6 +1516,7 @@ handle_error:
 	dukky_dump_error(CTX);
 out:
 	dukky_leave_thread(thread);
+	NSTRACE_END("js", "js_exec");
 	return ret;
 }
 
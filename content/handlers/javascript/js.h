@@ -128,6 +128,48 @@ void js_destroythread(jsthread *thread);
  */
 bool js_exec(jsthread *thread, const uint8_t *txt, size_t txtlen, const char *name);
 
+/**
+ * Script compilation prepared ahead of its execution
+ */
+typedef struct jsprecompile jsprecompile;
+
+/**
+ * Prepare to compile an external script ahead of its execution.
+ *
+ * The source and name are copied so the compilation may be run on any
+ *  thread with js_precompile_run(). It must then be completed on the
+ *  main thread with js_precompile_finish().
+ *
+ * \param txt The script source.
+ * \param txtlen The length of the script source.
+ * \param name The script URL, as later passed to js_exec().
+ * \param job Updated with the prepared compilation, or NULL if the
+ *            script gains nothing from being compiled in advance.
+ * \return NSERROR_OK on success, appropriate error otherwise.
+ */
+nserror js_precompile_create(const uint8_t *txt, size_t txtlen, const char *name, jsprecompile **job);
+
+/**
+ * Compile a prepared script.
+ *
+ * This uses no state shared with anything else and may be called from
+ *  any thread.
+ *
+ * \param job The prepared compilation.
+ */
+void js_precompile_run(jsprecompile *job);
+
+/**
+ * Complete a prepared compilation.
+ *
+ * When stored the compiled script is used by a js_exec() of the same
+ *  source and name instead of compiling it again.
+ *
+ * \param job The prepared compilation, it is freed.
+ * \param store true to keep the compiled script, false to discard it.
+ */
+void js_precompile_finish(jsprecompile *job, bool store);
+
 /**
  * fire an event at a dom node
  */
@@ -66,6 +66,20 @@ bool js_exec(jsthread *thread, const uint8_t *txt, size_t txtlen, const char *na
 	return true;
 }
 
+nserror js_precompile_create(const uint8_t *txt, size_t txtlen, const char *name, jsprecompile **job)
+{
+	*job = NULL;
+	return NSERROR_NOT_IMPLEMENTED;
+}
+
+void js_precompile_run(jsprecompile *job)
+{
+}
+
+void js_precompile_finish(jsprecompile *job, bool store)
+{
+}
+
 bool js_fire_event(jsthread *thread, const char *type, struct dom_document *doc, struct dom_node *target)
 {
 	return true;
@@ -33,6 +33,7 @@
 #include "utils/utils.h"
 #include "utils/utf8.h"
 #include "utils/nsoption.h"
+#include "netsurf/misc.h"
 #include "netsurf/content.h"
 #include "netsurf/keypress.h"
 #include "netsurf/browser_window.h"
@@ -48,9 +49,15 @@
 
 #include "text/textplain.h"
 
+/**
+ * A logical line of text, ended by a hard line break
+ */
 struct textplain_line {
-	size_t	start;
-	size_t	length;
+	size_t start; /**< byte offset of line within text */
+	unsigned length; /**< length of line excluding terminator */
+	unsigned rows; /**< number of rows the line is wrapped onto */
+	unsigned *brk; /**< offsets within line of rows after the first */
+	bool wrapped; /**< rows is exact rather than an estimate */
 };
 
 /**
@@ -64,8 +71,11 @@ typedef struct textplain_content {
 	char *utf8_data;
 	size_t utf8_data_size;
 	size_t utf8_data_allocated;
-	unsigned long physical_line_count;
-	struct textplain_line *physical_line;
+	unsigned long line_count; /**< number of logical lines */
+	struct textplain_line *line; /**< logical lines, NULL until formatted */
+	unsigned long *row_tree; /**< binary indexed tree of rows per line */
+	unsigned long row_count; /**< total number of rows */
+	size_t columns; /**< columns lines are wrapped to */
 	int formatted_width;
 	struct browser_window *bw;
 
@@ -164,8 +174,11 @@ textplain_create_internal(textplain_content *c, lwc_string *encoding)
 	c->utf8_data = utf8_data;
 	c->utf8_data_size = 0;
 	c->utf8_data_allocated = CHUNK;
-	c->physical_line = 0;
-	c->physical_line_count = 0;
+	c->line = NULL;
+	c->line_count = 0;
+	c->row_tree = NULL;
+	c->row_count = 0;
+	c->columns = 0;
 	c->formatted_width = 0;
 	c->bw = NULL;
 	c->sel = selection_create((struct content *)c);
@@ -395,21 +408,373 @@ static float textplain_line_height(void)
 }
 
 
+/**
+ * Find the next occurrence of a byte in the text
+ *
+ * \return offset of the byte or size if there is none
+ */
+static size_t
+textplain_next_byte(const char *data, size_t size, size_t start, char c)
+{
+	const char *pos = memchr(data + start, c, size - start);
+
+	return (pos == NULL) ? size : (size_t)(pos - data);
+}
+
+
+/**
+ * Build the logical line index of a CONTENT_TEXTPLAIN
+ *
+ * Lines are split at CR, LF, CR/LF or LF/CR. The data is scanned a
+ * line ending at a time with memchr rather than decoded, so this is
+ * cheap even for very large documents and is only done once.
+ *
+ * \param text content to index
+ * \return true on success else false on memory exhaustion
+ */
+static bool textplain_index_lines(textplain_content *text)
+{
+	const char *data = text->utf8_data;
+	size_t size = text->utf8_data_size;
+	struct textplain_line *line = NULL;
+	unsigned long count = 0;
+	unsigned long alloc = 0;
+	size_t start = 0;
+	size_t lf;
+	size_t cr;
+
+	lf = textplain_next_byte(data, size, 0, '\n');
+	cr = textplain_next_byte(data, size, 0, '\r');
+
+	while (true) {
+		size_t end;
+
+		if (count == alloc) {
+			struct textplain_line *line1;
+
+			alloc = (alloc == 0) ? 1024 : alloc * 2;
+			line1 = realloc(line, alloc * sizeof(*line));
+			if (line1 == NULL) {
+				free(line);
+				return false;
+			}
+			line = line1;
+		}
+
+		if (lf < start) {
+			lf = textplain_next_byte(data, size, start, '\n');
+		}
+		if (cr < start) {
+			cr = textplain_next_byte(data, size, start, '\r');
+		}
+		end = min(lf, cr);
+
+		line[count].start = start;
+		line[count].length = end - start;
+		line[count].rows = 1;
+		line[count].brk = NULL;
+		line[count].wrapped = false;
+		count++;
+
+		if (end == size) {
+			break;
+		}
+
+		start = end + 1;
+
+		/* skip second char of CR/LF or LF/CR pair */
+		if (start < size &&
+		    data[start] != data[end] &&
+		    (data[start] == '\n' || data[start] == '\r')) {
+			start++;
+		}
+	}
+
+	text->line = line;
+	text->line_count = count;
+
+	return true;
+}
+
+
+/**
+ * Estimate the number of rows a line wraps onto without decoding it
+ */
+static unsigned textplain_estimate_rows(textplain_content *text, struct textplain_line *line)
+{
+	if (line->length < text->columns) {
+		return 1;
+	}
+	return 1 + line->length / text->columns;
+}
+
+
+/**
+ * Rebuild the row tree from the row counts of every line
+ *
+ * The tree is a binary indexed (Fenwick) tree allowing the first row
+ * of a line, and the line containing a row, to be found in
+ * logarithmic time while individual line heights change.
+ */
+static void textplain_rows_build(textplain_content *text)
+{
+	unsigned long *tree = text->row_tree;
+	unsigned long count = text->line_count;
+	unsigned long idx;
+
+	memset(tree, 0, (count + 1) * sizeof(*tree));
+
+	text->row_count = 0;
+	for (idx = 1; idx <= count; idx++) {
+		unsigned long parent = idx + (idx & -idx);
+
+		tree[idx] += text->line[idx - 1].rows;
+		text->row_count += text->line[idx - 1].rows;
+		if (parent <= count) {
+			tree[parent] += tree[idx];
+		}
+	}
+}
+
+
+/**
+ * Get the number of rows before a line
+ */
+static unsigned long
+textplain_rows_before(textplain_content *text, unsigned long lineno)
+{
+	unsigned long rows = 0;
+
+	while (lineno > 0) {
+		rows += text->row_tree[lineno];
+		lineno -= lineno & -lineno;
+	}
+
+	return rows;
+}
+
+
+/**
+ * Find the line containing a row
+ *
+ * \param text content to search
+ * \param row row to find, must be less than the row count
+ * \param first_row receives the first row of the returned line
+ * \return line number
+ */
+static unsigned long
+textplain_line_at_row(textplain_content *text,
+		      unsigned long row,
+		      unsigned long *first_row)
+{
+	unsigned long count = text->line_count;
+	unsigned long lineno = 0;
+	unsigned long remain = row;
+	unsigned long step = 1;
+
+	while (step * 2 <= count) {
+		step *= 2;
+	}
+
+	for (; step > 0; step /= 2) {
+		if ((lineno + step <= count) &&
+		    (text->row_tree[lineno + step] <= remain)) {
+			lineno += step;
+			remain -= text->row_tree[lineno];
+		}
+	}
+
+	if (lineno >= count) {
+		/* row past the end; clamp to the last line */
+		lineno = count - 1;
+		remain = text->line[lineno].rows - 1;
+	}
+
+	*first_row = row - remain;
+	return lineno;
+}
+
+
+/**
+ * Notify users of a CONTENT_TEXTPLAIN that its height has changed
+ */
+static void textplain_height_changed(void *p)
+{
+	struct content *c = p;
+	union content_msg_data data;
+
+	data.background = false;
+	content_broadcast(c, CONTENT_MSG_REFORMAT, &data);
+}
+
+
+/**
+ * Compute the content height from the current row count
+ */
+static int textplain_height(textplain_content *text)
+{
+	return text->row_count * textplain_line_height() + MARGIN + MARGIN;
+}
+
+
+/**
+ * Wrap a logical line to the formatted width
+ *
+ * Rows are broken at the last space before the line reaches the
+ * available columns, or before the character which does not fit if
+ * there is no space. The line's estimated row count is replaced with
+ * the exact one and the content height is updated to match.
+ *
+ * \param text content containing line
+ * \param lineno line to wrap
+ */
+static void textplain_wrap_line(textplain_content *text, unsigned long lineno)
+{
+	struct textplain_line *line = &text->line[lineno];
+	const char *data = text->utf8_data + line->start;
+	size_t length = line->length;
+	size_t columns = text->columns;
+	unsigned *brk = NULL;
+	unsigned brk_count = 0;
+	unsigned brk_alloc = 0;
+	size_t row_start = 0;
+	size_t space = 0;
+	bool have_space = false;
+	size_t col = 0;
+	size_t i = 0;
+	long delta;
+
+	if (line->wrapped) {
+		return;
+	}
+
+	/* a short line without tabs cannot wrap */
+	if (length >= columns || memchr(data, '\t', length) != NULL) {
+		while (i < length) {
+			size_t csize = 1;
+			uint32_t chr = (uint8_t)data[i];
+			size_t next_col;
+
+			if (chr >= 0x80) {
+				parserutils_error perror;
+
+				perror = parserutils_charset_utf8_to_ucs4(
+						(const uint8_t *)data + i,
+						length - i,
+						&chr,
+						&csize);
+				if (perror != PARSERUTILS_OK) {
+					chr = 0xfffd;
+					csize = 1;
+				}
+			}
+
+			next_col = col + 1;
+			if (chr == '\t') {
+				next_col = (next_col + TAB_WIDTH - 1) &
+					~(TAB_WIDTH - 1);
+			}
+
+			if (next_col >= columns && i > row_start) {
+				if (brk_count == brk_alloc) {
+					unsigned *brk1;
+
+					brk_alloc = brk_alloc ? brk_alloc * 2 : 8;
+					brk1 = realloc(brk,
+						       brk_alloc * sizeof(*brk));
+					if (brk1 == NULL) {
+						free(brk);
+						return;
+					}
+					brk = brk1;
+				}
+
+				/* break at last space in row */
+				if (have_space) {
+					i = space + 1;
+				}
+				brk[brk_count++] = i;
+				row_start = i;
+				col = 0;
+				have_space = false;
+				continue;
+			}
+
+			col = next_col;
+			if (chr == ' ') {
+				space = i;
+				have_space = true;
+			}
+			i += csize;
+		}
+	}
+
+	line->brk = brk;
+	line->wrapped = true;
+
+	delta = (long)(brk_count + 1) - (long)line->rows;
+	if (delta == 0) {
+		return;
+	}
+	line->rows = brk_count + 1;
+
+	/* update the row tree and content height */
+	text->row_count += delta;
+	for (lineno++; lineno <= text->line_count; lineno += lineno & -lineno) {
+		text->row_tree[lineno] += delta;
+	}
+
+	text->base.height = textplain_height(text);
+	guit->misc->schedule(0, textplain_height_changed, text);
+}
+
+
+/**
+ * Get the extent of a row of a line
+ *
+ * \param line line containing row
+ * \param row row within line
+ * \param start receives byte offset of row within text
+ * \param length receives length of row
+ */
+static void
+textplain_row_span(struct textplain_line *line,
+		   unsigned row,
+		   size_t *start,
+		   size_t *length)
+{
+	size_t row_start = 0;
+	size_t row_end = line->length;
+
+	if (line->brk != NULL) {
+		if (row > 0) {
+			row_start = line->brk[row - 1];
+		}
+		if (row + 1 < line->rows) {
+			row_end = line->brk[row];
+		}
+	} else if (row > 0) {
+		/* unwrapped line is drawn on its first row only */
+		row_start = row_end;
+	}
+
+	*start = line->start + row_start;
+	*length = row_end - row_start;
+}
+
+
 /**
  * Reformat a CONTENT_TEXTPLAIN to a new width.
+ *
+ * Only an estimate of the number of rows each line needs is made here;
+ * lines are wrapped when they are first redrawn or otherwise located.
  */
 static void textplain_reformat(struct content *c, int width, int height)
 {
 	textplain_content *text = (textplain_content *) c;
-	char *utf8_data = text->utf8_data;
-	size_t utf8_data_size = text->utf8_data_size;
-	unsigned long line_count = 0;
-	struct textplain_line *line = text->physical_line;
-	struct textplain_line *line1;
-	size_t i, space, col;
-	size_t columns = 80;
+	unsigned long lineno;
 	int character_width;
-	size_t line_start;
+	int columns;
 	nserror res;
 
 	NSLOG(netsurf, INFO, "content %p w:%d h:%d", c, width, height);
@@ -425,93 +790,52 @@ static void textplain_reformat(struct content *c, int width, int height)
 	}
 
 	columns = (width - MARGIN - MARGIN) * 8 / character_width;
+	if (columns < 1) {
+		columns = 1;
+	}
 	textplain_tab_width = (TAB_WIDTH * character_width) / 8;
 
 	text->formatted_width = width;
 
-	text->physical_line_count = 0;
-
-	if (!line) {
-		text->physical_line = line =
-			malloc(sizeof(struct textplain_line) * (1024 + 3));
-		if (!line)
+	if (text->line == NULL) {
+		if (!textplain_index_lines(text)) {
 			goto no_memory;
-	}
-
-	line[line_count++].start = line_start = 0;
-	space = 0;
-	i = 0;
-	col = 0;
-	while (i < utf8_data_size) {
-		size_t csize; /* number of bytes in character */
-		uint32_t chr;
-		bool term;
-		size_t next_col;
-		parserutils_error perror;
-
-		perror = parserutils_charset_utf8_to_ucs4((const uint8_t *)utf8_data + i, utf8_data_size - i, &chr, &csize);
-		if (perror != PARSERUTILS_OK) {
-			chr = 0xfffd;
 		}
+	}
 
-		term = (chr == '\n' || chr == '\r');
-
-		next_col = col + 1;
-
-		if (chr == '\t') {
-			next_col = (next_col + TAB_WIDTH - 1) & ~(TAB_WIDTH - 1);
+	if (text->row_tree == NULL) {
+		text->row_tree = malloc((text->line_count + 1) *
+					sizeof(*text->row_tree));
+		if (text->row_tree == NULL) {
+			goto no_memory;
 		}
+	} else if (text->columns == (size_t)columns) {
+		/* existing wrapping is still valid */
+		goto done;
+	}
 
-		if (term || next_col >= columns) {
-			if (line_count % 1024 == 0) {
-				line1 = realloc(line,
-						sizeof(struct textplain_line) *
-						(line_count + 1024 + 3));
-				if (!line1)
-					goto no_memory;
-				text->physical_line = line = line1;
-			}
-
-			if (term) {
-				line[line_count-1].length = i - line_start;
+	text->columns = columns;
 
-				/* skip second char of CR/LF or LF/CR pair */
-				if (i + 1 < utf8_data_size &&
-				    utf8_data[i+1] != utf8_data[i] &&
-				    (utf8_data[i+1] == '\n' ||
-				     utf8_data[i+1] == '\r')) {
-					i++;
-				}
-			} else {
-				if (space) {
-					/* break at last space in line */
-					i = space;
-					line[line_count-1].length = (i + 1) - line_start;
-				} else
-					line[line_count-1].length = i - line_start;
-			}
+	for (lineno = 0; lineno < text->line_count; lineno++) {
+		struct textplain_line *line = &text->line[lineno];
 
-			line[line_count++].start = line_start = i + 1;
-			col = 0;
-			space = 0;
-		} else {
-			col++;
-			if (chr == ' ')
-				space = i;
-		}
-		i += csize;
+		free(line->brk);
+		line->brk = NULL;
+		line->wrapped = false;
+		line->rows = textplain_estimate_rows(text, line);
 	}
-	line[line_count-1].length = i - line[line_count-1].start;
-	line[line_count].start = utf8_data_size;
 
-	text->physical_line_count = line_count;
+	textplain_rows_build(text);
+
+done:
 	c->width = width;
-	c->height = line_count * textplain_line_height() + MARGIN + MARGIN;
+	c->height = textplain_height(text);
 
 	return;
 
 no_memory:
-	NSLOG(netsurf, INFO, "out of memory (line_count %lu)", line_count);
+	NSLOG(netsurf, INFO, "out of memory (line_count %lu)",
+	      text->line_count);
 	return;
 }
 
@@ -530,10 +854,19 @@ static void textplain_destroy(struct content *c)
 		parserutils_inputstream_destroy(text->inputstream);
 	}
 
-	if (text->physical_line != NULL) {
-		free(text->physical_line);
+	guit->misc->schedule(-1, textplain_height_changed, text);
+
+	if (text->line != NULL) {
+		unsigned long lineno;
+
+		for (lineno = 0; lineno < text->line_count; lineno++) {
+			free(text->line[lineno].brk);
+		}
+		free(text->line);
 	}
 
+	free(text->row_tree);
+
 	if (text->utf8_data != NULL) {
 		free(text->utf8_data);
 	}
@@ -616,8 +949,11 @@ textplain_offset_from_coords(struct content *c, int x, int y, int dir)
 	textplain_content *textc = (textplain_content *) c;
 	float line_height = textplain_line_height();
 	struct textplain_line *line;
+	unsigned long lineno;
+	unsigned long row;
+	unsigned long first_row;
 	const char *text;
-	unsigned nlines;
+	size_t start;
 	size_t length;
 	int idx;
 
@@ -626,17 +962,25 @@ textplain_offset_from_coords(struct content *c, int x, int y, int dir)
 	y = (int)((float)(y - MARGIN) / line_height);
 	x -= MARGIN;
 
-	nlines = textc->physical_line_count;
-	if (!nlines)
+	if (!textc->row_count)
 		return 0;
 
-	if (y <= 0) y = 0;
-	else if ((unsigned)y >= nlines)
-		y = nlines - 1;
+	if (y <= 0) row = 0;
+	else if ((unsigned long)y >= textc->row_count)
+		row = textc->row_count - 1;
+	else
+		row = y;
+
+	lineno = textplain_line_at_row(textc, row, &first_row);
+	line = &textc->line[lineno];
+	textplain_wrap_line(textc, lineno);
 
-	line = &textc->physical_line[y];
-	text = textc->utf8_data + line->start;
-	length = line->length;
+	row -= first_row;
+	if (row >= line->rows)
+		row = line->rows - 1;
+
+	textplain_row_span(line, row, &start, &length);
+	text = textc->utf8_data + start;
 	idx = 0;
 
 	while (x > 0) {
@@ -681,7 +1025,7 @@ textplain_offset_from_coords(struct content *c, int x, int y, int dir)
 		idx++;
 	}
 
-	return line->start + idx;
+	return start + idx;
 }
 
 
@@ -1035,11 +1379,146 @@ text_draw(const char *utf8_text,
 }
 
 
+/**
+ * Draw a single row of a CONTENT_TEXTPLAIN
+ *
+ * \param text content being redrawn
+ * \param start byte offset of row within text
+ * \param length length of row
+ * \param x x ordinate of row start
+ * \param y y ordinate of row top
+ * \param clip current clip region
+ * \param scale current display scale
+ * \param plot_style_highlight style for highlighted tabs
+ * \param ctx current redraw context
+ * \return true if successful, false otherwise
+ */
+static bool
+textplain_redraw_row(textplain_content *text,
+		     size_t start,
+		     size_t length,
+		     int x,
+		     int y,
+		     const struct rect *clip,
+		     float scale,
+		     plot_style_t *plot_style_highlight,
+		     const struct redraw_context *ctx)
+{
+	const char *text_d = text->utf8_data + start;
+	float line_height = textplain_line_height();
+	float scaled_line_height = line_height * scale;
+	int tab_width = textplain_tab_width * scale;
+	size_t offset = 0;
+	int tx = x;
+
+	if (!tab_width) tab_width = 1;
+
+	while (offset < length) {
+		size_t next_offset = offset;
+		int width;
+		int ntx;
+		nserror res;
+
+		while ((next_offset < length) &&
+		       (text_d[next_offset] != '\t')) {
+			next_offset = utf8_next(text_d,
+						length,
+						next_offset);
+		}
+
+		if (!text_draw(text_d + offset,
+			       next_offset - offset,
+			       start + offset,
+			       tx,
+			       y,
+			       clip,
+			       line_height,
+			       scale,
+			       text,
+			       text->sel,
+			       ctx)) {
+			return false;
+		}
+
+		if (next_offset >= length)
+			break;
+
+		res = guit->layout->width(&textplain_style,
+					  &text_d[offset],
+					  next_offset - offset,
+					  &width);
+		/* locate end of string and align to next tab position */
+		if (res == NSERROR_OK) {
+			tx += (int)(width * scale);
+		}
+
+		ntx = x + ((1 + (tx - x) / tab_width) * tab_width);
+
+		/* if the tab character lies within the
+		 *  selection, if any, then we must draw it as
+		 *  a filled rectangle so that it's consistent
+		 *  with background of the selected text
+		 */
+
+		if (text->bw) {
+			unsigned tab_ofst = start + next_offset;
+			struct selection *sel = text->sel;
+			bool highlighted = false;
+
+			unsigned start_idx, end_idx;
+			if (selection_highlighted(sel,
+						  tab_ofst,
+						  tab_ofst + 1,
+						  &start_idx,
+						  &end_idx)) {
+				highlighted = true;
+			}
+
+
+			if (!highlighted &&
+			    (text->base.textsearch.context != NULL)) {
+				unsigned start_idx, end_idx;
+				if (content_textsearch_ishighlighted(
+					    text->base.textsearch.context,
+					    tab_ofst,
+					    tab_ofst + 1,
+					    &start_idx,
+					    &end_idx)) {
+					highlighted = true;
+				}
+			}
+
+			if (highlighted) {
+				struct rect rect;
+				rect.x0 = tx;
+				rect.y0 = y;
+				rect.x1 = ntx;
+				rect.y1 = rect.y0 + scaled_line_height;
+				res = ctx->plot->rectangle(ctx,
+							   plot_style_highlight,
+							   &rect);
+				if (res != NSERROR_OK) {
+					return false;
+				}
+			}
+		}
+
+		offset = next_offset + 1;
+		tx = ntx;
+	}
+
+	return true;
+}
+
+
 /**
  * Draw a CONTENT_TEXTPLAIN using the current set of plotters (plot).
  *
  * x, y, clip_[xy][01] are in target coordinates.
  *
+ * Only the lines covering the clip region are wrapped, the rest of
+ * the document keeps its estimated height.
+ *
  * \param  c	 content of type CONTENT_TEXTPLAIN
  * \param  data	 redraw data for this content redraw
  * \param  clip	 current clip region
@@ -1053,38 +1532,35 @@ textplain_redraw(struct content *c,
 		 const struct redraw_context *ctx)
 {
 	textplain_content *text = (textplain_content *) c;
-	struct browser_window *bw = text->bw;
-	char *utf8_data = text->utf8_data;
-	long lineno;
 	int x = data->x;
 	int y = data->y;
-	unsigned long line_count = text->physical_line_count;
+	unsigned long row_count = text->row_count;
 	float line_height = textplain_line_height();
 	float scaled_line_height = line_height * data->scale;
-	long line0 = (clip->y0 - y * data->scale) / scaled_line_height - 1;
-	long line1 = (clip->y1 - y * data->scale) / scaled_line_height + 1;
-	struct textplain_line *line = text->physical_line;
-	size_t length;
+	long row0 = (clip->y0 - y * data->scale) / scaled_line_height - 1;
+	long row1 = (clip->y1 - y * data->scale) / scaled_line_height + 1;
+	unsigned long lineno;
+	unsigned long row;
 	plot_style_t *plot_style_highlight;
 	nserror res;
 
-	if (line0 < 0)
-		line0 = 0;
-	if (line1 < 0)
-		line1 = 0;
-	if (line_count < (unsigned long) line0)
-		line0 = line_count;
-	if (line_count < (unsigned long) line1)
-		line1 = line_count;
-	if (line1 < line0)
-		line1 = line0;
+	if (row0 < 0)
+		row0 = 0;
+	if (row1 < 0)
+		row1 = 0;
+	if (row_count < (unsigned long) row0)
+		row0 = row_count;
+	if (row_count < (unsigned long) row1)
+		row1 = row_count;
+	if (row1 < row0)
+		row1 = row0;
 
 	res = ctx->plot->rectangle(ctx, plot_style_fill_white, clip);
 	if (res != NSERROR_OK) {
 		return false;
 	}
 
-	if (!line)
+	if (text->line == NULL || row0 == row1)
 		return true;
 
 	/* choose a suitable background colour for any highlighted text */
@@ -1098,110 +1574,38 @@ textplain_redraw(struct content *c,
 
 	x = (x + MARGIN) * data->scale;
 	y = (y + MARGIN) * data->scale;
-	for (lineno = line0; lineno != line1; lineno++) {
-		const char *text_d = utf8_data + line[lineno].start;
-		int tab_width = textplain_tab_width * data->scale;
-		size_t offset = 0;
-		int tx = x;
-
-		if (!tab_width) tab_width = 1;
-
-		length = line[lineno].length;
-		if (!length)
-			continue;
-
-		while (offset < length) {
-			size_t next_offset = offset;
-			int width;
-			int ntx;
-			nserror res;
-
-			while ((next_offset < length) &&
-			       (text_d[next_offset] != '\t')) {
-				next_offset = utf8_next(text_d,
-							length,
-							next_offset);
-			}
 
-			if (!text_draw(text_d + offset,
-				       next_offset - offset,
-				       line[lineno].start + offset,
-				       tx,
-				       y + (lineno * scaled_line_height),
-				       clip,
-				       line_height,
-				       data->scale,
-				       text,
-				       text->sel,
-				       ctx)) {
+	lineno = textplain_line_at_row(text, row0, &row);
+	for (; lineno < text->line_count && row < (unsigned long)row1; lineno++) {
+		struct textplain_line *line = &text->line[lineno];
+		unsigned line_row;
+
+		textplain_wrap_line(text, lineno);
+
+		for (line_row = 0;
+		     line_row < line->rows && row < (unsigned long)row1;
+		     line_row++, row++) {
+			size_t start;
+			size_t length;
+
+			if (row < (unsigned long)row0)
+				continue;
+
+			textplain_row_span(line, line_row, &start, &length);
+			if (!length)
+				continue;
+
+			if (!textplain_redraw_row(text,
+						  start,
+						  length,
+						  x,
+						  y + (row * scaled_line_height),
+						  clip,
+						  data->scale,
+						  plot_style_highlight,
+						  ctx)) {
 				return false;
 			}
-
-			if (next_offset >= length)
-				break;
-
-			res = guit->layout->width(&textplain_style,
-						  &text_d[offset],
-						  next_offset - offset,
-						  &width);
-			/* locate end of string and align to next tab position */
-			if (res == NSERROR_OK) {
-				tx += (int)(width * data->scale);
-			}
-
-			ntx = x + ((1 + (tx - x) / tab_width) * tab_width);
-
-			/* if the tab character lies within the
-			 *  selection, if any, then we must draw it as
-			 *  a filled rectangle so that it's consistent
-			 *  with background of the selected text
-			 */
-
-			if (bw) {
-				unsigned tab_ofst = line[lineno].start + next_offset;
-				struct selection *sel = text->sel;
-				bool highlighted = false;
-
-				unsigned start_idx, end_idx;
-				if (selection_highlighted(sel,
-							  tab_ofst,
-							  tab_ofst + 1,
-							  &start_idx,
-							  &end_idx)) {
-					highlighted = true;
-				}
-
-
-				if (!highlighted &&
-				    (c->textsearch.context != NULL)) {
-					unsigned start_idx, end_idx;
-					if (content_textsearch_ishighlighted(
-						    c->textsearch.context,
-						    tab_ofst,
-						    tab_ofst + 1,
-						    &start_idx,
-						    &end_idx)) {
-						highlighted = true;
-					}
-				}
-
-				if (highlighted) {
-					struct rect rect;
-					rect.x0 = tx;
-					rect.y0 = y + (lineno * scaled_line_height);
-					rect.x1 = ntx;
-					rect.y1 = rect.y0 + scaled_line_height;
-					res = ctx->plot->rectangle(ctx,
-								   plot_style_highlight,
-								   &rect);
-					if (res != NSERROR_OK) {
-						return false;
-					}
-				}
-			}
-
-			offset = next_offset + 1;
-			tx = ntx;
 		}
 	}
 
@@ -1298,92 +1702,67 @@ textplain_coord_from_offset(const char *text, size_t offset, size_t length)
 
 
 /**
- * Retrieve number of lines in content
+ * Find the row containing a byte in the text
  *
- * \param[in] c Content to retrieve line count from
- * \return Number of lines
- */
-static unsigned long textplain_line_count(struct content *c)
-{
-	textplain_content *text = (textplain_content *) c;
-
-	assert(c != NULL);
-
-	return text->physical_line_count;
-}
-
-
-/**
- * Return a pointer to the requested line of text.
+ * Given a byte offset within the text, return the row number of the
+ * row containing that offset, wrapping the line it is in if
+ * necessary.
  *
- * \param[in] c        content of type CONTENT_TEXTPLAIN
- * \param[in] lineno   line number
- * \param[out] poffset receives byte offset of line start within text
- * \param[out] plen    receives length of returned line
- * \return pointer to text, or NULL if invalid line number
- */
-static char *
-textplain_get_line(struct content *c,
-		   unsigned lineno,
-		   size_t *poffset,
-		   size_t *plen)
-{
-	textplain_content *text = (textplain_content *) c;
-	struct textplain_line *line;
-
-	assert(c != NULL);
-
-	if (lineno >= text->physical_line_count)
-		return NULL;
-	line = &text->physical_line[lineno];
-
-	*poffset = line->start;
-	*plen = line->length;
-	return text->utf8_data + line->start;
-}
-
-
-/**
- * Find line number of byte in text
- *
- * Given a byte offset within the text, return the line number
- * of the line containing that offset.
- *
- * \param[in] c       content of type CONTENT_TEXTPLAIN
+ * \param[in] text    content of type CONTENT_TEXTPLAIN
  * \param[in] offset  byte offset within textual representation
- * \return line number, or -1 if offset invalid (larger than size)
+ * \param[out] line_out receives the line containing the offset
+ * \param[out] row_out receives the row within that line
+ * \return row number, or -1 if offset invalid (larger than size)
  */
-static int textplain_find_line(struct content *c, unsigned offset)
+static long
+textplain_find_row(textplain_content *text,
+		   size_t offset,
+		   struct textplain_line **line_out,
+		   unsigned *row_out)
 {
-	textplain_content *text = (textplain_content *) c;
 	struct textplain_line *line;
-	int nlines;
-	int lineno = 0;
-
-	assert(c != NULL);
+	unsigned long lo = 0;
+	unsigned long hi = text->line_count;
+	unsigned row = 0;
 
-	line = text->physical_line;
-	nlines = text->physical_line_count;
-
-	if (offset > text->utf8_data_size) {
+	if (offset > text->utf8_data_size || text->row_count == 0) {
 		return -1;
 	}
 
-/* \todo - implement binary search here */
-	while (lineno < nlines && line[lineno].start < offset) {
-		lineno++;
+	/* find the last line starting at or before offset */
+	while (hi - lo > 1) {
+		unsigned long mid = lo + (hi - lo) / 2;
+
+		if (text->line[mid].start <= offset) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
 	}
-	if (line[lineno].start > offset) {
-		lineno--;
+
+	textplain_wrap_line(text, lo);
+	line = &text->line[lo];
+
+	if (line->brk != NULL) {
+		while (row + 1 < line->rows &&
+		       line->start + line->brk[row] <= offset) {
+			row++;
+		}
 	}
 
-	return lineno;
+	*line_out = line;
+	*row_out = row;
+
+	return textplain_rows_before(text, lo) + row;
 }
 
 
 /**
  * Finds all occurrences of a given string in a textplain content
  *
+ * Each logical line is searched in turn so matches may span rows
+ * of a wrapped line.
+ *
  * \param c the content to be searched
  * \param context The search context to add the entry to.
  * \param pattern the string pattern to search for
@@ -1398,48 +1777,46 @@ textplain_textsearch_find(struct content *c,
 			  int p_len,
 			  bool case_sens)
 {
-	int nlines = textplain_line_count(c);
-	int line;
+	textplain_content *textc = (textplain_content *) c;
+	unsigned long lineno;
 	nserror res = NSERROR_OK;
 
-	for(line = 0; line < nlines; line++) {
-		size_t offset, length;
-		const char *text;
-
-		text = textplain_get_line(c, line, &offset, &length);
-		if (text) {
-			while (length > 0) {
-				unsigned match_length;
-				size_t start_idx;
-				const char *new_text;
-				const char *pos;
-
-				pos = content_textsearch_find_pattern(
-						text,
-						length,
-						pattern,
-						p_len,
-						case_sens,
-						&match_length);
-				if (!pos)
-					break;
-
-				/* found string in line => add to list */
-				start_idx = offset + (pos - text);
-				res = content_textsearch_add_match(context,
-						start_idx,
-						start_idx + match_length,
-						NULL,
-						NULL);
-				if (res != NSERROR_OK) {
-					return res;
-				}
+	for (lineno = 0; lineno < textc->line_count; lineno++) {
+		size_t offset = textc->line[lineno].start;
+		size_t length = textc->line[lineno].length;
+		const char *text = textc->utf8_data + offset;
+
+		while (length > 0) {
+			unsigned match_length;
+			size_t start_idx;
+			const char *new_text;
+			const char *pos;
+
+			pos = content_textsearch_find_pattern(
+					text,
+					length,
+					pattern,
+					p_len,
+					case_sens,
+					&match_length);
+			if (!pos)
+				break;
 
-				new_text = pos + match_length;
-				offset += (new_text - text);
-				length -= (new_text - text);
-				text = new_text;
+			/* found string in line => add to list */
+			start_idx = offset + (pos - text);
+			res = content_textsearch_add_match(context,
+					start_idx,
+					start_idx + match_length,
+					NULL,
+					NULL);
+			if (res != NSERROR_OK) {
+				return res;
 			}
+
+			new_text = pos + match_length;
+			offset += (new_text - text);
+			length -= (new_text - text);
+			text = new_text;
 		}
 	}
 
@@ -1464,48 +1841,49 @@ textplain_coords_from_range(struct content *c,
 {
 	textplain_content *text = (textplain_content *) c;
 	float line_height = textplain_line_height();
-	char *utf8_data;
 	struct textplain_line *line;
-	unsigned lineno = 0;
-	unsigned nlines;
+	unsigned line_row;
+	long row;
+	long end_row;
 
 	assert(c != NULL);
 	assert(start <= end);
 	assert(end <= text->utf8_data_size);
 
-	utf8_data = text->utf8_data;
-	nlines = text->physical_line_count;
-	line = text->physical_line;
-
 	/* find start */
-	lineno = textplain_find_line(c, start);
-
-	r->y0 = (int)(MARGIN + lineno * line_height);
+	row = textplain_find_row(text, start, &line, &line_row);
+	if (row < 0) {
+		r->x0 = r->y0 = r->x1 = r->y1 = 0;
+		return;
+	}
 
-	if (lineno + 1 <= nlines || line[lineno + 1].start >= end) {
-		/* \todo - it may actually be more efficient just to
-		 *   run forwards most of the time
-		 */
+	r->y0 = (int)(MARGIN + row * line_height);
 
-		/* find end */
-		lineno = textplain_find_line(c, end);
+	/* find end */
+	end_row = textplain_find_row(text, end, &line, &line_row);
 
+	if (end_row != row) {
 		r->x0 = 0;
 		r->x1 = text->formatted_width;
 	} else {
-		/* single line */
-		const char *text = utf8_data + line[lineno].start;
+		/* single row */
+		size_t row_start;
+		size_t row_length;
+		const char *row_text;
+
+		textplain_row_span(line, line_row, &row_start, &row_length);
+		row_text = text->utf8_data + row_start;
 
-		r->x0 = textplain_coord_from_offset(text,
-						    start - line[lineno].start,
-						    line[lineno].length);
+		r->x0 = MARGIN + textplain_coord_from_offset(row_text,
+						start - row_start,
+						row_length);
 
-		r->x1 = textplain_coord_from_offset(text,
-						    end - line[lineno].start,
-						    line[lineno].length);
+		r->x1 = MARGIN + textplain_coord_from_offset(row_text,
+						end - row_start,
+						row_length);
 	}
 
-	r->y1 = (int)(MARGIN + (lineno + 1) * line_height);
+	r->y1 = (int)(MARGIN + (end_row + 1) * line_height);
 }
 
 
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "utils/corestrings.h"
 #include "utils/http.h"
 #include "utils/log.h"
 #include "utils/messages.h"
@@ -104,13 +105,50 @@ static struct hlcache_s *hlcache = NULL;
  ******************************************************************************/
 
 
+/**
+ * Determine if an unused content may be retained for reuse.
+ *
+ * Parsed stylesheets are retained as reparsing them is expensive and
+ *  they are very likely to be requested again by other pages from the
+ *  same site. Inline sheets are never requested again.
+ *
+ * \param entry The cache entry to consider.
+ * \return true if the content may be retained else false.
+ */
+static bool hlcache_entry_is_retainable(hlcache_entry *entry)
+{
+	hlcache_handle entry_handle = { entry, NULL, NULL };
+	lwc_string *scheme;
+	bool retainable = true;
+
+	if (content_get_type(&entry_handle) != CONTENT_CSS)
+		return false;
+
+	if (content__get_status(entry->content) != CONTENT_STATUS_DONE)
+		return false;
+
+	scheme = nsurl_get_component(content_get_url(entry->content),
+			NSURL_SCHEME);
+	if (scheme != NULL) {
+		retainable = (scheme != corestring_lwc_x_ns_css);
+		lwc_string_unref(scheme);
+	}
+
+	return retainable;
+}
+
 /**
  * Attempt to clean the cache
+ *
+ * Unused contents are destroyed, except for the most recently used
+ *  parsed stylesheets which fit within the retention limit. A forced
+ *  clean retains nothing.
  */
 static void hlcache_clean(void *force_clean_flag)
 {
 	hlcache_entry *entry, *next;
 	bool force_clean = (force_clean_flag != NULL);
+	size_t retained_size = 0;
 
 	for (entry = hlcache->content_list; entry != NULL; entry = next) {
 		next = entry->next;
@@ -129,11 +167,24 @@ static void hlcache_clean(void *force_clean_flag)
 			content_set_error(entry->content);
 		}
 
-		/** \todo This is over-zealous: all unused contents
-		 * will be immediately destroyed. Ideally, we want to
-		 * purge all unused contents that are using stale
-		 * source data, and enough fresh contents such that
-		 * the cache fits in the configured cache size limit.
+		/* The list is kept in most recently used order so the
+		 * least recently used stylesheets are those destroyed
+		 * once the retention limit is reached.
+		 */
+		if ((force_clean == false) &&
+		    hlcache_entry_is_retainable(entry) &&
+		    (retained_size + entry->content->size <=
+		     hlcache->params.retain_limit)) {
+			retained_size += entry->content->size;
+			continue;
+		}
+
+		/** \todo This is over-zealous: all other unused
+		 * contents will be immediately destroyed. Ideally, we
+		 * want to purge all unused contents that are using
+		 * stale source data, and enough fresh contents such
+		 * that the cache fits in the configured cache size
+		 * limit.
 		 */
 
 		/* Remove entry from cache */
@@ -288,6 +339,18 @@ static nserror hlcache_find_content(hlcache_retrieval_ctx *ctx,
 		/* Found a suitable content: no longer need low-level handle */
 		llcache_handle_release(ctx->llcache);
 		hlcache->hit_count++;
+
+		/* Move to the head of the list as most recently used */
+		if (entry->prev != NULL) {
+			entry->prev->next = entry->next;
+			if (entry->next != NULL)
+				entry->next->prev = entry->prev;
+
+			entry->prev = NULL;
+			entry->next = hlcache->content_list;
+			hlcache->content_list->prev = entry;
+			hlcache->content_list = entry;
+		}
 	}
 
 	/* Associate handle with content */
@@ -672,6 +735,38 @@ void hlcache_finalise(void)
 	llcache_finalise();
 }
 
+/* See hlcache.h for documentation */
+nserror hlcache_get_stats(struct hlcache_stats *stats)
+{
+	hlcache_entry *entry;
+	int ring_size;
+
+	if (hlcache == NULL) {
+		return NSERROR_INIT_FAILED;
+	}
+
+	stats->content_count = 0;
+	stats->user_count = 0;
+	stats->retained_count = 0;
+	stats->retained_size = 0;
+	for (entry = hlcache->content_list; entry != NULL; entry = entry->next) {
+		stats->content_count++;
+		if (content_count_users(entry->content) != 0) {
+			stats->user_count++;
+		} else if (hlcache_entry_is_retainable(entry)) {
+			stats->retained_count++;
+			stats->retained_size += entry->content->size;
+		}
+	}
+
+	RING_GETSIZE(hlcache_retrieval_ctx, hlcache->retrieval_ctx_ring, ring_size);
+	stats->retrieving_count = ring_size;
+	stats->hit_count = hlcache->hit_count;
+	stats->miss_count = hlcache->miss_count;
+
+	return NSERROR_OK;
+}
+
 /* See hlcache.h for documentation */
 nserror hlcache_handle_retrieve(nsurl *url, uint32_t flags,
 		nsurl *referer, llcache_post_data *post,
@@ -49,6 +49,9 @@ struct hlcache_parameters {
 	/** How frequently the background cache clean process is run (ms) */
 	unsigned int bg_clean_time;
 
+	/** Size of unused parsed stylesheets retained for reuse (bytes) */
+	size_t retain_limit;
+
 	struct llcache_parameters llcache;
 };
 
@@ -94,6 +97,28 @@ void hlcache_stop(void);
  */
 void hlcache_finalise(void);
 
+/**
+ * High-level cache statistics
+ */
+struct hlcache_stats {
+	unsigned int content_count; /**< number of contents */
+	unsigned int user_count; /**< contents with at least one user */
+	unsigned int retrieving_count; /**< retrievals awaiting a type */
+	unsigned int hit_count; /**< retrievals using an existing content */
+	unsigned int miss_count; /**< retrievals creating a content */
+	unsigned int retained_count; /**< unused stylesheets retained */
+	size_t retained_size; /**< size of retained stylesheets */
+};
+
+/**
+ * Get the high-level cache statistics
+ *
+ * \param stats Structure to fill with the statistics
+ * \return NSERROR_OK on success or NSERROR_INIT_FAILED if the cache
+ *         is not initialised.
+ */
+nserror hlcache_get_stats(struct hlcache_stats *stats);
+
 /**
  * Retrieve a high-level cache handle for an object
  *
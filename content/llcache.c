@@ -42,6 +42,7 @@
 #include "utils/config.h"
 #include "utils/corestrings.h"
 #include "utils/log.h"
+#include "utils/trace.h"
 #include "utils/messages.h"
 #include "utils/nsurl.h"
 #include "utils/utils.h"
@@ -51,6 +52,7 @@
 #include "desktop/gui_internal.h"
 
 #include "content/fetch.h"
+#include "content/blocklist.h"
 #include "content/backing_store.h"
 #include "content/urldb.h"
 
@@ -80,6 +82,8 @@ struct llcache_handle {
 
 	llcache_fetch_state state;	/**< Last known state of object fetch */
 	size_t bytes;			/**< Last reported byte count */
+
+	uint64_t retrieved;		/**< Time the handle was retrieved */
 };
 
 /**
@@ -201,6 +205,11 @@ struct llcache_object {
 	 * determine object lifetime etc.
 	 */
 	time_t last_used; /**< time the last user was removed from the object */
+
+	uint64_t fetch_start; /**< time the last fetch was started */
+	uint64_t response_start; /**< time that fetch received a header */
+	uint64_t first_byte; /**< time that fetch received data */
+	uint64_t response_end; /**< time that fetch finished */
 };
 
 /**
@@ -260,6 +269,32 @@ struct llcache_s {
 	 */
 	uint64_t total_elapsed;
 
+
+	/* statistics */
+
+	/** Number of retrievals satisfied by a fresh object */
+	uint64_t hit_count;
+
+	/** Number of retrievals of an object needing validation */
+	uint64_t revalidate_count;
+
+	/** Number of retrievals needing a full fetch */
+	uint64_t miss_count;
+
+	/** Number of cacheable objects discarded */
+	uint64_t evict_count;
+
+	/** Total size of cacheable objects discarded */
+	uint64_t evict_size;
+
+	/** Number of fetches which completed */
+	uint64_t fetched_count;
+
+	/** Total size of objects fetched */
+	uint64_t fetched_size;
+
+	/** Number of retrievals refused by content blocking */
+	uint64_t blocked_count;
 };
 
 /** low level cache state */
@@ -303,6 +338,7 @@ static nserror llcache_object_user_new(llcache_handle_callback cb, void *pw,
 
 	h->cb = cb;
 	h->pw = pw;
+	nsu_getmonotonic_ms(&h->retrieved);
 
 	u->handle = h;
 
@@ -883,6 +919,11 @@ static nserror llcache_object_refetch(llcache_object *object)
 	/* Reset fetch state */
 	object->fetch.state = LLCACHE_FETCH_INIT;
 
+	nsu_getmonotonic_ms(&object->fetch_start);
+	object->response_start = 0;
+	object->first_byte = 0;
+	object->response_end = 0;
+
 	NSLOG(llcache, DEBUG, "Re-fetching %p", object);
 
 	/* Kick off fetch */
@@ -1878,6 +1919,8 @@ llcache_object_retrieve_from_cache(nsurl *url,
 	if ((newest != NULL) && (llcache_object_is_fresh(newest))) {
 		/* Found a suitable object, and it's still fresh */
 		NSLOG(llcache, DEBUG, "Found fresh %p", newest);
+		NSTRACE_INSTANT("llcache", "llcache_hit");
+		llcache->hit_count++;
 
 		/* The client needs to catch up with the object's state.
 		 * This will occur the next time that llcache_poll is called.
@@ -1920,6 +1963,8 @@ llcache_object_retrieve_from_cache(nsurl *url,
 				return error;
 
 			NSLOG(llcache, DEBUG, "Found candidate %p (%p)", obj, newest);
+			NSTRACE_INSTANT("llcache", "llcache_revalidate");
+			llcache->revalidate_count++;
 
 			/* Clone candidate's cache data */
 			error = llcache_object_clone_cache_data(newest, obj, true);
@@ -1965,6 +2010,9 @@ llcache_object_retrieve_from_cache(nsurl *url,
 		}
 	}
 
+	NSTRACE_INSTANT("llcache", "llcache_miss");
+	llcache->miss_count++;
+
 	/* Attempt to kick-off fetch */
 	error = llcache_object_fetch(obj, flags, referer, post,
 			redirect_count, hsts_in_use);
@@ -2283,6 +2331,21 @@ static nserror llcache_fetch_redirect(llcache_object *object,
 		return NSERROR_OK;
 	}
 
+	/* Refuse to follow redirects to blocked content */
+	if (((object->fetch.flags & LLCACHE_RETRIEVE_VERIFIABLE) == 0) &&
+	    blocklist_match(hsts_url)) {
+		NSLOG(llcache, INFO, "Blocked redirect to %s",
+		      nsurl_access(hsts_url));
+		nsurl_unref(hsts_url);
+		llcache->blocked_count++;
+
+		event.type = LLCACHE_EVENT_ERROR;
+		event.data.error.code = NSERROR_BLOCKED;
+		event.data.error.msg = messages_get("Blocked");
+
+		return llcache_send_event_to_users(object, &event);
+	}
+
 	if (http_code == 301 || http_code == 302 || http_code == 303) {
 		/* 301, 302, 303 redirects are all unconditional GET requests */
 		post = NULL;
@@ -2361,6 +2424,12 @@ static nserror llcache_fetch_notmodified(llcache_object *object,
 		/* Candidate is no longer a candidate for us */
 		object->candidate->candidate_count--;
 
+		/* The validation fetch is the candidate's fetch now */
+		object->candidate->fetch_start = object->fetch_start;
+		object->candidate->response_start = object->response_start;
+		object->candidate->first_byte = object->response_start;
+		nsu_getmonotonic_ms(&object->candidate->response_end);
+
 		/* Clone our cache control data into the candidate */
 		llcache_object_clone_cache_data(object, object->candidate,
 				false);
@@ -2974,6 +3043,9 @@ static void llcache_fetch_callback(const fetch_msg *msg, void *p)
 	case FETCH_HEADER:
 		/* Received a fetch header */
 		object->fetch.state = LLCACHE_FETCH_HEADERS;
+		if (object->response_start == 0) {
+			nsu_getmonotonic_ms(&object->response_start);
+		}
 
 		error = llcache_fetch_process_header(object,
 				msg->data.header_or_data.buf,
@@ -3002,6 +3074,9 @@ static void llcache_fetch_callback(const fetch_msg *msg, void *p)
 	/* Normal 2xx state machine */
 	case FETCH_DATA:
 		/* Received some data */
+		if (object->first_byte == 0) {
+			nsu_getmonotonic_ms(&object->first_byte);
+		}
 		error = llcache_fetch_process_data(object,
 				msg->data.header_or_data.buf,
 				msg->data.header_or_data.len);
@@ -3028,6 +3103,10 @@ static void llcache_fetch_callback(const fetch_msg *msg, void *p)
 
 		/* record when the fetch finished */
 		object->cache.fin_time = time(NULL);
+		nsu_getmonotonic_ms(&object->response_end);
+
+		llcache->fetched_count++;
+		llcache->fetched_size += object->source_len;
 
 		(void) llcache_hsts_update_policy(object);
 
@@ -3645,6 +3724,9 @@ void llcache_clean(bool purge)
 					guit->llcache->invalidate(object->url);
 				}
 
+				llcache->evict_count++;
+				llcache->evict_size += total_object_size(object);
+
 				llcache_object_destroy(object);
 
 		} else {
@@ -3707,6 +3789,9 @@ void llcache_clean(bool purge)
 
 			llcache_size -=	total_object_size(object);
 
+			llcache->evict_count++;
+			llcache->evict_size += total_object_size(object);
+
 			llcache_object_remove_from_list(object,
 						&llcache->cached_objects);
 			llcache_object_destroy(object);
@@ -3737,6 +3822,9 @@ void llcache_clean(bool purge)
 
 			llcache_size -=	object->source_len + sizeof(*object);
 
+			llcache->evict_count++;
+			llcache->evict_size += total_object_size(object);
+
 			llcache_object_remove_from_list(object,
 						&llcache->cached_objects);
 			llcache_object_destroy(object);
@@ -3746,6 +3834,63 @@ void llcache_clean(bool purge)
 	NSLOG(llcache, DEBUG, "Size: %u (limit: %u)", llcache_size, limit);
 }
 
+/* Exported interface documented in content/llcache.h */
+nserror llcache_get_stats(struct llcache_stats *stats)
+{
+	llcache_object *object;
+
+	if (llcache == NULL) {
+		return NSERROR_INIT_FAILED;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+
+	for (object = llcache->uncached_objects;
+	     object != NULL;
+	     object = object->next) {
+		stats->uncached_count++;
+		stats->size += total_object_size(object);
+	}
+
+	for (object = llcache->cached_objects;
+	     object != NULL;
+	     object = object->next) {
+		stats->cached_count++;
+		if (object->store_state == LLCACHE_STATE_DISC) {
+			stats->disc_count++;
+		}
+		stats->size += total_object_size(object);
+	}
+
+	stats->limit = llcache->limit;
+	stats->hit_count = llcache->hit_count;
+	stats->revalidate_count = llcache->revalidate_count;
+	stats->miss_count = llcache->miss_count;
+	stats->evict_count = llcache->evict_count;
+	stats->evict_size = llcache->evict_size;
+	stats->blocked_count = llcache->blocked_count;
+	if (llcache->fetched_count > 0) {
+		/* blocked objects are assumed to be of average size */
+		stats->blocked_size = llcache->blocked_count *
+			(llcache->fetched_size / llcache->fetched_count);
+	}
+	stats->total_written = llcache->total_written;
+	stats->total_elapsed = llcache->total_elapsed;
+	stats->minimum_bandwidth = llcache->minimum_bandwidth;
+	stats->maximum_bandwidth = llcache->maximum_bandwidth;
+
+	return NSERROR_OK;
+}
+
+/* Exported interface documented in content/llcache.h */
+nserror llcache_get_store_stats(struct backing_store_stats *stats)
+{
+	if (guit->llcache->stats == NULL) {
+		return NSERROR_NOT_IMPLEMENTED;
+	}
+	return guit->llcache->stats(stats);
+}
+
 /* Exported interface documented in content/llcache.h */
 nserror
 llcache_initialise(const struct llcache_parameters *prm)
@@ -3907,6 +4052,15 @@ nserror llcache_handle_retrieve(nsurl *url, uint32_t flags,
 		return NSERROR_NO_FETCH_HANDLER;
 	}
 
+	/* Navigations the user asked for are never blocked */
+	if (((flags & LLCACHE_RETRIEVE_VERIFIABLE) == 0) &&
+	    blocklist_match(hsts_url)) {
+		NSLOG(llcache, DEBUG, "Blocked %s", nsurl_access(hsts_url));
+		llcache->blocked_count++;
+		nsurl_unref(hsts_url);
+		return NSERROR_BLOCKED;
+	}
+
 	/* Create a new object user */
 	error = llcache_object_user_new(cb, pw, &user);
 	if (error != NSERROR_OK) {
@@ -4092,6 +4246,35 @@ nsurl *llcache_handle_get_url(const llcache_handle *handle)
 	return handle->object != NULL ? handle->object->url : NULL;
 }
 
+/* See llcache.h for documentation */
+nserror llcache_handle_get_timing(const llcache_handle *handle,
+		struct llcache_timing *timing)
+{
+	const llcache_object *object = handle->object;
+
+	if (object == NULL) {
+		return NSERROR_BAD_PARAMETER;
+	}
+
+	timing->fetch_start = handle->retrieved;
+
+	if (object->fetch_start >= handle->retrieved) {
+		/* object was fetched for this handle */
+		timing->response_start = object->response_start;
+		timing->first_byte = object->first_byte;
+		timing->response_end = object->response_end;
+		timing->from_cache = false;
+	} else {
+		/* object was already present in the cache */
+		timing->response_start = handle->retrieved;
+		timing->first_byte = handle->retrieved;
+		timing->response_end = handle->retrieved;
+		timing->from_cache = true;
+	}
+
+	return NSERROR_OK;
+}
+
 /* See llcache.h for documentation */
 const uint8_t *llcache_handle_get_source_data(const llcache_handle *handle,
 		size_t *size)
@@ -32,6 +32,7 @@
 
 struct cert_chain;
 struct fetch_multipart_data;
+struct backing_store_stats;
 
 /** Handle for low-level cache object */
 typedef struct llcache_handle llcache_handle;
@@ -177,6 +178,50 @@ void llcache_finalise(void);
  */
 void llcache_clean(bool purge);
 
+/**
+ * Low-level cache statistics
+ */
+struct llcache_stats {
+	size_t limit; /**< target upper bound of the RAM cache size */
+	size_t size; /**< RAM currently used by cached objects */
+	unsigned int cached_count; /**< number of cacheable objects */
+	unsigned int uncached_count; /**< number of uncacheable objects */
+	unsigned int disc_count; /**< cacheable objects in backing store */
+
+	uint64_t hit_count; /**< retrievals of fresh objects */
+	uint64_t revalidate_count; /**< retrievals needing validation */
+	uint64_t miss_count; /**< retrievals needing a full fetch */
+
+	uint64_t evict_count; /**< cacheable objects discarded */
+	uint64_t evict_size; /**< size of cacheable objects discarded */
+
+	uint64_t blocked_count; /**< retrievals refused by content blocking */
+	uint64_t blocked_size; /**< estimated size of blocked objects */
+
+	uint64_t total_written; /**< bytes written to backing store */
+	uint64_t total_elapsed; /**< ms taken writing to backing store */
+	size_t minimum_bandwidth; /**< slowest permitted writeout rate */
+	size_t maximum_bandwidth; /**< fastest permitted writeout rate */
+};
+
+/**
+ * Get the low-level cache statistics
+ *
+ * \param stats Structure to fill with the statistics
+ * \return NSERROR_OK on success or NSERROR_INIT_FAILED if the cache
+ *         is not initialised.
+ */
+nserror llcache_get_stats(struct llcache_stats *stats);
+
+/**
+ * Get the backing store statistics
+ *
+ * \param stats Structure to fill with the statistics
+ * \return NSERROR_OK on success or NSERROR_NOT_IMPLEMENTED if the
+ *         backing store does not provide statistics.
+ */
+nserror llcache_get_store_stats(struct backing_store_stats *stats);
+
 /**
  * Retrieve a handle for a low-level cache object
  *
@@ -255,6 +300,33 @@ nserror llcache_handle_invalidate_cache_data(llcache_handle *handle);
  */
 nsurl *llcache_handle_get_url(const llcache_handle *handle);
 
+/**
+ * Times at which a low-level cache retrieval completed each phase.
+ *
+ * All times are in milliseconds from the monotonic clock. A time is
+ *  zero if the phase has not yet completed.
+ */
+struct llcache_timing {
+	uint64_t fetch_start; /**< retrieval requested */
+	uint64_t response_start; /**< first response header received */
+	uint64_t first_byte; /**< first source data received */
+	uint64_t response_end; /**< all source data received */
+	bool from_cache; /**< retrieval was satisfied without a fetch */
+};
+
+/**
+ * Retrieve the timing of the fetch behind a low-level cache handle
+ *
+ * If the object was already in the cache when the handle was retrieved
+ *  every phase is reported as completing at the time of retrieval.
+ *
+ * \param handle  Handle to retrieve timing from
+ * \param timing  Structure to fill with the times
+ * \return NSERROR_OK on success, appropriate error otherwise
+ */
+nserror llcache_handle_get_timing(const llcache_handle *handle,
+		struct llcache_timing *timing);
+
 /**
  * Retrieve source data of a low-level cache object
  *
@@ -322,6 +322,14 @@ static struct bloom_filter *url_bloom;
  */
 #define BLOOM_SIZE (1024 * 32)
 
+/**
+ * Visit data generation
+ *
+ * Incremented whenever any URL's visit data changes, so callers caching
+ * visited state can tell when their cache is stale.
+ */
+static unsigned int urldb_visit_generation;
+
 
 /**
  * write a time_t to a file portably
@@ -2872,6 +2880,8 @@ void urldb_destroy(void)
 		bloom_destroy(url_bloom);
 		url_bloom = NULL;
 	}
+
+	urldb_visit_generation++;
 }
 
 
@@ -3054,8 +3064,10 @@ nserror urldb_load(const char *filename)
 
 			if (!fgets(s, MAXIMUM_URL_LENGTH, fp))
 				break;
-			if (p)
+			if (p) {
 				p->urld.visits = (unsigned int)atoi(s);
+				urldb_visit_generation++;
+			}
 
 			/* entry last use time */
 			if (!fgets(s, MAXIMUM_URL_LENGTH, fp)) {
@@ -3287,6 +3299,7 @@ nserror urldb_update_url_visit_data(nsurl *url)
 
 	p->urld.last_visit = time(NULL);
 	p->urld.visits++;
+	urldb_visit_generation++;
 
 	return NSERROR_OK;
 }
@@ -3305,6 +3318,14 @@ void urldb_reset_url_visit_data(nsurl *url)
 
 	p->urld.last_visit = (time_t)0;
 	p->urld.visits = 0;
+	urldb_visit_generation++;
+}
+
+
+/* exported interface documented in content/urldb.h */
+unsigned int urldb_get_visit_generation(void)
+{
+	return urldb_visit_generation;
 }
 
 
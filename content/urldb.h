@@ -112,6 +112,17 @@ nserror urldb_update_url_visit_data(struct nsurl *url);
 void urldb_reset_url_visit_data(struct nsurl *url);
 
 
+/**
+ * Get the current visit data generation
+ *
+ * The generation changes whenever the visit data of any URL in the
+ * database changes.
+ *
+ * \return The visit data generation
+ */
+unsigned int urldb_get_visit_generation(void);
+
+
 /**
  * Extract an URL from the db
  *
@@ -255,6 +255,11 @@ struct browser_window {
 	/** Last time a link was followed in this window */
 	uint64_t last_action;
 
+	/** Time the fetch of the loading content was started */
+	uint64_t loading_start;
+	/** Time the fetch of the current content was started */
+	uint64_t current_start;
+
 	/** Current selection */
 	struct {
 		struct browser_window *bw;
@@ -826,6 +826,7 @@ static nserror browser_window_content_ready(struct browser_window *bw)
 
 	bw->current_content = bw->loading_content;
 	bw->loading_content = NULL;
+	bw->current_start = bw->loading_start;
 
 	if (!bw->internal_nav) {
 		/* Transfer the fetch parameters */
@@ -3552,6 +3553,8 @@ navigate_internal_real(struct browser_window *bw,
 		fetch_flags |= HLCACHE_RETRIEVE_MAY_DOWNLOAD;
 	}
 
+	nsu_getmonotonic_ms(&bw->loading_start);
+
 	res = hlcache_handle_retrieve(params->url,
 				      fetch_flags | HLCACHE_RETRIEVE_SNIFF_TYPE,
 				      params->referrer,
@@ -4743,6 +4746,23 @@ browser_window_get_ssl_chain(struct browser_window *bw,
 	return NSERROR_OK;
 }
 
+/* Exported interface, documented in browser_window.h */
+nserror
+browser_window_get_timing(struct browser_window *bw,
+			  uint64_t *start,
+			  struct content_timing *timing)
+{
+	assert(bw != NULL);
+
+	if (bw->current_content == NULL) {
+		return NSERROR_NOT_FOUND;
+	}
+
+	*start = bw->current_start;
+
+	return content_get_timing(bw->current_content, timing);
+}
+
 /* Exported interface, documented in browser_window.h */
 int browser_window_get_cookie_count(
 		const struct browser_window *bw)
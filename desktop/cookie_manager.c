@@ -759,6 +759,9 @@ static nserror cookie_manager_tree_node_folder_cb(
 
 	case TREE_MSG_NODE_LAUNCH:
 		break;
+
+	case TREE_MSG_NODE_EXPAND:
+		break;
 	}
 
 	return NSERROR_OK;
@@ -782,6 +785,9 @@ static nserror cookie_manager_tree_node_entry_cb(
 
 	case TREE_MSG_NODE_LAUNCH:
 		break;
+
+	case TREE_MSG_NODE_EXPAND:
+		break;
 	}
 	return NSERROR_OK;
 }
@@ -20,13 +20,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <nsutils/time.h>
 
+#include "netsurf/inttypes.h"
 #include "utils/messages.h"
 #include "utils/utils.h"
 #include "utils/utf8.h"
 #include "utils/libdom.h"
 #include "utils/log.h"
 #include "utils/nsurl.h"
+#include "utils/hashmap.h"
 #include "content/urldb.h"
 
 #include "desktop/global_history.h"
@@ -62,6 +65,7 @@ enum global_history_fields {
 struct global_history_folder {
 	treeview_node *folder;
 	struct treeview_field_data data;
+	bool populated; /**< Whether entry nodes have been created */
 };
 
 struct global_history_ctx {
@@ -88,6 +92,38 @@ struct global_history_entry {
 };
 struct global_history_entry *gh_list[N_DAYS];
 
+/** Global history entries, keyed by URL */
+static hashmap_t *gh_index = NULL;
+
+static uint32_t global_history_index_key_hash(void *key)
+{
+	return nsurl_hash((nsurl *)key);
+}
+
+static bool global_history_index_key_eq(void *key1, void *key2)
+{
+	return nsurl_compare((nsurl *)key1, (nsurl *)key2, NSURL_COMPLETE);
+}
+
+static void *global_history_index_value_alloc(void *key)
+{
+	return calloc(1, sizeof(struct global_history_entry *));
+}
+
+static void global_history_index_value_destroy(void *value)
+{
+	free(value);
+}
+
+static hashmap_parameters_t gh_index_parameters = {
+	.key_clone = (hashmap_key_clone_t)nsurl_ref,
+	.key_destroy = (hashmap_key_destroy_t)nsurl_unref,
+	.key_hash = global_history_index_key_hash,
+	.key_eq = global_history_index_key_eq,
+	.value_alloc = global_history_index_value_alloc,
+	.value_destroy = global_history_index_value_destroy,
+};
+
 
 /**
  * Find an entry in the global history
@@ -97,25 +133,38 @@ struct global_history_entry *gh_list[N_DAYS];
  */
 static struct global_history_entry *global_history_find(nsurl *url)
 {
-	int i;
-	struct global_history_entry *e;
+	struct global_history_entry **e;
 
-	for (i = 0; i < N_DAYS; i++) {
-		e = gh_list[i];
+	e = hashmap_lookup(gh_index, url);
+	if (e == NULL) {
+		/* No match found */
+		return NULL;
+	}
 
-		while (e != NULL) {
-			if (nsurl_compare(e->url, url,
-					NSURL_COMPLETE) == true) {
-				/* Got a match */
-				return e;
-			}
-			e = e->next;
-		}
+	return *e;
+}
 
-	}
 
-	/* No match found */
-	return NULL;
+/**
+ * Get the range of global history slots shown in a folder
+ *
+ * \param f		Ident for folder
+ * \param first	Updated to first slot in folder
+ * \param last		Updated to last slot in folder
+ */
+static void global_history_folder_slots(enum global_history_folders f,
+		int *first, int *last)
+{
+	if (f < GH_LAST_WEEK) {
+		*first = f;
+		*last = f;
+	} else {
+		*first = 7 * (f - GH_LAST_WEEK + 1);
+		*last = *first + 6;
+		if (*last >= N_DAYS) {
+			*last = N_DAYS - 1;
+		}
+	}
 }
 
 
@@ -191,6 +240,10 @@ static nserror global_history_create_dir(enum global_history_folders f)
 	gh_ctx.folders[f].data.field = gh_ctx.fields[N_FIELDS - 1].field;
 	gh_ctx.folders[f].data.value = label;
 	gh_ctx.folders[f].data.value_len = strlen(label);
+
+	/* Folders made while loading are filled when first needed;
+	 * any made later start empty. */
+	gh_ctx.folders[f].populated = gh_ctx.built;
 	err = treeview_create_node_folder(gh_ctx.tree,
 			&gh_ctx.folders[f].folder,
 			relation, rel,
@@ -198,7 +251,8 @@ static nserror global_history_create_dir(enum global_history_folders f)
 			&gh_ctx.folders[f],
 			gh_ctx.built ? TREE_OPTION_NONE :
 					TREE_OPTION_SUPPRESS_RESIZE |
-					TREE_OPTION_SUPPRESS_REDRAW);
+					TREE_OPTION_SUPPRESS_REDRAW |
+					TREE_OPTION_DEFERRED);
 
 	return err;
 }
@@ -208,11 +262,11 @@ static nserror global_history_create_dir(enum global_history_folders f)
  * Get the treeview folder for history entires in a particular slot
  *
  * \param parent	Updated to parent folder.
- * \param slot		Global history slot of entry we want folder node for
+ * \param slot		Global history slot of entry we want folder for
  * \return NSERROR_OK on success, appropriate error otherwise
  */
 static inline nserror global_history_get_parent_treeview_node(
-		treeview_node **parent, int slot)
+		struct global_history_folder **parent, int slot)
 {
 	int folder_index;
 	struct global_history_folder *f;
@@ -246,8 +300,8 @@ static inline nserror global_history_get_parent_treeview_node(
 		}
 	}
 
-	/* Return the parent treeview folder */
-	*parent = f->folder;
+	/* Return the parent folder */
+	*parent = f;
 	return NSERROR_OK;
 }
 
@@ -312,20 +366,27 @@ static nserror global_history_create_treeview_field_data(
  *
  * It is assumed that the entry is unique (for its URL) in the global
  * history table
+ *
+ * If the entry's folder has not been filled yet, no node is created;
+ * the entry will be added with the rest of the folder's contents.
  */
 static nserror global_history_entry_insert(struct global_history_entry *e,
 		int slot)
 {
 	nserror err;
 
-	treeview_node *parent;
+	struct global_history_folder *parent;
 	err = global_history_get_parent_treeview_node(&parent, slot);
 	if (err != NSERROR_OK) {
 		return err;
 	}
 
+	if (parent->populated == false) {
+		return NSERROR_OK;
+	}
+
 	err = treeview_create_node_entry(gh_ctx.tree, &(e->entry),
-			parent, TREE_REL_FIRST_CHILD, e->data, e,
+			parent->folder, TREE_REL_FIRST_CHILD, e->data, e,
 			gh_ctx.built ? TREE_OPTION_NONE :
 					TREE_OPTION_SUPPRESS_RESIZE |
 					TREE_OPTION_SUPPRESS_REDRAW);
@@ -357,6 +418,7 @@ static nserror global_history_add_entry_internal(nsurl *url, int slot,
 {
 	nserror err;
 	struct global_history_entry *e;
+	struct global_history_entry **index_entry;
 
 	/* Create new local history entry */
 	e = malloc(sizeof(struct global_history_entry));
@@ -364,6 +426,13 @@ static nserror global_history_add_entry_internal(nsurl *url, int slot,
 		return NSERROR_NOMEM;
 	}
 
+	index_entry = hashmap_insert(gh_index, url);
+	if (index_entry == NULL) {
+		free(e);
+		return NSERROR_NOMEM;
+	}
+	*index_entry = e;
+
 	e->user_delete = false;
 	e->slot = slot;
 	e->url = nsurl_ref(url);
@@ -449,6 +518,8 @@ static void global_history_delete_entry_internal(
 		e->next->prev = e->prev;
 	}
 
+	hashmap_remove(gh_index, e->url);
+
 	if (e->user_delete) {
 		/* User requested delete, so delete from urldb too. */
 		urldb_reset_url_visit_data(e->url);
@@ -500,9 +571,14 @@ static bool global_history_add_entry(nsurl *url,
 		/* Delete any existing entry for this URL */
 		e = global_history_find(url);
 		if (e != NULL) {
-			treeview_delete_node(gh_ctx.tree, e->entry,
-					TREE_OPTION_SUPPRESS_REDRAW |
-					TREE_OPTION_SUPPRESS_RESIZE);
+			if (e->entry != NULL) {
+				treeview_delete_node(gh_ctx.tree, e->entry,
+						TREE_OPTION_SUPPRESS_REDRAW |
+						TREE_OPTION_SUPPRESS_RESIZE);
+			} else {
+				/* Entry's folder not yet filled */
+				global_history_delete_entry_internal(e);
+			}
 		}
 	}
 
@@ -621,17 +697,60 @@ static nserror global_history_initialise_time(void)
 
 
 /**
- * Initialise the treeview entries
+ * Create the treeview folders for the loaded global history
+ *
+ * Only folders which have entries are made, along with the folder for
+ * today.  Their entries are not added until the folder is filled.
  *
  * \return NSERROR_OK on success, or appropriate error otherwise
  */
-static nserror global_history_init_entries(void)
+static nserror global_history_init_folders(void)
 {
-	int i;
+	int f;
 	nserror err;
 
-	/* Itterate over all global history data, inserting it into treeview */
-	for (i = 0; i < N_DAYS; i++) {
+	for (f = GH_TODAY; f < GH_N_FOLDERS; f++) {
+		int first, last, i;
+		bool empty = true;
+
+		global_history_folder_slots(f, &first, &last);
+		for (i = first; i <= last; i++) {
+			if (gh_list[i] != NULL) {
+				empty = false;
+				break;
+			}
+		}
+
+		if (empty && f != GH_TODAY) {
+			continue;
+		}
+
+		err = global_history_create_dir(f);
+		if (err != NSERROR_OK) {
+			return err;
+		}
+	}
+
+	return NSERROR_OK;
+}
+
+
+/**
+ * Add the treeview entries for a folder's global history slots
+ *
+ * \param f	Folder to fill
+ * \return NSERROR_OK on success, or appropriate error otherwise
+ */
+static nserror global_history_fill_folder(struct global_history_folder *f)
+{
+	int first, last, i;
+	nserror err;
+
+	f->populated = true;
+
+	global_history_folder_slots(f - gh_ctx.folders, &first, &last);
+
+	for (i = first; i <= last; i++) {
 		struct global_history_entry *l = NULL;
 		struct global_history_entry *e = gh_list[i];
 
@@ -643,9 +762,16 @@ static nserror global_history_init_entries(void)
 
 		/* Insert the entries into the treeview */
 		while (l != NULL) {
-			err = global_history_entry_insert(l, i);
-			if (err != NSERROR_OK) {
-				return err;
+			if (l->entry == NULL) {
+				err = treeview_create_node_entry(gh_ctx.tree,
+						&(l->entry), f->folder,
+						TREE_REL_FIRST_CHILD,
+						l->data, l,
+						TREE_OPTION_SUPPRESS_RESIZE |
+						TREE_OPTION_SUPPRESS_REDRAW);
+				if (err != NSERROR_OK) {
+					return err;
+				}
 			}
 			l = l->prev;
 		}
@@ -655,14 +781,40 @@ static nserror global_history_init_entries(void)
 }
 
 
+/**
+ * Delete the entries of a folder which was never filled
+ *
+ * \param f		Folder being deleted
+ * \param user	Whether the deletion was requested by the user
+ */
+static void global_history_empty_folder(struct global_history_folder *f,
+		bool user)
+{
+	int first, last, i;
+
+	global_history_folder_slots(f - gh_ctx.folders, &first, &last);
+
+	for (i = first; i <= last; i++) {
+		while (gh_list[i] != NULL) {
+			gh_list[i]->user_delete = user;
+			global_history_delete_entry_internal(gh_list[i]);
+		}
+	}
+}
+
+
 static nserror global_history_tree_node_folder_cb(
 		struct treeview_node_msg msg, void *data)
 {
 	struct global_history_folder *f = data;
+	nserror err = NSERROR_OK;
 
 	switch (msg.msg) {
 	case TREE_MSG_NODE_DELETE:
 		f->folder = NULL;
+		if (f->populated == false) {
+			global_history_empty_folder(f, msg.data.delete.user);
+		}
 		break;
 
 	case TREE_MSG_NODE_EDIT:
@@ -670,9 +822,13 @@ static nserror global_history_tree_node_folder_cb(
 
 	case TREE_MSG_NODE_LAUNCH:
 		break;
+
+	case TREE_MSG_NODE_EXPAND:
+		err = global_history_fill_folder(f);
+		break;
 	}
 
-	return NSERROR_OK;
+	return err;
 }
 
 static nserror
@@ -691,6 +847,9 @@ global_history_tree_node_entry_cb(struct treeview_node_msg msg, void *data)
 	case TREE_MSG_NODE_EDIT:
 		break;
 
+	case TREE_MSG_NODE_EXPAND:
+		break;
+
 	case TREE_MSG_NODE_LAUNCH:
 	{
 		struct browser_window *existing = NULL;
@@ -725,6 +884,8 @@ nserror global_history_init(struct core_window_callback_table *cw_t,
 		void *core_window_handle)
 {
 	nserror err;
+	uint64_t ms_before;
+	uint64_t ms_after;
 
 	err = treeview_init();
 	if (err != NSERROR_OK) {
@@ -733,6 +894,14 @@ nserror global_history_init(struct core_window_callback_table *cw_t,
 
 	NSLOG(netsurf, INFO, "Loading global history");
 
+	nsu_getmonotonic_ms(&ms_before);
+
+	gh_index = hashmap_create(&gh_index_parameters);
+	if (gh_index == NULL) {
+		gh_ctx.tree = NULL;
+		return NSERROR_NOMEM;
+	}
+
 	/* Init. global history treeview time */
 	err = global_history_initialise_time();
 	if (err != NSERROR_OK) {
@@ -761,14 +930,8 @@ nserror global_history_init(struct core_window_callback_table *cw_t,
 		return err;
 	}
 
-	/* Ensure there is a folder for today */
-	err = global_history_create_dir(GH_TODAY);
-	if (err != NSERROR_OK) {
-		return err;
-	}
-
-	/* Add the history to the treeview */
-	err = global_history_init_entries();
+	/* Add the history folders to the treeview */
+	err = global_history_init_folders();
 	if (err != NSERROR_OK) {
 		return err;
 	}
@@ -788,7 +951,11 @@ nserror global_history_init(struct core_window_callback_table *cw_t,
 	/* Inform client of window height */
 	treeview_get_height(gh_ctx.tree);
 
-	NSLOG(netsurf, INFO, "Loaded global history");
+	nsu_getmonotonic_ms(&ms_after);
+
+	NSLOG(netsurf, INFO,
+	      "Loaded global history (%"PRIsizet" entries) in %"PRIu64"ms",
+	      hashmap_count(gh_index), ms_after - ms_before);
 
 	return NSERROR_OK;
 }
@@ -808,6 +975,16 @@ nserror global_history_fini(void)
 	err = treeview_destroy(gh_ctx.tree);
 	gh_ctx.tree = NULL;
 
+	/* Free any entries which were not in the treeview */
+	for (i = 0; i < N_DAYS; i++) {
+		while (gh_list[i] != NULL) {
+			global_history_delete_entry_internal(gh_list[i]);
+		}
+	}
+
+	hashmap_destroy(gh_index);
+	gh_index = NULL;
+
 	/* Free global history treeview entry fields */
 	for (i = 0; i < N_FIELDS; i++)
 		if (gh_ctx.fields[i].field != NULL)
@@ -828,6 +1005,8 @@ nserror global_history_fini(void)
 nserror global_history_add(nsurl *url)
 {
 	const struct url_data *data;
+	uint64_t ms_before;
+	uint64_t ms_after;
 
 	/* If we don't have a global history at the moment, just return OK */
 	if (gh_ctx.tree == NULL)
@@ -840,8 +1019,14 @@ nserror global_history_add(nsurl *url)
 		return NSERROR_BAD_PARAMETER;
 	}
 
+	nsu_getmonotonic_ms(&ms_before);
+
 	global_history_add_entry(url, data);
 
+	nsu_getmonotonic_ms(&ms_after);
+	NSLOG(netsurf, DEBUG, "Added %s to global history in %"PRIu64"ms",
+	      nsurl_access(url), ms_after - ms_before);
+
 	return NSERROR_OK;
 }
 
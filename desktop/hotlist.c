@@ -523,6 +523,9 @@ static nserror hotlist_tree_node_folder_cb(
 
 	case TREE_MSG_NODE_LAUNCH:
 		break;
+
+	case TREE_MSG_NODE_EXPAND:
+		break;
 	}
 
 	return NSERROR_OK;
@@ -595,6 +598,9 @@ hotlist_tree_node_entry_cb(struct treeview_node_msg msg, void *data)
 		}
 		break;
 
+	case TREE_MSG_NODE_EXPAND:
+		break;
+
 	case TREE_MSG_NODE_LAUNCH:
 	{
 		struct browser_window *existing = NULL;
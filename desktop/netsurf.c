@@ -33,12 +33,15 @@
 #include "utils/nsoption.h"
 #include "utils/corestrings.h"
 #include "utils/log.h"
+#include "utils/trace.h"
+#include "utils/worker.h"
 #include "utils/string.h"
 #include "utils/utf8.h"
 #include "utils/messages.h"
 #include "utils/useragent.h"
 #include "content/content_factory.h"
 #include "content/fetchers.h"
+#include "content/blocklist.h"
 #include "content/hlcache.h"
 #include "content/mimesniff.h"
 #include "content/urldb.h"
@@ -132,6 +135,12 @@ nserror netsurf_init(const char *store_path)
 	signal(SIGPIPE, SIG_IGN);
 #endif
 
+	/* event tracing is optional so failure is not fatal */
+	nstrace_init(nsoption_charp(trace_file));
+
+	/* worker threads are optional so failure is not fatal */
+	worker_init(nsoption_uint(worker_threads));
+
 	/* corestrings init */
 	ret = corestrings_init();
 	if (ret != NSERROR_OK)
@@ -163,6 +172,12 @@ nserror netsurf_init(const char *store_path)
 	/* account for image cache use from total */
 	hlcache_parameters.llcache.limit -= image_cache_parameters.limit;
 
+	/* retained parsed stylesheets are 10% of total memory cache size */
+	hlcache_parameters.retain_limit = (hlcache_parameters.llcache.limit * 10) / 100;
+
+	/* account for retained stylesheets from total */
+	hlcache_parameters.llcache.limit -= hlcache_parameters.retain_limit;
+
 	/* set backing store target limit */
 	hlcache_parameters.llcache.store.limit = nsoption_uint(disc_cache_size);
 
@@ -203,6 +218,11 @@ nserror netsurf_init(const char *store_path)
 	ret = fetcher_init();
 	if (ret != NSERROR_OK)
 		return ret;
+
+	/* content blocking is optional so failure is not fatal */
+	if (nsoption_bool(block_advertisements)) {
+		blocklist_init(nsoption_charp(blocklist_file));
+	}
 	
 	/* Initialise the hlcache and allow it to init the llcache for us */
 	ret = hlcache_initialise(&hlcache_parameters);
@@ -248,8 +268,12 @@ void netsurf_exit(void)
 	NSLOG(netsurf, INFO, "Finalising high-level cache");
 	hlcache_finalise();
 
+	NSLOG(netsurf, INFO, "Finalising worker threads");
+	worker_fini();
+
 	NSLOG(netsurf, INFO, "Closing fetches");
 	fetcher_quit();
+	blocklist_fini();
 	/* Now the fetchers are done, our user-agent string can go */
 	free_user_agent_string();
 
@@ -275,6 +299,9 @@ void netsurf_exit(void)
 	if (dom_namespace_finalise() != DOM_NO_ERR) {
 		NSLOG(netsurf, WARNING, "Unable to finalise DOM namespace strings");
 	}
+	NSLOG(netsurf, INFO, "Finalising event tracing");
+	nstrace_finalise();
+
 	NSLOG(netsurf, INFO, "Remaining lwc strings:");
 	lwc_iterate_strings(netsurf_lwc_iterator, NULL);
 
@@ -104,6 +104,9 @@ NSOPTION_INTEGER(disc_cache_age, 28)
 /** Whether to block advertisements */
 NSOPTION_BOOL(block_advertisements, false)
 
+/** Filter list of requests to block when blocking advertisements */
+NSOPTION_STRING(blocklist_file, NULL)
+
 /** Disable website tracking, see	                
  * http://www.w3.org/Submission/2011/SUBM-web-tracking-protection-20110224/#dnt-uas */
 NSOPTION_BOOL(do_not_track, false)
@@ -126,6 +129,9 @@ NSOPTION_BOOL(enable_javascript, false)
 /** Maximum time (in seconds) to wait for a script to run */
 NSOPTION_INTEGER(script_timeout, 10)
 
+/** Number of worker threads compiling scripts, if built in, 0 for none */
+NSOPTION_UINT(worker_threads, 2)
+
 /** How many days to retain URL data for */
 NSOPTION_INTEGER(expire_url, 28)
 
@@ -289,3 +295,6 @@ NSOPTION_COLOUR(sys_colour_WindowText, 0x00000000)
 NSOPTION_STRING(log_filter, NETSURF_BUILTIN_LOG_FILTER)
 /** Filter for verbose logging */
 NSOPTION_STRING(verbose_filter, NETSURF_BUILTIN_VERBOSE_FILTER)
+
+/** File to write an event trace to, if tracing is built in */
+NSOPTION_STRING(trace_file, NULL)
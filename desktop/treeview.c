@@ -112,6 +112,7 @@ enum treeview_node_flags {
 	TV_NFLAGS_SELECTED = (1 << 1),	/**< Whether node is selected */
 	TV_NFLAGS_SPECIAL  = (1 << 2),	/**< Render as special node */
 	TV_NFLAGS_MATCHED  = (1 << 3),	/**< Whether node matches search */
+	TV_NFLAGS_DEFERRED = (1 << 4),	/**< Folder contents not created */
 };
 
 
@@ -126,6 +127,25 @@ enum treeview_target_pos {
 };
 
 
+/**
+ * Index of a node's children by display position
+ *
+ * Holds binary indexed (Fenwick) trees of the children's heights and
+ * row counts, so the position of a child within its parent, and the
+ * child at a position, are found in logarithmic time.  The index is
+ * rebuilt when children are added or removed, and updated in place
+ * when the height of a child changes.
+ */
+struct treeview_node_index {
+	bool valid;		/**< Whether index matches the children */
+	unsigned int count;	/**< Number of children indexed */
+	unsigned int alloc;	/**< Number of children space is allocated for */
+	treeview_node **child;	/**< Children in order */
+	int *height;		/**< Fenwick tree of child heights */
+	int *rows;		/**< Fenwick tree of child row counts */
+};
+
+
 /**
  * Treeview node
  */
@@ -134,8 +154,12 @@ struct treeview_node {
 	enum treeview_node_type type;	/**< Node type */
 
 	int height;	/**< Includes height of any descendants (pixels) */
+	int rows;	/**< Includes rows of any displayed descendants */
 	int inset;	/**< Node's inset depending on tree depth (pixels) */
 
+	struct treeview_node_index *index; /**< Child index, or NULL */
+	unsigned int index_pos;	/**< Position in parent's child index */
+
 	treeview_node *parent; /**< parent node */
 	treeview_node *prev_sib; /**< previous sibling node */
 	treeview_node *next_sib; /**< next sibling node */
@@ -247,6 +271,8 @@ struct treeview {
 
 	const struct treeview_callback_table *callbacks; /**< For node events */
 
+	unsigned int deferred; /**< Number of folders with deferred contents */
+
 	const struct core_window_callback_table *cw_t; /**< Window cb table */
 	struct core_window *cw_h; /**< Core window handle */
 };
@@ -524,6 +550,284 @@ static inline treeview_node * treeview_node_next(treeview_node *node, bool full)
 }
 
 
+/**
+ * Mark a node's child index as out of date
+ *
+ * Must be called whenever children are added to or removed from a node.
+ *
+ * \param node Node whose children have changed
+ */
+static inline void treeview_node_index_invalidate(treeview_node *node)
+{
+	if (node->index != NULL) {
+		node->index->valid = false;
+	}
+}
+
+
+/**
+ * Free a node's child index
+ *
+ * \param node Node to free index of
+ */
+static void treeview_node_index_free(treeview_node *node)
+{
+	if (node->index != NULL) {
+		free(node->index->child);
+		free(node->index->height);
+		free(node->index->rows);
+		free(node->index);
+		node->index = NULL;
+	}
+}
+
+
+/**
+ * Get an up to date child index for a node
+ *
+ * \param node Node to get index of children for
+ * \return the index, or NULL on memory exhaustion
+ */
+static struct treeview_node_index *
+treeview_node_index_get(treeview_node *node)
+{
+	struct treeview_node_index *index = node->index;
+	treeview_node *child;
+	unsigned int count = 0;
+	unsigned int pos;
+
+	if (index != NULL && index->valid) {
+		return index;
+	}
+
+	if (index == NULL) {
+		index = calloc(1, sizeof(struct treeview_node_index));
+		if (index == NULL) {
+			return NULL;
+		}
+		node->index = index;
+	}
+
+	for (child = node->children; child != NULL; child = child->next_sib) {
+		count++;
+	}
+
+	if (count > index->alloc) {
+		unsigned int alloc = (count < 8) ? 8 : count + count / 2;
+		treeview_node **c;
+		int *h;
+		int *r;
+
+		c = realloc(index->child, alloc * sizeof(*c));
+		if (c == NULL) {
+			return NULL;
+		}
+		index->child = c;
+
+		h = realloc(index->height, (alloc + 1) * sizeof(*h));
+		if (h == NULL) {
+			return NULL;
+		}
+		index->height = h;
+
+		r = realloc(index->rows, (alloc + 1) * sizeof(*r));
+		if (r == NULL) {
+			return NULL;
+		}
+		index->rows = r;
+
+		index->alloc = alloc;
+	}
+
+	/* Build the trees in linear time */
+	memset(index->height, 0, (count + 1) * sizeof(*index->height));
+	memset(index->rows, 0, (count + 1) * sizeof(*index->rows));
+
+	for (child = node->children, pos = 1;
+			child != NULL;
+			child = child->next_sib, pos++) {
+		unsigned int up = pos + (pos & -pos);
+
+		index->child[pos - 1] = child;
+		child->index_pos = pos - 1;
+
+		index->height[pos] += child->height;
+		index->rows[pos] += child->rows;
+		if (up <= count) {
+			index->height[up] += index->height[pos];
+			index->rows[up] += index->rows[pos];
+		}
+	}
+
+	index->count = count;
+	index->valid = true;
+
+	return index;
+}
+
+
+/**
+ * Change the height of a node
+ *
+ * Updates the node's entry in its parent's child index.  The caller is
+ * responsible for changing the heights of the node's ancestors.
+ *
+ * \param node   Node to change the height of
+ * \param height Change in height
+ * \param rows   Change in number of rows
+ */
+static inline void
+treeview_node_resize(treeview_node *node, int height, int rows)
+{
+	struct treeview_node_index *index;
+	unsigned int pos;
+
+	node->height += height;
+	node->rows += rows;
+
+	if (node->parent == NULL || node->parent->index == NULL ||
+			node->parent->index->valid == false) {
+		return;
+	}
+
+	index = node->parent->index;
+	for (pos = node->index_pos + 1; pos <= index->count;
+			pos += pos & -pos) {
+		index->height[pos] += height;
+		index->rows[pos] += rows;
+	}
+}
+
+
+/**
+ * Find the display position of a node relative to the top of the tree
+ *
+ * \param node Node to find position of
+ * \param y    Updated to the node's y offset
+ * \param row  Updated to the number of rows displayed above the node
+ */
+static void
+treeview_node_pos(const treeview_node *node, int *y, int *row)
+{
+	int node_y = 0;
+	int node_row = 0;
+
+	for (; node->parent != NULL; node = node->parent) {
+		treeview_node *parent = node->parent;
+		struct treeview_node_index *index;
+
+		index = treeview_node_index_get(parent);
+		if (index != NULL) {
+			unsigned int pos;
+
+			for (pos = node->index_pos; pos > 0;
+					pos -= pos & -pos) {
+				node_y += index->height[pos];
+				node_row += index->rows[pos];
+			}
+		} else {
+			const treeview_node *sib;
+
+			for (sib = node->prev_sib; sib != NULL;
+					sib = sib->prev_sib) {
+				node_y += sib->height;
+				node_row += sib->rows;
+			}
+		}
+
+		if (parent->type != TREE_NODE_ROOT) {
+			/* Parent's own line */
+			node_y += tree_g.line_height;
+			node_row++;
+		}
+	}
+
+	*y = node_y;
+	*row = node_row;
+}
+
+
+/**
+ * Find the displayed node at a position relative to the top of the tree
+ *
+ * \param tree   Treeview to look in
+ * \param target Target y offset
+ * \param y      Updated to the found node's y offset
+ * \param row    Updated to the number of rows displayed above the node
+ * \return node at target, or NULL if there is none
+ */
+static treeview_node *
+treeview_node_at(treeview *tree, int target, int *y, int *row)
+{
+	treeview_node *node = tree->root;
+	int node_y = 0;
+	int node_row = 0;
+
+	if (target < 0 || target >= node->height) {
+		return NULL;
+	}
+
+	while (true) {
+		struct treeview_node_index *index;
+		treeview_node *child;
+
+		if (node->type != TREE_NODE_ROOT) {
+			if (node->type == TREE_NODE_ENTRY ||
+					target < node_y + tree_g.line_height) {
+				break;
+			}
+			/* Below folder's own line */
+			node_y += tree_g.line_height;
+			node_row++;
+		}
+
+		if (!(node->flags & TV_NFLAGS_EXPANDED)) {
+			return NULL;
+		}
+
+		index = treeview_node_index_get(node);
+		if (index != NULL) {
+			unsigned int pos = 0;
+			unsigned int step = 1;
+
+			/* Find last child starting at or above target */
+			while (step * 2 <= index->count) {
+				step *= 2;
+			}
+			for (; step > 0; step /= 2) {
+				unsigned int next = pos + step;
+				if (next <= index->count &&
+						node_y + index->height[next] <=
+						target) {
+					pos = next;
+					node_y += index->height[pos];
+					node_row += index->rows[pos];
+				}
+			}
+			child = (pos < index->count) ?
+					index->child[pos] : NULL;
+		} else {
+			child = node->children;
+			while (child != NULL &&
+					node_y + child->height <= target) {
+				node_y += child->height;
+				node_row += child->rows;
+				child = child->next_sib;
+			}
+		}
+
+		if (child == NULL) {
+			return NULL;
+		}
+		node = child;
+	}
+
+	*y = node_y;
+	*row = node_row;
+	return node;
+}
+
+
 /**
  * Find node at given y-position
  *
@@ -533,25 +837,15 @@ static inline treeview_node * treeview_node_next(treeview_node *node, bool full)
  */
 static treeview_node * treeview_y_node(treeview *tree, int target_y)
 {
-	int y = treeview__get_search_height(tree);
-	treeview_node *n;
+	int y;
+	int row;
 
 	assert(tree != NULL);
 	assert(tree->root != NULL);
 
-	n = treeview_node_next(tree->root, false);
-
-	while (n != NULL) {
-		int h = (n->type == TREE_NODE_ENTRY) ?
-			n->height : tree_g.line_height;
-		if (target_y >= y && target_y < y + h)
-			return n;
-		y += h;
-
-		n = treeview_node_next(n, false);
-	}
-
-	return NULL;
+	return treeview_node_at(tree,
+			target_y - treeview__get_search_height(tree),
+			&y, &row);
 }
 
 
@@ -566,22 +860,15 @@ static int treeview_node_y(
 		const treeview *tree,
 		const treeview_node *node)
 {
-	treeview_node *n;
-	int y = treeview__get_search_height(tree);
+	int y;
+	int row;
 
 	assert(tree != NULL);
 	assert(tree->root != NULL);
 
-	n = treeview_node_next(tree->root, false);
+	treeview_node_pos(node, &y, &row);
 
-	while (n != NULL && n != node) {
-		y += (n->type == TREE_NODE_ENTRY) ?
-			n->height : tree_g.line_height;
-
-		n = treeview_node_next(n, false);
-	}
-
-	return y;
+	return y + treeview__get_search_height(tree);
 }
 
 
@@ -789,6 +1076,64 @@ static nserror treeview_walk_internal(
 }
 
 
+/**
+ * Have the client create the contents of a deferred folder.
+ *
+ * \param tree Treeview containing node
+ * \param node The folder node to fill
+ * \return NSERROR_OK on success else error code.
+ */
+static nserror treeview_node_populate(treeview *tree, treeview_node *node)
+{
+	struct treeview_node_msg msg;
+
+	if (!(node->flags & TV_NFLAGS_DEFERRED)) {
+		return NSERROR_OK;
+	}
+
+	node->flags &= ~TV_NFLAGS_DEFERRED;
+	tree->deferred--;
+
+	msg.msg = TREE_MSG_NODE_EXPAND;
+	return tree->callbacks->folder(msg, node->client_data);
+}
+
+
+/**
+ * Treewalk node callback for filling deferred folders.
+ */
+static nserror
+treeview_populate_walk_cb(treeview_node *n,
+			  void *ctx,
+			  bool *skip_children,
+			  bool *end)
+{
+	if (n->type != TREE_NODE_FOLDER) {
+		return NSERROR_OK;
+	}
+
+	return treeview_node_populate(ctx, n);
+}
+
+
+/**
+ * Have the client create the contents of every deferred folder.
+ *
+ * \param tree Treeview to fill
+ * \return NSERROR_OK on success else error code.
+ */
+static nserror treeview_populate(treeview *tree)
+{
+	if (tree->deferred == 0) {
+		return NSERROR_OK;
+	}
+
+	return treeview_walk_internal(tree, tree->root,
+			TREEVIEW_WALK_MODE_LOGICAL_COMPLETE, NULL,
+			treeview_populate_walk_cb, tree);
+}
+
+
 /**
  * Data used when doing a treeview walk for search.
  */
@@ -890,6 +1235,13 @@ static nserror treeview__search(
 		return NSERROR_OK;
 	}
 
+	if (len > 0) {
+		err = treeview_populate(tree);
+		if (err != NSERROR_OK) {
+			return err;
+		}
+	}
+
 	err = treeview_walk_internal(tree, tree->root,
 			TREEVIEW_WALK_MODE_LOGICAL_COMPLETE, NULL,
 			treeview__search_walk_cb, &sw);
@@ -1049,8 +1401,12 @@ static nserror treeview_create_node_root(treeview_node **root)
 	n->type = TREE_NODE_ROOT;
 
 	n->height = 0;
+	n->rows = 0;
 	n->inset = tree_g.window_padding - tree_g.step_width;
 
+	n->index = NULL;
+	n->index_pos = 0;
+
 	n->text.data = NULL;
 	n->text.len = 0;
 	n->text.width = 0;
@@ -1138,6 +1494,8 @@ treeview_insert_node(
 
 	assert(a->parent != NULL);
 
+	treeview_node_index_invalidate(a->parent);
+
 	a->inset = a->parent->inset + tree_g.step_width;
 	if (a->children != NULL) {
 		treeview_walk_internal(tree, a,
@@ -1147,6 +1505,7 @@ treeview_insert_node(
 
 	if (a->parent->flags & TV_NFLAGS_EXPANDED) {
 		int height = a->height;
+		int rows = a->rows;
 		/* Parent is expanded, so inserted node will be visible and
 		 * affect layout */
 		if (a->text.width == 0) {
@@ -1157,7 +1516,7 @@ treeview_insert_node(
 		}
 
 		do {
-			a->parent->height += height;
+			treeview_node_resize(a->parent, height, rows);
 			a = a->parent;
 		} while (a->parent != NULL);
 	}
@@ -1192,9 +1551,17 @@ treeview_create_node_folder(treeview *tree,
 
 	n->flags = (flags & TREE_OPTION_SPECIAL_DIR) ?
 		TV_NFLAGS_SPECIAL : TV_NFLAGS_NONE;
+	if (flags & TREE_OPTION_DEFERRED) {
+		n->flags |= TV_NFLAGS_DEFERRED;
+		tree->deferred++;
+	}
 	n->type = TREE_NODE_FOLDER;
 
 	n->height = tree_g.line_height;
+	n->rows = 1;
+
+	n->index = NULL;
+	n->index_pos = 0;
 
 	n->text.data = field->value;
 	n->text.len = field->value_len;
@@ -1391,6 +1758,10 @@ treeview_create_node_entry(treeview *tree,
 	n->type = TREE_NODE_ENTRY;
 
 	n->height = tree_g.line_height;
+	n->rows = 1;
+
+	n->index = NULL;
+	n->index_pos = 0;
 
 	assert(fields != NULL);
 	assert(fields[0].field != NULL);
@@ -1515,6 +1886,7 @@ treeview_walk(treeview *tree,
 		.ctx = ctx,
 		.type = type
 	};
+	nserror err;
 
 	assert(tree != NULL);
 	assert(tree->root != NULL);
@@ -1522,6 +1894,11 @@ treeview_walk(treeview *tree,
 	if (root == NULL)
 		root = tree->root;
 
+	err = treeview_populate(tree);
+	if (err != NSERROR_OK) {
+		return err;
+	}
+
 	return treeview_walk_internal(tree, root,
 			TREEVIEW_WALK_MODE_LOGICAL_COMPLETE,
 			(leave_cb != NULL) ? treeview_walk_bwd_cb : NULL,
@@ -1538,6 +1915,10 @@ treeview_walk(treeview *tree,
  */
 static inline bool treeview_unlink_node(treeview_node *n)
 {
+	if (n->parent != NULL) {
+		treeview_node_index_invalidate(n->parent);
+	}
+
 	/* Unlink node from tree */
 	if (n->parent != NULL && n->parent->children == n) {
 		/* Node is a first child */
@@ -1663,6 +2044,7 @@ static void treeview_edit_done(treeview *tree)
 struct treeview_node_delete {
 	treeview *tree;
 	int h_reduction;
+	int r_reduction;
 	bool user_interaction;
 };
 
@@ -1681,9 +2063,11 @@ treeview_delete_node_walk_cb(treeview_node *n, void *ctx, bool *end)
 
 	assert(n->children == NULL);
 
-	if (treeview_unlink_node(n))
+	if (treeview_unlink_node(n)) {
 		nd->h_reduction += (n->type == TREE_NODE_ENTRY) ?
 			n->height : tree_g.line_height;
+		nd->r_reduction++;
+	}
 
 	/* Handle any special treatment */
 	switch (n->type) {
@@ -1692,6 +2076,9 @@ treeview_delete_node_walk_cb(treeview_node *n, void *ctx, bool *end)
 		break;
 
 	case TREE_NODE_FOLDER:
+		if (n->flags & TV_NFLAGS_DEFERRED) {
+			nd->tree->deferred--;
+		}
 		nd->tree->callbacks->folder(msg, n->client_data);
 		break;
 
@@ -1709,6 +2096,7 @@ treeview_delete_node_walk_cb(treeview_node *n, void *ctx, bool *end)
 	}
 
 	/* Free the node */
+	treeview_node_index_free(n);
 	free(n);
 
 	return NSERROR_OK;
@@ -1743,6 +2131,7 @@ treeview_delete_node_internal(treeview *tree,
 	struct treeview_node_delete nd = {
 		.tree = tree,
 		.h_reduction = 0,
+		.r_reduction = 0,
 		.user_interaction = interaction
 	};
 
@@ -1769,7 +2158,7 @@ treeview_delete_node_internal(treeview *tree,
 	n = p;
 	/* Reduce ancestor heights */
 	while (n != NULL && n->flags & TV_NFLAGS_EXPANDED) {
-		n->height -= nd.h_reduction;
+		treeview_node_resize(n, -nd.h_reduction, -nd.r_reduction);
 		n = n->parent;
 	}
 
@@ -1806,6 +2195,7 @@ static nserror treeview_delete_empty_nodes(treeview *tree, bool interaction)
 	struct treeview_node_delete nd = {
 		.tree = tree,
 		.h_reduction = 0,
+		.r_reduction = 0,
 		.user_interaction = interaction
 	};
 
@@ -1830,7 +2220,8 @@ static nserror treeview_delete_empty_nodes(treeview *tree, bool interaction)
 			while (node->parent != NULL &&
 			       next_sibling == NULL) {
 				if (node->type == TREE_NODE_FOLDER &&
-				    node->children == NULL) {
+				    node->children == NULL &&
+				    !(node->flags & TV_NFLAGS_DEFERRED)) {
 					/* Delete node */
 					p = node->parent;
 					err = treeview_delete_node_walk_cb(
@@ -1843,10 +2234,13 @@ static nserror treeview_delete_empty_nodes(treeview *tree, bool interaction)
 					while (p != NULL &&
 					       p->flags &
 					       TV_NFLAGS_EXPANDED) {
-						p->height -= nd.h_reduction;
+						treeview_node_resize(p,
+							-nd.h_reduction,
+							-nd.r_reduction);
 						p = p->parent;
 					}
 					nd.h_reduction = 0;
+					nd.r_reduction = 0;
 				}
 				node = parent;
 				parent = node->parent;
@@ -1857,7 +2251,8 @@ static nserror treeview_delete_empty_nodes(treeview *tree, bool interaction)
 				break;
 
 			if (node->type == TREE_NODE_FOLDER &&
-			    node->children == NULL) {
+			    node->children == NULL &&
+			    !(node->flags & TV_NFLAGS_DEFERRED)) {
 				/* Delete node */
 				p = node->parent;
 				err = treeview_delete_node_walk_cb(
@@ -1869,10 +2264,13 @@ static nserror treeview_delete_empty_nodes(treeview *tree, bool interaction)
 				/* Reduce ancestor heights */
 				while (p != NULL &&
 				       p->flags & TV_NFLAGS_EXPANDED) {
-					p->height -= nd.h_reduction;
+					treeview_node_resize(p,
+						-nd.h_reduction,
+						-nd.r_reduction);
 					p = p->parent;
 				}
 				nd.h_reduction = 0;
+				nd.r_reduction = 0;
 			}
 			node = next_sibling;
 		}
@@ -2048,6 +2446,7 @@ treeview_create(treeview **tree,
 
 	(*tree)->callbacks = callbacks;
 	(*tree)->n_fields = n_fields - 1;
+	(*tree)->deferred = 0;
 
 	(*tree)->drag.type = TV_DRAG_NONE;
 	(*tree)->drag.start_node = NULL;
@@ -2171,6 +2570,7 @@ treeview_node_expand_internal(treeview *tree, treeview_node *node)
 	struct treeview_node_entry *e;
 	int additional_height_folders = 0;
 	int additional_height_entries = 0;
+	int additional_rows = 0;
 	int i;
 
 	assert(tree != NULL);
@@ -2184,6 +2584,10 @@ treeview_node_expand_internal(treeview *tree, treeview_node *node)
 
 	switch (node->type) {
 	case TREE_NODE_FOLDER:
+		if (treeview_node_populate(tree, node) != NSERROR_OK) {
+			NSLOG(netsurf, INFO, "Failed to fill deferred folder.");
+		}
+
 		child = node->children;
 		if (child == NULL) {
 			/* Allow expansion of empty folders */
@@ -2199,6 +2603,7 @@ treeview_node_expand_internal(treeview *tree, treeview_node *node)
 			}
 
 			additional_height_folders += child->height;
+			additional_rows += child->rows;
 
 			child = child->next_sib;
 		} while (child != NULL);
@@ -2239,8 +2644,8 @@ treeview_node_expand_internal(treeview *tree, treeview_node *node)
 	for (struct treeview_node *n = node;
 			(n != NULL) && (n->flags & TV_NFLAGS_EXPANDED);
 			n = n->parent) {
-		n->height += additional_height_entries +
-				additional_height_folders;
+		treeview_node_resize(n, additional_height_entries +
+				additional_height_folders, additional_rows);
 	}
 
 	if (tree->search.search &&
@@ -2298,6 +2703,7 @@ static nserror treeview_node_contract_cb(treeview_node *n, void *ctx, bool *end)
 	struct treeview_contract_data *data = ctx;
 	int h_reduction_folder = 0;
 	int h_reduction_entry = 0;
+	int r_reduction = 0;
 
 	assert(n != NULL);
 	assert(n->type != TREE_NODE_ROOT);
@@ -2314,6 +2720,7 @@ static nserror treeview_node_contract_cb(treeview_node *n, void *ctx, bool *end)
 	switch (n->type) {
 	case TREE_NODE_FOLDER:
 		h_reduction_folder = n->height - tree_g.line_height;
+		r_reduction = n->rows - 1;
 		break;
 
 	case TREE_NODE_ENTRY:
@@ -2329,7 +2736,9 @@ static nserror treeview_node_contract_cb(treeview_node *n, void *ctx, bool *end)
 	for (struct treeview_node *node = n;
 			(node != NULL) && (node->flags & TV_NFLAGS_EXPANDED);
 			node = node->parent) {
-		node->height -= h_reduction_folder + h_reduction_entry;
+		treeview_node_resize(node,
+				-(h_reduction_folder + h_reduction_entry),
+				-r_reduction);
 	}
 
 	if (data->tree->search.search) {
@@ -2549,6 +2958,7 @@ static void treeview_redraw_tree(
 	plot_font_style_t *infotext_style;
 	treeview_node *root = tree->root;
 	treeview_node *node = tree->root;
+	treeview_node *first = NULL;
 	int render_y = *render_y_in_out;
 	plot_font_style_t *text_style;
 	plot_style_t *bg_style;
@@ -2566,6 +2976,19 @@ static void treeview_redraw_tree(
 		sel_max = tree->drag.prev.y;
 	}
 
+	if (r->y0 > render_y) {
+		/* Skip straight to the first node in the clip region */
+		int first_y;
+		int first_row;
+
+		first = treeview_node_at(tree, r->y0 - render_y,
+				&first_y, &first_row);
+		if (first != NULL) {
+			render_y += first_y;
+			count = first_row;
+		}
+	}
+
 	while (node != NULL) {
 		struct treeview_node_entry *entry;
 		struct bitmap *furniture;
@@ -2577,7 +3000,10 @@ static void treeview_redraw_tree(
 		next = (node->flags & TV_NFLAGS_EXPANDED) ?
 			node->children : NULL;
 
-		if (next != NULL) {
+		if (first != NULL) {
+			node = first;
+			first = NULL;
+		} else if (next != NULL) {
 			/* down to children */
 			node = next;
 		} else {
@@ -3207,17 +3633,20 @@ treeview_node_selection_walk_cb(treeview_node *n,
 		if (n->flags & TV_NFLAGS_SELECTED) {
 			treeview_node *p = n->parent;
 			int h = 0;
+			int rows = 0;
 
 			if (n == sw->data.yank.fixed) {
 				break;
 			}
 
-			if (treeview_unlink_node(n))
+			if (treeview_unlink_node(n)) {
 				h = n->height;
+				rows = n->rows;
+			}
 
 			/* Reduce ancestor heights */
 			while (p != NULL && p->flags & TV_NFLAGS_EXPANDED) {
-				p->height -= h;
+				treeview_node_resize(p, -h, -rows);
 				p = p->parent;
 			}
 			if (sw->data.yank.prev == NULL) {
@@ -4869,9 +5298,29 @@ treeview_mouse_action(treeview *tree, browser_mouse_state mouse, int x, int y)
 			.search_height = search_height,
 		};
 
-		treeview_walk_internal(tree, tree->root,
-				TREEVIEW_WALK_MODE_DISPLAY, NULL,
-				treeview_node_mouse_action_cb, &ma);
+		if (tree->search.search == false) {
+			/* Go straight to the node under the mouse; the line
+			 * bottom belongs to the node above, as in the walk */
+			treeview_node *n;
+			bool skip_children;
+			bool end;
+			int node_y;
+			int row;
+
+			n = treeview_node_at(tree,
+					(y > search_height) ?
+						y - search_height - 1 : 0,
+					&node_y, &row);
+			if (n != NULL) {
+				ma.current_y += node_y;
+				treeview_node_mouse_action_cb(n, &ma,
+						&skip_children, &end);
+			}
+		} else {
+			treeview_walk_internal(tree, tree->root,
+					TREEVIEW_WALK_MODE_DISPLAY, NULL,
+					treeview_node_mouse_action_cb, &ma);
+		}
 	}
 }
 
@@ -65,7 +65,8 @@ typedef enum {
 	TREE_OPTION_NONE		= (0),		/* No flags set */
 	TREE_OPTION_SPECIAL_DIR		= (1 << 0),	/* Special folder */
 	TREE_OPTION_SUPPRESS_RESIZE	= (1 << 1),	/* Suppress callback */
-	TREE_OPTION_SUPPRESS_REDRAW	= (1 << 2)	/* Suppress callback */
+	TREE_OPTION_SUPPRESS_REDRAW	= (1 << 2),	/* Suppress callback */
+	TREE_OPTION_DEFERRED		= (1 << 3)	/* Folder filled on demand */
 } treeview_node_options_flags;
 
 /**
@@ -86,7 +87,8 @@ typedef enum {
 enum treeview_msg {
 	TREE_MSG_NODE_DELETE,		/**< Node to be deleted */
 	TREE_MSG_NODE_EDIT,		/**< Node to be edited */
-	TREE_MSG_NODE_LAUNCH		/**< Node to be launched */
+	TREE_MSG_NODE_LAUNCH,		/**< Node to be launched */
+	TREE_MSG_NODE_EXPAND		/**< Deferred folder to be filled */
 };
 
 
@@ -265,6 +267,11 @@ nserror treeview_get_relation(treeview *tree, treeview_node **relation,
  * Field name must match name past in treeview_create fields[N-1].
  *
  * If relation is NULL, will insert as child of root node.
+ *
+ * If flags contains TREE_OPTION_DEFERRED the folder's contents are not
+ * created by the client until they are needed. The client receives a
+ * TREE_MSG_NODE_EXPAND message for the folder when it is first
+ * expanded, searched or walked, and must then create its children.
  */
 nserror treeview_create_node_folder(treeview *tree,
 				    treeview_node **folder,
@@ -18,6 +18,8 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include <ft2build.h>
 #include FT_CACHE_H
@@ -41,6 +43,18 @@
 
 #define BOLD_WEIGHT 700
 
+/* number of font styles with cached glyphs */
+#define GLYPH_STYLE_COUNT 16
+
+/* characters below this are held in each style's direct mapped table */
+#define GLYPH_DIRECT_COUNT 128
+
+/* number of entries in the text run width cache */
+#define RUN_CACHE_SIZE 1024
+
+/* longest text run, in bytes, held in the run width cache */
+#define RUN_CACHE_MAX_LENGTH 32
+
 static FT_Library library; 
 static FTC_Manager ft_cmanager;
 static FTC_CMapCache ft_cmap_cache ;
@@ -75,6 +89,58 @@ enum fb_face_e {
 
 static fb_faceid_t *fb_faces[FB_FACE_COUNT];
 
+/* glyph cache for one face at one size */
+struct fb_glyph_style {
+	FTC_ScalerRec srec; /* scaler selecting the face and size */
+	bool cached[GLYPH_DIRECT_COUNT]; /* which direct glyphs are valid */
+	struct fb_glyph glyphs[GLYPH_DIRECT_COUNT]; /* direct mapped glyphs */
+	struct fb_glyph scratch; /* last glyph outside the direct table */
+};
+
+/* glyph caches in most recently used order */
+static struct fb_glyph_style *fb_glyph_styles[GLYPH_STYLE_COUNT];
+
+/* measured width of a short text run */
+struct fb_run {
+	FTC_FaceID face_id; /* face the run was measured in */
+	FT_UInt size; /* size the run was measured at */
+	FT_UInt res; /* resolution the run was measured at */
+	size_t length; /* length of text, zero if entry unused */
+	int width; /* width of the run in pixels */
+	char text[RUN_CACHE_MAX_LENGTH]; /* UTF-8 text of the run */
+};
+
+/* direct mapped text run width cache */
+static struct fb_run fb_run_cache[RUN_CACHE_SIZE];
+
+/* whether the glyph tables and the run width cache are used */
+static bool fb_font_cache_enabled;
+
+/* glyph and run cache statistics */
+static struct {
+	unsigned int glyph_hits;
+	unsigned int glyph_misses;
+	unsigned int run_hits;
+	unsigned int run_misses;
+} fb_font_stats;
+
+/**
+ * free a glyph cache and the glyph bitmaps it owns
+ */
+static void fb_glyph_style_free(struct fb_glyph_style *style)
+{
+	int i;
+
+	if (style == NULL)
+		return;
+
+	for (i = 0; i < GLYPH_DIRECT_COUNT; i++) {
+		if (style->cached[i])
+			free((void *)style->glyphs[i].bitmap);
+	}
+	free(style);
+}
+
 /**
  * map cache manager handle to face id
  */
@@ -303,6 +369,9 @@ bool fb_font_init(void)
 	}
 
         
+        /* glyph and run width caching may be disabled for comparison */
+        fb_font_cache_enabled = nsoption_bool(fb_font_glyphcache);
+
         /* set the default render mode */
         if (nsoption_bool(fb_font_monochrome) == true)
                 ft_load_type = FT_LOAD_MONOCHROME; /* faster but less pretty */
@@ -317,6 +386,18 @@ bool fb_font_finalise(void)
 {
 	int i, j;
 
+	NSLOG(netsurf, INFO,
+	      "Glyph cache %u hits %u misses, run cache %u hits %u misses",
+	      fb_font_stats.glyph_hits, fb_font_stats.glyph_misses,
+	      fb_font_stats.run_hits, fb_font_stats.run_misses);
+
+	for (i = 0; i < GLYPH_STYLE_COUNT; i++) {
+		fb_glyph_style_free(fb_glyph_styles[i]);
+		fb_glyph_styles[i] = NULL;
+	}
+	memset(fb_run_cache, 0, sizeof(fb_run_cache));
+	memset(&fb_font_stats, 0, sizeof(fb_font_stats));
+
         FTC_Manager_Done(ft_cmanager);
         FT_Done_FreeType(library);
 
@@ -398,29 +479,28 @@ static void fb_fill_scalar(const plot_font_style_t *fstyle, FTC_Scaler srec)
 	srec->x_res = srec->y_res = browser_get_dpi();
 }
 
-/* exported interface documented in framebuffer/freetype_font.h */
-FT_Glyph fb_getglyph(const plot_font_style_t *fstyle, uint32_t ucs4)
+/**
+ * look up a glyph in the freetype image cache
+ */
+static FT_Glyph fb_lookup_glyph(FTC_Scaler srec, uint32_t ucs4)
 {
         FT_UInt glyph_index;
-        FTC_ScalerRec srec;
         FT_Glyph glyph;
         FT_Error error;
-        fb_faceid_t *fb_face; 
+        fb_faceid_t *fb_face;
 
-        fb_fill_scalar(fstyle, &srec);
-
-        fb_face = (fb_faceid_t *)srec.face_id;
+        fb_face = (fb_faceid_t *)srec->face_id;
 
-        glyph_index = FTC_CMapCache_Lookup(ft_cmap_cache, srec.face_id,
+        glyph_index = FTC_CMapCache_Lookup(ft_cmap_cache, srec->face_id,
 			fb_face->cidx, ucs4);
 
-        error = FTC_ImageCache_LookupScaler(ft_image_cache, 
-                                            &srec, 
-                                            FT_LOAD_RENDER | 
-                                            FT_LOAD_FORCE_AUTOHINT | 
-                                            ft_load_type, 
-                                            glyph_index, 
-                                            &glyph, 
+        error = FTC_ImageCache_LookupScaler(ft_image_cache,
+                                            srec,
+                                            FT_LOAD_RENDER |
+                                            FT_LOAD_FORCE_AUTOHINT |
+                                            ft_load_type,
+                                            glyph_index,
+                                            &glyph,
                                             NULL);
 	if (error != 0)
 		return NULL;
@@ -428,6 +508,162 @@ FT_Glyph fb_getglyph(const plot_font_style_t *fstyle, uint32_t ucs4)
         return glyph;
 }
 
+/* exported interface documented in framebuffer/freetype_font.h */
+FT_Glyph fb_getglyph(const plot_font_style_t *fstyle, uint32_t ucs4)
+{
+        FTC_ScalerRec srec;
+
+        fb_fill_scalar(fstyle, &srec);
+
+        return fb_lookup_glyph(&srec, ucs4);
+}
+
+/**
+ * fill a glyph from a freetype glyph
+ *
+ * \param glyph The glyph to fill
+ * \param ftglyph The freetype glyph
+ * \param copy Whether to take a copy of the bitmap, which freetype may
+ *             discard at its next cache lookup
+ * \return true on success, false if the bitmap could not be copied
+ */
+static bool
+fb_glyph_fill(struct fb_glyph *glyph, FT_Glyph ftglyph, bool copy)
+{
+	FT_BitmapGlyph bglyph;
+	size_t size;
+	uint8_t *bitmap;
+
+	memset(glyph, 0, sizeof(*glyph));
+	glyph->advance = ftglyph->advance.x >> 16;
+
+	if (ftglyph->format != FT_GLYPH_FORMAT_BITMAP)
+		return true;
+
+	bglyph = (FT_BitmapGlyph)ftglyph;
+	glyph->left = bglyph->left;
+	glyph->top = bglyph->top;
+	glyph->width = bglyph->bitmap.width;
+	glyph->rows = bglyph->bitmap.rows;
+	glyph->pitch = bglyph->bitmap.pitch;
+	glyph->mono = (bglyph->bitmap.pixel_mode == FT_PIXEL_MODE_MONO);
+
+	if (copy == false) {
+		glyph->bitmap = bglyph->bitmap.buffer;
+		return true;
+	}
+
+	if (glyph->pitch < 0)
+		return false;
+
+	size = (size_t)glyph->pitch * glyph->rows;
+	if (size == 0)
+		return true;
+
+	bitmap = malloc(size);
+	if (bitmap == NULL)
+		return false;
+
+	memcpy(bitmap, bglyph->bitmap.buffer, size);
+	glyph->bitmap = bitmap;
+
+	return true;
+}
+
+/* exported interface documented in framebuffer/freetype_font.h */
+struct fb_glyph_style *fb_font_style(const plot_font_style_t *fstyle)
+{
+	struct fb_glyph_style *style;
+	FTC_ScalerRec srec;
+	int i;
+
+	fb_fill_scalar(fstyle, &srec);
+
+	for (i = 0; i < GLYPH_STYLE_COUNT; i++) {
+		style = fb_glyph_styles[i];
+		if (style == NULL)
+			break;
+
+		if (style->srec.face_id == srec.face_id &&
+		    style->srec.width == srec.width &&
+		    style->srec.height == srec.height &&
+		    style->srec.x_res == srec.x_res &&
+		    style->srec.y_res == srec.y_res) {
+			/* move to front */
+			memmove(&fb_glyph_styles[1], &fb_glyph_styles[0],
+				i * sizeof(fb_glyph_styles[0]));
+			fb_glyph_styles[0] = style;
+			return style;
+		}
+	}
+
+	style = calloc(1, sizeof(*style));
+	if (style == NULL)
+		return NULL;
+
+	style->srec = srec;
+
+	/* evict the least recently used style if full */
+	if (i == GLYPH_STYLE_COUNT) {
+		i--;
+		fb_glyph_style_free(fb_glyph_styles[i]);
+	}
+	memmove(&fb_glyph_styles[1], &fb_glyph_styles[0],
+		i * sizeof(fb_glyph_styles[0]));
+	fb_glyph_styles[0] = style;
+
+	return style;
+}
+
+/* exported interface documented in framebuffer/freetype_font.h */
+const struct fb_glyph *
+fb_font_style_glyph(struct fb_glyph_style *style, uint32_t ucs4)
+{
+	FT_Glyph ftglyph;
+
+	if (ucs4 < GLYPH_DIRECT_COUNT && style->cached[ucs4]) {
+		fb_font_stats.glyph_hits++;
+		return &style->glyphs[ucs4];
+	}
+
+	fb_font_stats.glyph_misses++;
+
+	ftglyph = fb_lookup_glyph(&style->srec, ucs4);
+	if (ftglyph == NULL)
+		return NULL;
+
+	if (fb_font_cache_enabled &&
+	    ucs4 < GLYPH_DIRECT_COUNT &&
+	    fb_glyph_fill(&style->glyphs[ucs4], ftglyph, true)) {
+		style->cached[ucs4] = true;
+		return &style->glyphs[ucs4];
+	}
+
+	fb_glyph_fill(&style->scratch, ftglyph, false);
+	return &style->scratch;
+}
+
+/**
+ * find the run width cache entry for a text run
+ */
+static struct fb_run *
+fb_run_find(const struct fb_glyph_style *style,
+	    const char *string,
+	    size_t length)
+{
+	uint32_t hash = 0x811c9dc5;
+	size_t i;
+
+	for (i = 0; i < length; i++) {
+		hash ^= (uint8_t)string[i];
+		hash *= 0x01000193;
+	}
+	hash ^= style->srec.width;
+	hash ^= (uint32_t)(uintptr_t)style->srec.face_id >> 4;
+
+	return &fb_run_cache[hash % RUN_CACHE_SIZE];
+}
+
 
 /* exported interface documented in framebuffer/freetype_font.h */
 nserror
@@ -437,19 +673,49 @@ fb_font_width(const plot_font_style_t *fstyle,
 {
         uint32_t ucs4;
         size_t nxtchr = 0;
-        FT_Glyph glyph;
+        const struct fb_glyph *glyph;
+        struct fb_glyph_style *style;
+        struct fb_run *run = NULL;
+
+        style = fb_font_style(fstyle);
+        if (style == NULL)
+                return NSERROR_NOMEM;
+
+        if (fb_font_cache_enabled && length <= RUN_CACHE_MAX_LENGTH) {
+                run = fb_run_find(style, string, length);
+                if (run->length == length &&
+                    run->face_id == style->srec.face_id &&
+                    run->size == style->srec.width &&
+                    run->res == style->srec.x_res &&
+                    memcmp(run->text, string, length) == 0) {
+                        fb_font_stats.run_hits++;
+                        *width = run->width;
+                        return NSERROR_OK;
+                }
+                fb_font_stats.run_misses++;
+        }
 
         *width = 0;
         while (nxtchr < length) {
                 ucs4 = utf8_to_ucs4(string + nxtchr, length - nxtchr);
                 nxtchr = utf8_next(string, length, nxtchr);
 
-                glyph = fb_getglyph(fstyle, ucs4);
+                glyph = fb_font_style_glyph(style, ucs4);
                 if (glyph == NULL)
                         continue;
 
-                *width += glyph->advance.x >> 16;
+                *width += glyph->advance;
+        }
+
+        if (run != NULL && length > 0) {
+                run->face_id = style->srec.face_id;
+                run->size = style->srec.width;
+                run->res = style->srec.x_res;
+                run->length = length;
+                run->width = *width;
+                memcpy(run->text, string, length);
         }
+
 	return NSERROR_OK;
 }
 
@@ -462,18 +728,25 @@ fb_font_position(const plot_font_style_t *fstyle,
 {
         uint32_t ucs4;
         size_t nxtchr = 0;
-        FT_Glyph glyph;
+        const struct fb_glyph *glyph;
+        struct fb_glyph_style *style;
         int prev_x = 0;
 
+        style = fb_font_style(fstyle);
+        if (style == NULL)
+                return NSERROR_NOMEM;
+
         *actual_x = 0;
         while (nxtchr < length) {
                 ucs4 = utf8_to_ucs4(string + nxtchr, length - nxtchr);
 
-                glyph = fb_getglyph(fstyle, ucs4);
-                if (glyph == NULL)
+                glyph = fb_font_style_glyph(style, ucs4);
+                if (glyph == NULL) {
+                        nxtchr = utf8_next(string, length, nxtchr);
                         continue;
+                }
 
-                *actual_x += glyph->advance.x >> 16;
+                *actual_x += glyph->advance;
                 if (*actual_x > x)
                         break;
 
@@ -521,22 +794,29 @@ fb_font_split(const plot_font_style_t *fstyle,
         size_t nxtchr = 0;
         int last_space_x = 0;
         int last_space_idx = 0;
-        FT_Glyph glyph;
+        const struct fb_glyph *glyph;
+        struct fb_glyph_style *style;
+
+        style = fb_font_style(fstyle);
+        if (style == NULL)
+                return NSERROR_NOMEM;
 
         *actual_x = 0;
         while (nxtchr < length) {
                 ucs4 = utf8_to_ucs4(string + nxtchr, length - nxtchr);
 
-                glyph = fb_getglyph(fstyle, ucs4);
-                if (glyph == NULL)
+                glyph = fb_font_style_glyph(style, ucs4);
+                if (glyph == NULL) {
+                        nxtchr = utf8_next(string, length, nxtchr);
                         continue;
+                }
 
                 if (ucs4 == 0x20) {
                         last_space_x = *actual_x;
                         last_space_idx = nxtchr;
                 }
 
-                *actual_x += glyph->advance.x >> 16;
+                *actual_x += glyph->advance;
                 if (*actual_x > x && last_space_idx != 0) {
                         /* string has exceeded available width and we've
                          * found a space; return previous space */
@@ -25,6 +25,46 @@
 
 extern int ft_load_type;
 
+/**
+ * Glyph rendered for a font style
+ */
+struct fb_glyph {
+	int advance; /**< horizontal advance in pixels */
+	int left; /**< offset from pen position to left of bitmap */
+	int top; /**< offset from baseline to top of bitmap */
+	int width; /**< bitmap width in pixels */
+	int rows; /**< bitmap height in pixels */
+	int pitch; /**< bytes per bitmap row */
+	bool mono; /**< bitmap has one bit per pixel, else eight */
+	const uint8_t *bitmap; /**< alpha mask or NULL if nothing to plot */
+};
+
+/**
+ * Glyph cache for a font style
+ */
+struct fb_glyph_style;
+
 FT_Glyph fb_getglyph(const plot_font_style_t *fstyle, uint32_t ucs4);
 
+/**
+ * Find the glyph cache for a font style.
+ *
+ * \param fstyle The font style
+ * \return The glyph cache or NULL on memory exhaustion
+ */
+struct fb_glyph_style *fb_font_style(const plot_font_style_t *fstyle);
+
+/**
+ * Get the rendered glyph for a character in a font style.
+ *
+ * ASCII glyphs are held by the style's glyph cache until the style is
+ * evicted. The glyph for any other character is only valid until the
+ * next call.
+ *
+ * \param style The glyph cache from fb_font_style()
+ * \param ucs4 The character
+ * \return The glyph or NULL if the character has no glyph
+ */
+const struct fb_glyph *fb_font_style_glyph(struct fb_glyph_style *style, uint32_t ucs4);
+
 #endif /* NETSURF_FB_FONT_FREETYPE_H */
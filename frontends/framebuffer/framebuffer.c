@@ -419,42 +419,44 @@ framebuffer_plot_text(const struct redraw_context *ctx,
 {
 	uint32_t ucs4;
 	size_t nxtchr = 0;
-	FT_Glyph glyph;
-	FT_BitmapGlyph bglyph;
+	const struct fb_glyph *glyph;
+	struct fb_glyph_style *style;
 	nsfb_bbox_t loc;
 
+	style = fb_font_style(fstyle);
+	if (style == NULL)
+		return NSERROR_NOMEM;
+
 	while (nxtchr < length) {
 		ucs4 = utf8_to_ucs4(text + nxtchr, length - nxtchr);
 		nxtchr = utf8_next(text, length, nxtchr);
 
-		glyph = fb_getglyph(fstyle, ucs4);
+		glyph = fb_font_style_glyph(style, ucs4);
 		if (glyph == NULL)
 			continue;
 
-		if (glyph->format == FT_GLYPH_FORMAT_BITMAP) {
-			bglyph = (FT_BitmapGlyph)glyph;
-
-			loc.x0 = x + bglyph->left;
-			loc.y0 = y - bglyph->top;
-			loc.x1 = loc.x0 + bglyph->bitmap.width;
-			loc.y1 = loc.y0 + bglyph->bitmap.rows;
+		if (glyph->bitmap != NULL) {
+			loc.x0 = x + glyph->left;
+			loc.y0 = y - glyph->top;
+			loc.x1 = loc.x0 + glyph->width;
+			loc.y1 = loc.y0 + glyph->rows;
 
 			/* now, draw to our target surface */
-			if (bglyph->bitmap.pixel_mode == FT_PIXEL_MODE_MONO) {
+			if (glyph->mono) {
 			    nsfb_plot_glyph1(nsfb,
 					     &loc,
-					     bglyph->bitmap.buffer,
-					     bglyph->bitmap.pitch,
+					     glyph->bitmap,
+					     glyph->pitch,
 					     fstyle->foreground);
 			} else {
 			    nsfb_plot_glyph8(nsfb,
 					     &loc,
-					     bglyph->bitmap.buffer,
-					     bglyph->bitmap.pitch,
+					     glyph->bitmap,
+					     glyph->pitch,
 					     fstyle->foreground);
 			}
 		}
-		x += glyph->advance.x >> 16;
+		x += glyph->advance;
 
 	}
 	return NSERROR_OK;
@@ -17,6 +17,7 @@
  */
 
 #include <stdint.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <getopt.h>
 #include <assert.h>
@@ -67,6 +68,15 @@ struct gui_window *input_window = NULL;
 struct gui_window *search_current_window;
 struct gui_window *window_list = NULL;
 
+/** Maximum number of disjoint rectangles in a browser widget damage region */
+#define FB_DAMAGE_RECTS 8
+
+/** Repainted pixel count and start of the period it covers */
+static struct {
+	uint64_t pixels;
+	uint64_t start_ms;
+} fb_repaint_stats;
+
 /* private data for browser user widget */
 struct browser_widget_s {
 	struct browser_window *bw; /**< The browser window connected to this gui window */
@@ -76,7 +86,11 @@ struct browser_widget_s {
 	bool redraw_required; /**< flag indicating the foreground loop
 			       * needs to redraw the browser widget.
 			       */
-	bbox_t redraw_box; /**< Area requiring redraw. */
+	int redraw_count; /**< Number of rectangles in redraw_rects */
+	bbox_t redraw_rects[FB_DAMAGE_RECTS]; /**< Disjoint areas requiring
+					       * redraw, relative to the
+					       * widget.
+					       */
 	bool pan_required; /**< flag indicating the foreground loop
 			    * needs to pan the window.
 			    */
@@ -124,24 +138,111 @@ static nserror fb_warn_user(const char *warning, const char *detail)
 	return NSERROR_OK;
 }
 
+static inline int fb_bbox_area(const bbox_t *box)
+{
+	return (box->x1 - box->x0) * (box->y1 - box->y0);
+}
+
+static inline void fb_bbox_union(bbox_t *box, const bbox_t *other)
+{
+	box->x0 = min(box->x0, other->x0);
+	box->y0 = min(box->y0, other->y0);
+	box->x1 = max(box->x1, other->x1);
+	box->y1 = max(box->y1, other->y1);
+}
+
+/**
+ * Decide if two damage rectangles should be repainted as one.
+ *
+ * Overlapping rectangles are always merged to keep the region
+ * disjoint. Others are merged when their union wastes little area,
+ * as one larger repaint is cheaper than two adjacent ones.
+ */
+static bool fb_damage_should_merge(const bbox_t *a, const bbox_t *b)
+{
+	bbox_t u = *a;
+
+	if (a->x0 < b->x1 && b->x0 < a->x1 &&
+	    a->y0 < b->y1 && b->y0 < a->y1) {
+		return true;
+	}
+
+	fb_bbox_union(&u, b);
+
+	return fb_bbox_area(&u) * 4 <= (fb_bbox_area(a) + fb_bbox_area(b)) * 5;
+}
+
+/**
+ * Add a rectangle to a browser widget's damage region.
+ *
+ * \param bwidget The browser widget
+ * \param box The damaged area, already clipped to the widget
+ */
+static void
+fb_damage_add(struct browser_widget_s *bwidget, const bbox_t *box)
+{
+	bbox_t rect = *box;
+	int idx;
+
+	/* absorb existing rectangles until none merge with the new one */
+	idx = 0;
+	while (idx < bwidget->redraw_count) {
+		if (fb_damage_should_merge(&bwidget->redraw_rects[idx], &rect)) {
+			fb_bbox_union(&rect, &bwidget->redraw_rects[idx]);
+			bwidget->redraw_rects[idx] =
+				bwidget->redraw_rects[--bwidget->redraw_count];
+			idx = 0;
+		} else {
+			idx++;
+		}
+	}
+
+	if (bwidget->redraw_count == FB_DAMAGE_RECTS) {
+		/* region is full, merge with the cheapest rectangle */
+		int best = 0;
+		int best_growth = INT_MAX;
+
+		for (idx = 0; idx < bwidget->redraw_count; idx++) {
+			bbox_t u = rect;
+			int growth;
+
+			fb_bbox_union(&u, &bwidget->redraw_rects[idx]);
+			growth = fb_bbox_area(&u) - fb_bbox_area(&rect) -
+				fb_bbox_area(&bwidget->redraw_rects[idx]);
+			if (growth < best_growth) {
+				best_growth = growth;
+				best = idx;
+			}
+		}
+
+		fb_bbox_union(&rect, &bwidget->redraw_rects[best]);
+		bwidget->redraw_rects[best] =
+			bwidget->redraw_rects[--bwidget->redraw_count];
+
+		/* the grown rectangle may now overlap others */
+		fb_damage_add(bwidget, &rect);
+		return;
+	}
+
+	bwidget->redraw_rects[bwidget->redraw_count++] = rect;
+}
+
 /* queue a redraw operation, co-ordinates are relative to the window */
 static void
 fb_queue_redraw(struct fbtk_widget_s *widget, int x0, int y0, int x1, int y1)
 {
 	struct browser_widget_s *bwidget = fbtk_get_userpw(widget);
+	bbox_t box;
 
-	bwidget->redraw_box.x0 = min(bwidget->redraw_box.x0, x0);
-	bwidget->redraw_box.y0 = min(bwidget->redraw_box.y0, y0);
-	bwidget->redraw_box.x1 = max(bwidget->redraw_box.x1, x1);
-	bwidget->redraw_box.y1 = max(bwidget->redraw_box.y1, y1);
+	box.x0 = x0;
+	box.y0 = y0;
+	box.x1 = x1;
+	box.y1 = y1;
 
-	if (fbtk_clip_to_widget(widget, &bwidget->redraw_box)) {
+	if (fbtk_clip_to_widget(widget, &box)) {
+		fb_damage_add(bwidget, &box);
 		bwidget->redraw_required = true;
 		fbtk_request_redraw(widget);
-	} else {
-		bwidget->redraw_box.y0 = bwidget->redraw_box.x0 = INT_MAX;
-		bwidget->redraw_box.y1 = bwidget->redraw_box.x1 = -(INT_MAX);
-		bwidget->redraw_required = false;
 	}
 }
 
@@ -220,6 +321,46 @@ widget_scroll_x(struct gui_window *gw, int x, bool abs)
 	fbtk_set_scroll_position(gw->hscroll, bwidget->scrollx + bwidget->panx);
 }
 
+/**
+ * Move part of the browser widget by copying framebuffer contents.
+ *
+ * Pending damage moves with the copied pixels, as the stale pixels it
+ * covers are carried along by the copy. The copied area is flushed
+ * immediately as it will not be repainted.
+ *
+ * \param widget The browser widget
+ * \param bwidget The browser widget private data
+ * \param srcbox The area to copy from, in absolute co-ordinates
+ * \param dstbox The area to copy to, in absolute co-ordinates
+ */
+static void
+fb_pan_copy(fbtk_widget_t *widget,
+	    struct browser_widget_s *bwidget,
+	    nsfb_bbox_t *srcbox,
+	    nsfb_bbox_t *dstbox)
+{
+	nsfb_t *nsfb = fbtk_get_nsfb(widget);
+	bbox_t damage[FB_DAMAGE_RECTS];
+	int count = bwidget->redraw_count;
+	int dx = dstbox->x0 - srcbox->x0;
+	int dy = dstbox->y0 - srcbox->y0;
+	int idx;
+
+	nsfb_claim(nsfb, dstbox);
+	nsfb_plot_copy(nsfb, srcbox, nsfb, dstbox);
+	nsfb_update(nsfb, dstbox);
+
+	memcpy(damage, bwidget->redraw_rects, count * sizeof(bbox_t));
+	bwidget->redraw_count = 0;
+	bwidget->redraw_required = false;
+
+	for (idx = 0; idx < count; idx++) {
+		fb_queue_redraw(widget,
+				damage[idx].x0 + dx, damage[idx].y0 + dy,
+				damage[idx].x1 + dx, damage[idx].y1 + dy);
+	}
+}
+
 static void
 fb_pan(fbtk_widget_t *widget,
        struct browser_widget_s *bwidget,
@@ -232,8 +373,6 @@ fb_pan(fbtk_widget_t *widget,
 	nsfb_bbox_t srcbox;
 	nsfb_bbox_t dstbox;
 
-	nsfb_t *nsfb = fbtk_get_nsfb(widget);
-
 	height = fbtk_get_height(widget);
 	width = fbtk_get_width(widget);
 
@@ -271,7 +410,7 @@ fb_pan(fbtk_widget_t *widget,
 		dstbox.y1 = dstbox.y0 + height + bwidget->pany;
 
 		/* move part that remains visible up */
-		nsfb_plot_copy(nsfb, &srcbox, nsfb, &dstbox);
+		fb_pan_copy(widget, bwidget, &srcbox, &dstbox);
 
 		/* redraw newly exposed area */
 		bwidget->scrolly += bwidget->pany;
@@ -290,7 +429,7 @@ fb_pan(fbtk_widget_t *widget,
 		dstbox.y1 = dstbox.y0 + height - bwidget->pany;
 
 		/* move part that remains visible down */
-		nsfb_plot_copy(nsfb, &srcbox, nsfb, &dstbox);
+		fb_pan_copy(widget, bwidget, &srcbox, &dstbox);
 
 		/* redraw newly exposed area */
 		bwidget->scrolly += bwidget->pany;
@@ -311,7 +450,7 @@ fb_pan(fbtk_widget_t *widget,
 		dstbox.y1 = dstbox.y0 + height;
 
 		/* move part that remains visible left */
-		nsfb_plot_copy(nsfb, &srcbox, nsfb, &dstbox);
+		fb_pan_copy(widget, bwidget, &srcbox, &dstbox);
 
 		/* redraw newly exposed area */
 		bwidget->scrollx += bwidget->panx;
@@ -330,7 +469,7 @@ fb_pan(fbtk_widget_t *widget,
 		dstbox.y1 = dstbox.y0 + height;
 
 		/* move part that remains visible right */
-		nsfb_plot_copy(nsfb, &srcbox, nsfb, &dstbox);
+		fb_pan_copy(widget, bwidget, &srcbox, &dstbox);
 
 		/* redraw newly exposed area */
 		bwidget->scrollx += bwidget->panx;
@@ -343,6 +482,29 @@ fb_pan(fbtk_widget_t *widget,
 	bwidget->pany = 0;
 }
 
+/**
+ * Account for repainted pixels and periodically log the repaint rate.
+ *
+ * \param pixels The number of pixels just repainted
+ */
+static void fb_repaint_account(int pixels)
+{
+	uint64_t now;
+
+	fb_repaint_stats.pixels += pixels;
+
+	nsu_getmonotonic_ms(&now);
+	if (fb_repaint_stats.start_ms == 0) {
+		fb_repaint_stats.start_ms = now;
+	} else if ((now - fb_repaint_stats.start_ms) >= 1000) {
+		NSLOG(netsurf, INFO, "Repainted %"PRIu64" pixels per second",
+		      (fb_repaint_stats.pixels * 1000) /
+		      (now - fb_repaint_stats.start_ms));
+		fb_repaint_stats.pixels = 0;
+		fb_repaint_stats.start_ms = now;
+	}
+}
+
 static void
 fb_redraw(fbtk_widget_t *widget,
 	  struct browser_widget_s *bwidget,
@@ -350,7 +512,10 @@ fb_redraw(fbtk_widget_t *widget,
 {
 	int x;
 	int y;
+	int idx;
 	int caret_x, caret_y, caret_h;
+	bool caret;
+	nsfb_bbox_t redraw_box;
 	struct rect clip;
 	struct redraw_context ctx = {
 		.interactive = true,
@@ -362,46 +527,51 @@ fb_redraw(fbtk_widget_t *widget,
 	x = fbtk_get_absx(widget);
 	y = fbtk_get_absy(widget);
 
-	/* adjust clipping co-ordinates according to window location */
-	bwidget->redraw_box.y0 += y;
-	bwidget->redraw_box.y1 += y;
-	bwidget->redraw_box.x0 += x;
-	bwidget->redraw_box.x1 += x;
+	caret = fbtk_get_caret(widget, &caret_x, &caret_y, &caret_h);
 
-	nsfb_claim(nsfb, &bwidget->redraw_box);
+	for (idx = 0; idx < bwidget->redraw_count; idx++) {
+		/* adjust clipping co-ordinates according to window location */
+		redraw_box.x0 = bwidget->redraw_rects[idx].x0 + x;
+		redraw_box.y0 = bwidget->redraw_rects[idx].y0 + y;
+		redraw_box.x1 = bwidget->redraw_rects[idx].x1 + x;
+		redraw_box.y1 = bwidget->redraw_rects[idx].y1 + y;
 
-	/* redraw bounding box is relative to window */
-	clip.x0 = bwidget->redraw_box.x0;
-	clip.y0 = bwidget->redraw_box.y0;
-	clip.x1 = bwidget->redraw_box.x1;
-	clip.y1 = bwidget->redraw_box.y1;
+		nsfb_claim(nsfb, &redraw_box);
 
-	browser_window_redraw(bw,
-			x - bwidget->scrollx,
-			y - bwidget->scrolly,
-			&clip, &ctx);
+		/* redraw bounding box is relative to window */
+		clip.x0 = redraw_box.x0;
+		clip.y0 = redraw_box.y0;
+		clip.x1 = redraw_box.x1;
+		clip.y1 = redraw_box.y1;
 
-	if (fbtk_get_caret(widget, &caret_x, &caret_y, &caret_h)) {
-		/* This widget has caret, so render it */
-		nsfb_bbox_t line;
-		nsfb_plot_pen_t pen;
+		browser_window_redraw(bw,
+				x - bwidget->scrollx,
+				y - bwidget->scrolly,
+				&clip, &ctx);
 
-		line.x0 = x - bwidget->scrollx + caret_x;
-		line.y0 = y - bwidget->scrolly + caret_y;
-		line.x1 = x - bwidget->scrollx + caret_x;
-		line.y1 = y - bwidget->scrolly + caret_y + caret_h;
+		if (caret) {
+			/* This widget has caret, so render it */
+			nsfb_bbox_t line;
+			nsfb_plot_pen_t pen;
 
-		pen.stroke_type = NFSB_PLOT_OPTYPE_SOLID;
-		pen.stroke_width = 1;
-		pen.stroke_colour = 0xFF0000FF;
+			line.x0 = x - bwidget->scrollx + caret_x;
+			line.y0 = y - bwidget->scrolly + caret_y;
+			line.x1 = x - bwidget->scrollx + caret_x;
+			line.y1 = y - bwidget->scrolly + caret_y + caret_h;
 
-		nsfb_plot_line(nsfb, &line, &pen);
-	}
+			pen.stroke_type = NFSB_PLOT_OPTYPE_SOLID;
+			pen.stroke_width = 1;
+			pen.stroke_colour = 0xFF0000FF;
 
-	nsfb_update(fbtk_get_nsfb(widget), &bwidget->redraw_box);
+			nsfb_plot_line(nsfb, &line, &pen);
+		}
+
+		nsfb_update(nsfb, &redraw_box);
+
+		fb_repaint_account(fb_bbox_area(&redraw_box));
+	}
 
-	bwidget->redraw_box.y0 = bwidget->redraw_box.x0 = INT_MAX;
-	bwidget->redraw_box.y1 = bwidget->redraw_box.x1 = INT_MIN;
+	bwidget->redraw_count = 0;
 	bwidget->redraw_required = false;
 }
 
@@ -425,10 +595,11 @@ fb_browser_window_redraw(fbtk_widget_t *widget, fbtk_callback_info *cbi)
 	if (bwidget->redraw_required) {
 		fb_redraw(widget, bwidget, gw->bw);
 	} else {
-		bwidget->redraw_box.x0 = 0;
-		bwidget->redraw_box.y0 = 0;
-		bwidget->redraw_box.x1 = fbtk_get_width(widget);
-		bwidget->redraw_box.y1 = fbtk_get_height(widget);
+		bwidget->redraw_count = 1;
+		bwidget->redraw_rects[0].x0 = 0;
+		bwidget->redraw_rects[0].y0 = 0;
+		bwidget->redraw_rects[0].x1 = fbtk_get_width(widget);
+		bwidget->redraw_rects[0].y1 = fbtk_get_height(widget);
 		fb_redraw(widget, bwidget, gw->bw);
 	}
 	return 0;
@@ -48,6 +48,8 @@ NSOPTION_BOOL(fb_osk, false)
 NSOPTION_BOOL(fb_font_monochrome, false)
 /** size of font glyph cache in kilobytes. */
 NSOPTION_INTEGER(fb_font_cachesize, 2048)
+/** cache ASCII glyphs per font style and the widths of short runs */
+NSOPTION_BOOL(fb_font_glyphcache, true)
 
 /* Font face paths. These are treated as absolute paths if they start
  * with a / otherwise the compile time resource path is searched. 
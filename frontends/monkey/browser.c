@@ -27,7 +27,9 @@
 #include "utils/log.h"
 #include "utils/messages.h"
 #include "utils/nsurl.h"
+#include "netsurf/inttypes.h"
 #include "netsurf/mouse.h"
+#include "netsurf/content.h"
 #include "netsurf/window.h"
 #include "netsurf/browser_window.h"
 #include "netsurf/plotters.h"
@@ -697,6 +699,86 @@ monkey_window_handle_click(int argc, char **argv)
 	}
 }
 
+static void
+monkey_window_handle_scroll(int argc, char **argv)
+{
+	/* `WINDOW SCROLL WIN` _%id%_ `X` _%num%_ `Y` _%num%_ */
+	/*  0      1      2    3       4  5        6  7       */
+	struct gui_window *gw;
+	if (argc != 8) {
+		moutf(MOUT_ERROR, "WINDOW SCROLL ARGS BAD\n");
+		return;
+	}
+
+	gw = monkey_find_window_by_num(atoi(argv[3]));
+
+	if (gw == NULL) {
+		moutf(MOUT_ERROR, "WINDOW NUM BAD");
+	} else {
+		gw->scrollx = atoi(argv[5]);
+		gw->scrolly = atoi(argv[7]);
+	}
+}
+
+/**
+ * Get the time a load phase completed relative to the navigation start
+ *
+ * \return time in ms or -1 if the phase has not completed
+ */
+static int64_t monkey_timing_phase(uint64_t start, uint64_t at)
+{
+	if (at == 0) {
+		return -1;
+	}
+	return (int64_t)(at - start);
+}
+
+static void
+monkey_window_handle_timing(int argc, char **argv)
+{
+	/* `WINDOW TIMING WIN` _%id%_ */
+	/*  0      1      2    3      */
+	struct gui_window *gw;
+	struct content_timing timing;
+	uint64_t start;
+
+	if (argc != 4) {
+		moutf(MOUT_ERROR, "WINDOW TIMING ARGS BAD\n");
+		return;
+	}
+
+	gw = monkey_find_window_by_num(atoi(argv[3]));
+
+	if (gw == NULL) {
+		moutf(MOUT_ERROR, "WINDOW NUM BAD");
+		return;
+	}
+
+	if (browser_window_get_timing(gw->bw, &start, &timing) != NSERROR_OK) {
+		moutf(MOUT_WINDOW, "TIMING WIN %u NONE", gw->win_num);
+		return;
+	}
+
+	moutf(MOUT_WINDOW,
+	      "TIMING WIN %u REQUEST %"PRId64" HEADERS %"PRId64
+	      " FIRSTBYTE %"PRId64" RESPONSE %"PRId64" FETCH %"PRId64
+	      " PARSE %"PRId64" DOMCONTENTLOADED %"PRId64" LOAD %"PRId64
+	      " BOX %"PRId64" LAYOUT %"PRId64" DONE %"PRId64" REDRAW %"PRId64,
+	      gw->win_num,
+	      monkey_timing_phase(start, timing.fetch_start),
+	      monkey_timing_phase(start, timing.response_start),
+	      monkey_timing_phase(start, timing.first_byte),
+	      monkey_timing_phase(start, timing.created),
+	      monkey_timing_phase(start, timing.fetched),
+	      monkey_timing_phase(start, timing.parsed),
+	      monkey_timing_phase(start, timing.dom_content_loaded),
+	      monkey_timing_phase(start, timing.load_event),
+	      monkey_timing_phase(start, timing.constructed),
+	      monkey_timing_phase(start, timing.laid_out),
+	      monkey_timing_phase(start, timing.done),
+	      monkey_timing_phase(start, timing.redrawn));
+}
+
 void
 monkey_window_handle_command(int argc, char **argv)
 {
@@ -719,6 +801,10 @@ monkey_window_handle_command(int argc, char **argv)
 		monkey_window_handle_exec(argc, argv);
 	} else if (strcmp(argv[1], "CLICK") == 0) {
 		monkey_window_handle_click(argc, argv);
+	} else if (strcmp(argv[1], "SCROLL") == 0) {
+		monkey_window_handle_scroll(argc, argv);
+	} else if (strcmp(argv[1], "TIMING") == 0) {
+		monkey_window_handle_timing(argc, argv);
 	} else {
 		moutf(MOUT_ERROR, "WINDOW COMMAND UNKNOWN %s\n", argv[1]);
 	}
@@ -25,8 +25,10 @@
 #include <string.h>
 #include <errno.h>
 #include <signal.h>
+#include <nsutils/time.h>
 
 #include "utils/config.h"
+#include "netsurf/inttypes.h"
 #include "utils/sys_time.h"
 #include "utils/log.h"
 #include "utils/messages.h"
@@ -381,6 +383,8 @@ main(int argc, char **argv)
 	char *options;
 	char buf[PATH_MAX];
 	nserror ret;
+	uint64_t start; /* time monkey started */
+	uint64_t now;
 	struct netsurf_table monkey_table = {
 		.misc = &monkey_misc_table,
 		.window = monkey_window_table,
@@ -391,6 +395,8 @@ main(int argc, char **argv)
                 .llcache = filesystem_llcache_table,
 	};
 
+	nsu_getmonotonic_ms(&start);
+
 #if (!defined(NDEBUG) && defined(HAVE_EXECINFO))
 	/* Catch segfault, illegal instructions and fp exceptions */
 	signal(SIGSEGV, signal_handler);
@@ -428,10 +434,15 @@ main(int argc, char **argv)
 	free(options);
 	nsoption_commandline(&argc, argv, nsoptions);
 
-	messages = filepath_find(respaths, "Messages");
-	ret = messages_add_from_file(messages);
-	if (ret != NSERROR_OK) {
-		NSLOG(netsurf, INFO, "Messages failed to load");
+	/* builtin messages need no file to be loaded */
+	if (messages_builtin(get_languagev()[0])) {
+		messages = NULL;
+	} else {
+		messages = filepath_find(respaths, "Messages");
+		ret = messages_add_from_file(messages);
+		if (ret != NSERROR_OK) {
+			NSLOG(netsurf, INFO, "Messages failed to load");
+		}
 	}
 
 	/* common initialisation */
@@ -474,7 +485,8 @@ main(int argc, char **argv)
 	}
 
 
-	moutf(MOUT_GENERIC, "STARTED");
+	nsu_getmonotonic_ms(&now);
+	moutf(MOUT_GENERIC, "STARTED %"PRIu64, now - start);
 	monkey_run();
 
 	moutf(MOUT_GENERIC, "CLOSING_DOWN");
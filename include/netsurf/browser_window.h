@@ -26,6 +26,7 @@
 #define NETSURF_BROWSER_WINDOW_H_
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 #include "utils/errors.h"
@@ -43,6 +44,7 @@ struct nsurl;
 struct rect;
 struct redraw_context;
 struct cert_chain;
+struct content_timing;
 enum content_debug;
 
 /**
@@ -781,6 +783,18 @@ browser_window_page_info_state browser_window_get_page_info_state(
  */
 nserror browser_window_get_ssl_chain(struct browser_window *bw, struct cert_chain **chain);
 
+/**
+ * Request the load phase timings of the current page.
+ *
+ * \param bw      The browser window
+ * \param start   Updated with the time, in monotonic milliseconds, at
+ *                which the navigation that loaded the page started
+ * \param timing  Updated with the times the page completed each phase
+ *                of loading
+ * \return NSERROR_OK on success or NSERROR_NOT_FOUND if there is no page
+ */
+nserror browser_window_get_timing(struct browser_window *bw, uint64_t *start, struct content_timing *timing);
+
 /**
  * Get the number of cookies in use for the current page.
  *
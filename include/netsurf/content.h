@@ -59,6 +59,28 @@ struct content_redraw_data {
 	bool repeat_y; /**< whether content is tiled in y direction */
 };
 
+/**
+ * Times at which a content completed each phase of loading.
+ *
+ * All times are in milliseconds from the same monotonic clock. A time
+ *  is zero if the phase has not yet completed or does not apply to the
+ *  type of content.
+ */
+struct content_timing {
+	uint64_t fetch_start; /**< source data requested */
+	uint64_t response_start; /**< first response header received */
+	uint64_t first_byte; /**< first source data received */
+	uint64_t created; /**< response received and content created */
+	uint64_t fetched; /**< all source data received */
+	uint64_t parsed; /**< source data parsed */
+	uint64_t dom_content_loaded; /**< document parsed and scripts run */
+	uint64_t load_event; /**< load event dispatched */
+	uint64_t constructed; /**< box tree constructed */
+	uint64_t laid_out; /**< first layout completed */
+	uint64_t done; /**< content and all its objects loaded */
+	uint64_t redrawn; /**< first redraw completed */
+};
+
 /**
  * Retrieve the bitmap contained in an image content
  *
@@ -179,6 +201,17 @@ bool content_redraw(struct hlcache_handle *h, struct content_redraw_data *data,
 bool content_scaled_redraw(struct hlcache_handle *h, int width, int height, const struct redraw_context *ctx);
 
 
+/**
+ * Retrieve the times at which a content completed each phase of loading.
+ *
+ * \param h       handle to the content.
+ * \param timing  updated with the phase completion times.
+ * \return NSERROR_OK on success or NSERROR_BAD_PARAMETER if there is
+ *         no content.
+ */
+nserror content_get_timing(struct hlcache_handle *h, struct content_timing *timing);
+
+
 /**
  * Retrieve the URL associated with a high level cache handle
  *
@@ -0,0 +1,277 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Test content blocking filter list matching.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <check.h>
+
+#include "utils/corestrings.h"
+#include "utils/nsurl.h"
+#include "content/blocklist.h"
+
+#define NELEMS(x)  (sizeof(x) / sizeof((x)[0]))
+
+#define BLOCKLIST_TEST_PATH "/tmp/blocklist-test"
+#define BLOCKLIST_TEST_COMPILED BLOCKLIST_TEST_PATH ".compiled"
+
+/** filter list used by the tests */
+static const char *test_list =
+	"[Adblock Plus 2.0]\n"
+	"! comment\n"
+	"||ads.example.com^\n"
+	"||tracker.net^\n"
+	"@@||good.tracker.net^\n"
+	"/banner/ads.\n"
+	"|http://evil.\n"
+	".swf|\n"
+	"@@/banner/ads.allowed\n"
+	"example.org##.ad\n"
+	"||foo.com^$third-party\n"
+	"*/wild*card\n"
+	"0.0.0.0 hosts-blocked.org\n"
+	"127.0.0.1 localhost\n";
+
+struct test_pairs {
+	const char *url; /**< url to check */
+	const bool blocked; /**< expected result */
+};
+
+static const struct test_pairs match_tests[] = {
+	/* domain rules match the domain and all subdomains */
+	{ "http://ads.example.com/x", true },
+	{ "http://x.ads.example.com/x", true },
+	{ "http://badads.example.com/x", false },
+	{ "http://example.com/", false },
+	/* domain exceptions */
+	{ "https://tracker.net/", true },
+	{ "https://good.tracker.net/", false },
+	/* URL text rules and exceptions */
+	{ "http://a.com/banner/ads.gif", true },
+	{ "http://a.com/banner/ads.allowed/x", false },
+	/* anchored URL text rules */
+	{ "http://evil.com/", true },
+	{ "http://x.com/?u=http://evil.com", false },
+	{ "http://x.com/f.swf", true },
+	{ "http://x.com/f.swf?x", false },
+	/* ignored rules */
+	{ "http://foo.com/", false },
+	{ "http://x.com/wild/card", false },
+	/* hosts file format */
+	{ "http://hosts-blocked.org/", true },
+	{ "http://localhost/", false },
+	/* requests without a host are never blocked */
+	{ "file:///banner/ads.gif", false },
+};
+
+
+/**
+ * Write the test filter list and initialise blocking from it
+ */
+static void blocklist_create(void)
+{
+	FILE *fp;
+
+	unlink(BLOCKLIST_TEST_COMPILED);
+
+	fp = fopen(BLOCKLIST_TEST_PATH, "w");
+	ck_assert(fp != NULL);
+	fputs(test_list, fp);
+	fclose(fp);
+
+	ck_assert(corestrings_init() == NSERROR_OK);
+	ck_assert(blocklist_init(BLOCKLIST_TEST_PATH) == NSERROR_OK);
+}
+
+static void blocklist_teardown(void)
+{
+	blocklist_fini();
+	corestrings_fini();
+
+	unlink(BLOCKLIST_TEST_PATH);
+	unlink(BLOCKLIST_TEST_COMPILED);
+}
+
+
+/**
+ * Check a URL against the filter list
+ */
+static void check_match(const struct test_pairs *tst)
+{
+	nsurl *url;
+
+	ck_assert(nsurl_create(tst->url, &url) == NSERROR_OK);
+	ck_assert_msg(blocklist_match(url) == tst->blocked,
+		      "%s blocked should be %d", tst->url, tst->blocked);
+	nsurl_unref(url);
+}
+
+START_TEST(blocklist_match_test)
+{
+	check_match(&match_tests[_i]);
+}
+END_TEST
+
+/**
+ * The compiled list is saved and produces the same results when loaded
+ */
+START_TEST(blocklist_reload_test)
+{
+	struct blocklist_stats before;
+	struct blocklist_stats after;
+	unsigned int idx;
+
+	ck_assert(access(BLOCKLIST_TEST_COMPILED, R_OK) == 0);
+
+	blocklist_get_stats(&before);
+	ck_assert_int_eq(before.domain_count, 4);
+	ck_assert_int_eq(before.pattern_count, 4);
+
+	blocklist_fini();
+	ck_assert(blocklist_init(BLOCKLIST_TEST_PATH) == NSERROR_OK);
+
+	blocklist_get_stats(&after);
+	ck_assert_int_eq(after.domain_count, before.domain_count);
+	ck_assert_int_eq(after.pattern_count, before.pattern_count);
+
+	for (idx = 0; idx < NELEMS(match_tests); idx++) {
+		check_match(&match_tests[idx]);
+	}
+}
+END_TEST
+
+/**
+ * A damaged compiled list is rejected and replaced by recompiling
+ */
+START_TEST(blocklist_damaged_test)
+{
+	unsigned char damage[64];
+	unsigned int idx;
+	FILE *fp;
+
+	blocklist_fini();
+
+	/* same size, so only the contents can show the damage */
+	memset(damage, 0xff, sizeof(damage));
+	fp = fopen(BLOCKLIST_TEST_COMPILED, "r+b");
+	ck_assert(fp != NULL);
+	ck_assert(fseek(fp, -(long)sizeof(damage), SEEK_END) == 0);
+	ck_assert(fwrite(damage, sizeof(damage), 1, fp) == 1);
+	fclose(fp);
+
+	ck_assert(blocklist_init(BLOCKLIST_TEST_PATH) == NSERROR_OK);
+
+	for (idx = 0; idx < NELEMS(match_tests); idx++) {
+		check_match(&match_tests[idx]);
+	}
+
+	/* the damaged file was replaced */
+	fp = fopen(BLOCKLIST_TEST_COMPILED, "rb");
+	ck_assert(fp != NULL);
+	ck_assert(fseek(fp, -(long)sizeof(damage), SEEK_END) == 0);
+	ck_assert(fread(damage, sizeof(damage), 1, fp) == 1);
+	fclose(fp);
+	for (idx = 0; idx < sizeof(damage); idx++) {
+		if (damage[idx] != 0xff) {
+			break;
+		}
+	}
+	ck_assert(idx != sizeof(damage));
+
+	/* a truncated file is also rejected */
+	ck_assert(truncate(BLOCKLIST_TEST_COMPILED, 100) == 0);
+	blocklist_fini();
+	ck_assert(blocklist_init(BLOCKLIST_TEST_PATH) == NSERROR_OK);
+	for (idx = 0; idx < NELEMS(match_tests); idx++) {
+		check_match(&match_tests[idx]);
+	}
+}
+END_TEST
+
+/**
+ * Nothing is blocked without a filter list
+ */
+START_TEST(blocklist_none_test)
+{
+	struct blocklist_stats stats;
+	nsurl *url;
+
+	blocklist_fini();
+
+	blocklist_get_stats(&stats);
+	ck_assert_int_eq(stats.domain_count, 0);
+	ck_assert_int_eq(stats.pattern_count, 0);
+
+	ck_assert(nsurl_create("http://ads.example.com/", &url) == NSERROR_OK);
+	ck_assert(blocklist_match(url) == false);
+	nsurl_unref(url);
+
+	ck_assert(blocklist_init(NULL) == NSERROR_OK);
+	ck_assert(blocklist_init("/nonexistent/blocklist") != NSERROR_OK);
+}
+END_TEST
+
+static TCase *blocklist_case_create(void)
+{
+	TCase *tc;
+	tc = tcase_create("Filter list");
+
+	tcase_add_checked_fixture(tc, blocklist_create, blocklist_teardown);
+
+	tcase_add_loop_test(tc, blocklist_match_test,
+			    0, NELEMS(match_tests));
+	tcase_add_test(tc, blocklist_reload_test);
+	tcase_add_test(tc, blocklist_damaged_test);
+	tcase_add_test(tc, blocklist_none_test);
+
+	return tc;
+}
+
+/*
+ * blocklist test suite creation
+ */
+static Suite *blocklist_suite_create(void)
+{
+	Suite *s;
+	s = suite_create("Content blocking");
+
+	suite_add_tcase(s, blocklist_case_create());
+
+	return s;
+}
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	SRunner *sr;
+
+	sr = srunner_create(blocklist_suite_create());
+
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
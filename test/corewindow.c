@@ -0,0 +1,295 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Minimal unit test core window implementation.
+ *
+ * Stubs the treeview's dependencies so treeviews, and the core windows
+ * built on them, can be driven in the unit tests without a frontend.
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/errors.h"
+#include "utils/nscolour.h"
+#include "netsurf/bitmap.h"
+#include "netsurf/content.h"
+#include "netsurf/layout.h"
+#include "netsurf/clipboard.h"
+#include "netsurf/plotters.h"
+#include "netsurf/core_window.h"
+#include "content/hlcache.h"
+#include "css/utils.h"
+#include "desktop/gui_table.h"
+#include "desktop/knockout.h"
+#include "desktop/textarea.h"
+#include "desktop/cw_helper.h"
+
+#include "corewindow.h"
+
+colour nscolours[NSCOLOUR__COUNT];
+
+css_fixed nscss_screen_dpi = F_90;
+
+nserror hlcache_handle_retrieve(nsurl *url, uint32_t flags,
+		nsurl *referer, llcache_post_data *post,
+		hlcache_handle_callback cb, void *pw,
+		hlcache_child_context *child,
+		content_type accepted_types, hlcache_handle **result)
+{
+	return NSERROR_NOT_IMPLEMENTED;
+}
+
+nserror hlcache_handle_release(hlcache_handle *handle)
+{
+	return NSERROR_OK;
+}
+
+bool content_redraw(struct hlcache_handle *h,
+		struct content_redraw_data *data,
+		const struct rect *clip,
+		const struct redraw_context *ctx)
+{
+	return true;
+}
+
+int content_get_height(struct hlcache_handle *h)
+{
+	return 0;
+}
+
+nserror cw_helper_scroll_visible(
+		const struct core_window_callback_table *cw_t,
+		struct core_window *cw_h,
+		const struct rect *r)
+{
+	return NSERROR_OK;
+}
+
+bool knockout_plot_start(const struct redraw_context *ctx,
+		struct redraw_context *knk_ctx)
+{
+	return true;
+}
+
+bool knockout_plot_end(const struct redraw_context *ctx)
+{
+	return true;
+}
+
+/** Search textarea handle; never dereferenced */
+static int test_textarea;
+
+struct textarea *textarea_create(const textarea_flags flags,
+		const textarea_setup *setup,
+		textarea_client_callback callback, void *data)
+{
+	return (struct textarea *)&test_textarea;
+}
+
+const char *textarea_data(struct textarea *ta, unsigned int *len)
+{
+	return NULL;
+}
+
+void textarea_destroy(struct textarea *ta)
+{
+}
+
+int textarea_get_text(struct textarea *ta, char *buf, unsigned int len)
+{
+	return -1;
+}
+
+bool textarea_keypress(struct textarea *ta, uint32_t key)
+{
+	return false;
+}
+
+textarea_mouse_status textarea_mouse_action(struct textarea *ta,
+		browser_mouse_state mouse, int x, int y)
+{
+	return TEXTAREA_MOUSE_NONE;
+}
+
+void textarea_redraw(struct textarea *ta, int x, int y, colour bg,
+		float scale, const struct rect *clip,
+		const struct redraw_context *ctx)
+{
+}
+
+bool textarea_set_caret(struct textarea *ta, int caret)
+{
+	return true;
+}
+
+bool textarea_set_text(struct textarea *ta, const char *text)
+{
+	return true;
+}
+
+/* Bitmaps are plain buffers */
+
+struct test_bitmap {
+	int width;
+	int height;
+	unsigned char data[];
+};
+
+static void *test_bitmap_create(int width, int height, unsigned int state)
+{
+	struct test_bitmap *b;
+
+	b = calloc(1, sizeof(*b) + width * height * 4);
+	if (b != NULL) {
+		b->width = width;
+		b->height = height;
+	}
+	return b;
+}
+
+static void test_bitmap_destroy(void *bitmap)
+{
+	free(bitmap);
+}
+
+static unsigned char *test_bitmap_get_buffer(void *bitmap)
+{
+	return ((struct test_bitmap *)bitmap)->data;
+}
+
+static size_t test_bitmap_get_rowstride(void *bitmap)
+{
+	return ((struct test_bitmap *)bitmap)->width * 4;
+}
+
+static int test_bitmap_get_width(void *bitmap)
+{
+	return ((struct test_bitmap *)bitmap)->width;
+}
+
+static int test_bitmap_get_height(void *bitmap)
+{
+	return ((struct test_bitmap *)bitmap)->height;
+}
+
+static void test_bitmap_modified(void *bitmap)
+{
+}
+
+static struct gui_bitmap_table test_bitmap_table = {
+	.create = test_bitmap_create,
+	.destroy = test_bitmap_destroy,
+	.get_buffer = test_bitmap_get_buffer,
+	.get_rowstride = test_bitmap_get_rowstride,
+	.get_width = test_bitmap_get_width,
+	.get_height = test_bitmap_get_height,
+	.modified = test_bitmap_modified,
+};
+
+/* Text is measured as a fixed width per byte */
+
+static nserror test_layout_width(const struct plot_font_style *fstyle,
+		const char *string, size_t length, int *width)
+{
+	*width = length * 8;
+	return NSERROR_OK;
+}
+
+static struct gui_layout_table test_layout_table = {
+	.width = test_layout_width,
+};
+
+static void test_clipboard_set(const char *buffer, size_t length,
+		nsclipboard_styles styles[], int n_styles)
+{
+}
+
+static struct gui_clipboard_table test_clipboard_table = {
+	.set = test_clipboard_set,
+};
+
+static struct netsurf_table test_table = {
+	.clipboard = &test_clipboard_table,
+	.bitmap = &test_bitmap_table,
+	.layout = &test_layout_table,
+};
+
+struct netsurf_table *guit = &test_table;
+
+/* Core window which ignores everything */
+
+static nserror test_cw_invalidate(struct core_window *cw,
+		const struct rect *rect)
+{
+	return NSERROR_OK;
+}
+
+static nserror test_cw_update_size(struct core_window *cw,
+		int width, int height)
+{
+	return NSERROR_OK;
+}
+
+static nserror test_cw_set_scroll(struct core_window *cw, int x, int y)
+{
+	return NSERROR_OK;
+}
+
+static nserror test_cw_get_scroll(const struct core_window *cw,
+		int *x, int *y)
+{
+	*x = 0;
+	*y = 0;
+	return NSERROR_OK;
+}
+
+static nserror test_cw_get_window_dimensions(const struct core_window *cw,
+		int *width, int *height)
+{
+	*width = TEST_CW_WIDTH;
+	*height = TEST_CW_HEIGHT;
+	return NSERROR_OK;
+}
+
+static nserror test_cw_drag_status(struct core_window *cw,
+		core_window_drag_status ds)
+{
+	return NSERROR_OK;
+}
+
+/** Core window handle; never dereferenced */
+static int test_cw_handle;
+
+/* exported interface documented in test/corewindow.h */
+struct core_window *test_cw = (struct core_window *)&test_cw_handle;
+
+/* exported interface documented in test/corewindow.h */
+struct core_window_callback_table test_cw_table = {
+	.invalidate = test_cw_invalidate,
+	.update_size = test_cw_update_size,
+	.set_scroll = test_cw_set_scroll,
+	.get_scroll = test_cw_get_scroll,
+	.get_window_dimensions = test_cw_get_window_dimensions,
+	.drag_status = test_cw_drag_status,
+};
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Unit test core window interface.
+ */
+
+#ifndef NETSURF_TEST_COREWINDOW_H
+#define NETSURF_TEST_COREWINDOW_H
+
+/** Width of the test core window */
+#define TEST_CW_WIDTH 800
+
+/** Height of the test core window */
+#define TEST_CW_HEIGHT 600
+
+struct core_window;
+struct core_window_callback_table;
+
+/** Core window handle to create treeviews with; never dereferenced */
+extern struct core_window *test_cw;
+
+/** Core window callbacks which ignore everything */
+extern struct core_window_callback_table test_cw_table;
+
+#endif
@@ -0,0 +1,360 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Test framebuffer freetype text measurement and glyph lookup.
+ *
+ * Text is measured through the framebuffer layout table and its glyphs
+ * are looked up as the text plotter does, once with the glyph and run
+ * width caches enabled and once with them disabled. The results must
+ * agree and the time taken in each case is reported.
+ *
+ * The fonts are the DejaVu faces found in TEST_FONT_PATH, which is set
+ *  from FBFONT_PATH in the test Makefile.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include <nsutils/time.h>
+
+#include "utils/errors.h"
+#include "utils/filepath.h"
+#include "utils/nsoption.h"
+#include "utils/utf8.h"
+#include "netsurf/inttypes.h"
+#include "netsurf/browser.h"
+#include "netsurf/layout.h"
+#include "netsurf/plot_style.h"
+#include "desktop/gui_table.h"
+
+#include "framebuffer/font.h"
+
+/** Number of paragraphs laid out in the benchmark */
+#define N_PARAGRAPHS 2000
+
+/** Number of words in each paragraph */
+#define N_WORDS 60
+
+/** Width each paragraph is split to */
+#define LINE_WIDTH 600
+
+/** Widths of the test words in each font style */
+struct test_widths {
+	int word[12];
+	int sentence;
+};
+
+/* Stubs for the font code's dependencies */
+
+struct nsoption_s *nsoptions = NULL;
+struct nsoption_s *nsoptions_default = NULL;
+static struct nsoption_s test_options[NSOPTION_LISTEND];
+
+struct netsurf_table *guit = NULL;
+
+char **respaths = NULL;
+
+char *filepath_sfind(char **respathv, char *filepath, const char *filename)
+{
+	snprintf(filepath, PATH_MAX, "%s/%s", TEST_FONT_PATH, filename);
+	return filepath;
+}
+
+int browser_get_dpi(void)
+{
+	return 90;
+}
+
+/* Test text */
+
+static const char *words[] = {
+	"lorem", "ipsum", "dolor", "sit", "amet", "consectetur",
+	"adipiscing", "elit", "sed", "do", "eiusmod", "tempor",
+};
+
+#define N_TEST_WORDS (sizeof(words) / sizeof(words[0]))
+
+static const char *sentence =
+	"The quick brown fox jumps over the lazy dog \xc3\xa9t\xc3\xa9 "
+	"\xe2\x80\x94 0123456789 !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+static const plot_font_style_t test_styles[] = {
+	{
+		.family = PLOT_FONT_FAMILY_SANS_SERIF,
+		.size = 12 * PLOT_STYLE_SCALE,
+		.weight = 400,
+	},
+	{
+		.family = PLOT_FONT_FAMILY_SANS_SERIF,
+		.size = 16 * PLOT_STYLE_SCALE,
+		.weight = 700,
+	},
+	{
+		.family = PLOT_FONT_FAMILY_SERIF,
+		.size = 10 * PLOT_STYLE_SCALE,
+		.weight = 400,
+	},
+	{
+		.family = PLOT_FONT_FAMILY_MONOSPACE,
+		.size = 12 * PLOT_STYLE_SCALE,
+		.weight = 400,
+	},
+};
+
+#define N_TEST_STYLES (sizeof(test_styles) / sizeof(test_styles[0]))
+
+/**
+ * Initialise the font code with the glyph caches enabled or disabled
+ */
+static void font_init(bool cache)
+{
+	memset(test_options, 0, sizeof(test_options));
+	nsoptions = test_options;
+
+	nsoption_set_int(fb_font_cachesize, 2048);
+	nsoption_set_bool(fb_font_glyphcache, cache);
+
+	ck_assert(fb_font_init());
+}
+
+/**
+ * Look up every glyph of a run as the text plotter does
+ *
+ * \return sum of the glyph advances and mask bytes
+ */
+static unsigned int plot_run(const plot_font_style_t *fstyle,
+		const char *text, size_t length)
+{
+	struct fb_glyph_style *style;
+	const struct fb_glyph *glyph;
+	unsigned int sum = 0;
+	size_t nxtchr = 0;
+	uint32_t ucs4;
+	int row;
+
+	style = fb_font_style(fstyle);
+	ck_assert(style != NULL);
+
+	while (nxtchr < length) {
+		ucs4 = utf8_to_ucs4(text + nxtchr, length - nxtchr);
+		nxtchr = utf8_next(text, length, nxtchr);
+
+		glyph = fb_font_style_glyph(style, ucs4);
+		if (glyph == NULL)
+			continue;
+
+		sum += glyph->advance;
+		if (glyph->bitmap == NULL)
+			continue;
+
+		for (row = 0; row < glyph->rows; row++) {
+			sum += glyph->bitmap[row * glyph->pitch];
+		}
+	}
+
+	return sum;
+}
+
+/**
+ * Lay out and plot paragraphs of the test words
+ */
+static void layout_paragraphs(const plot_font_style_t *fstyle,
+		unsigned int *plot_sum)
+{
+	char text[N_WORDS * 12];
+	size_t length;
+	size_t offset;
+	size_t split;
+	int width;
+	int p, i;
+
+	for (p = 0; p < N_PARAGRAPHS; p++) {
+		length = 0;
+		for (i = 0; i < N_WORDS; i++) {
+			const char *w = words[(p * 7 + i) % N_TEST_WORDS];
+			size_t wlen = strlen(w);
+
+			memcpy(text + length, w, wlen);
+			length += wlen;
+			text[length++] = ' ';
+
+			/* layout measures each word */
+			framebuffer_layout_table->width(fstyle, w, wlen,
+					&width);
+		}
+
+		/* then splits the paragraph into lines and plots them */
+		for (offset = 0; offset < length; offset += split) {
+			framebuffer_layout_table->split(fstyle,
+					text + offset, length - offset,
+					LINE_WIDTH, &split, &width);
+			ck_assert(split > 0);
+			*plot_sum += plot_run(fstyle, text + offset, split);
+		}
+	}
+}
+
+/**
+ * Measure the test words and sentence in each style
+ */
+static void measure(struct test_widths *w)
+{
+	const struct gui_layout_table *layout = framebuffer_layout_table;
+	unsigned int s, i;
+	int pass;
+
+	for (pass = 0; pass < 2; pass++) {
+		for (s = 0; s < N_TEST_STYLES; s++) {
+			for (i = 0; i < N_TEST_WORDS; i++) {
+				ck_assert(layout->width(&test_styles[s],
+						words[i], strlen(words[i]),
+						&w[s].word[i]) == NSERROR_OK);
+			}
+			ck_assert(layout->width(&test_styles[s],
+					sentence, strlen(sentence),
+					&w[s].sentence) == NSERROR_OK);
+		}
+	}
+}
+
+
+/* Tests */
+
+/**
+ * Text has the same widths whether or not the caches are used
+ */
+START_TEST(fbfont_width_test)
+{
+	struct test_widths widths[2][N_TEST_STYLES];
+	unsigned int s, i;
+	int cache;
+
+	for (cache = 0; cache < 2; cache++) {
+		font_init(cache);
+		measure(widths[cache]);
+		fb_font_finalise();
+	}
+
+	for (s = 0; s < N_TEST_STYLES; s++) {
+		ck_assert_int_gt(widths[0][s].sentence, 0);
+		ck_assert_int_eq(widths[0][s].sentence,
+				widths[1][s].sentence);
+		for (i = 0; i < N_TEST_WORDS; i++) {
+			ck_assert_int_gt(widths[0][s].word[i], 0);
+			ck_assert_int_eq(widths[0][s].word[i],
+					widths[1][s].word[i]);
+		}
+	}
+}
+END_TEST
+
+/**
+ * The same glyphs are plotted whether or not the caches are used
+ */
+START_TEST(fbfont_plot_test)
+{
+	unsigned int cached, uncached;
+	unsigned int s;
+
+	for (s = 0; s < N_TEST_STYLES; s++) {
+		font_init(true);
+		/* second run reads from the glyph tables */
+		plot_run(&test_styles[s], sentence, strlen(sentence));
+		cached = plot_run(&test_styles[s], sentence, strlen(sentence));
+		fb_font_finalise();
+
+		font_init(false);
+		uncached = plot_run(&test_styles[s], sentence,
+				strlen(sentence));
+		fb_font_finalise();
+
+		ck_assert_uint_eq(cached, uncached);
+	}
+}
+END_TEST
+
+/**
+ * Benchmark laying out and plotting a text heavy page
+ */
+START_TEST(fbfont_benchmark_test)
+{
+	unsigned int plot_sum[2] = { 0, 0 };
+	uint64_t ms_before;
+	uint64_t ms_after;
+	int cache;
+
+	for (cache = 1; cache >= 0; cache--) {
+		font_init(cache);
+
+		nsu_getmonotonic_ms(&ms_before);
+		layout_paragraphs(&test_styles[0], &plot_sum[cache]);
+		nsu_getmonotonic_ms(&ms_after);
+
+		fb_font_finalise();
+
+		printf("%d paragraphs of %d words, caches %s, in %"PRIu64"ms\n",
+				N_PARAGRAPHS, N_WORDS,
+				cache ? "enabled" : "disabled",
+				ms_after - ms_before);
+	}
+
+	ck_assert_uint_eq(plot_sum[0], plot_sum[1]);
+}
+END_TEST
+
+
+static Suite *fbfont_suite(void)
+{
+	Suite *s;
+	TCase *tc_font;
+
+	s = suite_create("framebuffer font");
+
+	tc_font = tcase_create("Glyph caches");
+
+	tcase_add_test(tc_font, fbfont_width_test);
+	tcase_add_test(tc_font, fbfont_plot_test);
+	tcase_add_test(tc_font, fbfont_benchmark_test);
+
+	tcase_set_timeout(tc_font, 120);
+
+	suite_add_tcase(s, tc_font);
+
+	return s;
+}
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	SRunner *sr;
+
+	sr = srunner_create(fbfont_suite());
+
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
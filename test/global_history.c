@@ -0,0 +1,313 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Test global history with a large number of entries.
+ *
+ * The url database is replaced with a table of synthetic entries spread
+ * over the days the global history shows. The time taken to build the
+ * history from them and to add visits to it is reported, and the
+ * entries in the history are checked by exporting it.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <check.h>
+#include <nsutils/time.h>
+
+#include "utils/errors.h"
+#include "utils/nsoption.h"
+#include "utils/nsurl.h"
+#include "utils/corestrings.h"
+#include "utils/messages.h"
+#include "utils/utf8.h"
+#include "netsurf/inttypes.h"
+#include "netsurf/url_db.h"
+#include "netsurf/browser_window.h"
+#include "content/urldb.h"
+#include "desktop/global_history.h"
+
+#include "corewindow.h"
+
+/** Number of entries in the url database */
+#define N_ENTRIES 100000
+
+/** Number of visits added to the built history */
+#define N_VISITS 10000
+
+/** Period the entries' last visits are spread over, in seconds */
+#define VISIT_PERIOD (26 * 60 * 60 * 24)
+
+/** File the history is exported to */
+#define EXPORT_PATH TESTROOT "/global_history.html"
+
+/* Stubs for the global history's dependencies */
+
+struct nsoption_s *nsoptions = NULL;
+struct nsoption_s *nsoptions_default = NULL;
+static struct nsoption_s test_options[NSOPTION_LISTEND];
+
+const char *messages_get(const char *key)
+{
+	return key;
+}
+
+nserror utf8_to_html(const char *string, const char *encname,
+		size_t len, char **result)
+{
+	*result = strndup(string, len);
+	return (*result != NULL) ? NSERROR_OK : NSERROR_NOMEM;
+}
+
+nserror browser_window_create(enum browser_window_create_flags flags,
+		nsurl *url, nsurl *referrer,
+		struct browser_window *existing,
+		struct browser_window **bw)
+{
+	return NSERROR_NOT_IMPLEMENTED;
+}
+
+/* The url database is a table of synthetic entries */
+
+/** URLs of the database entries followed by those of new visits */
+static nsurl *urls[N_ENTRIES + N_VISITS];
+
+/** Visit data for each of the URLs */
+static struct url_data url_data[N_ENTRIES + N_VISITS];
+
+/** Entry returned by urldb_get_url_data */
+static const struct url_data *current_data;
+
+void urldb_iterate_entries(bool (*callback)(nsurl *url,
+		const struct url_data *data))
+{
+	int i;
+
+	for (i = 0; i < N_ENTRIES; i++) {
+		if (!callback(urls[i], &url_data[i])) {
+			break;
+		}
+	}
+}
+
+const struct url_data *urldb_get_url_data(nsurl *url)
+{
+	return current_data;
+}
+
+void urldb_reset_url_visit_data(nsurl *url)
+{
+}
+
+/**
+ * Create the URLs and visit data
+ */
+static void urls_create(void)
+{
+	time_t now = time(NULL);
+	char buf[64];
+	int i;
+
+	memset(test_options, 0, sizeof(test_options));
+	nsoptions = test_options;
+
+	ck_assert(corestrings_init() == NSERROR_OK);
+
+	for (i = 0; i < N_ENTRIES + N_VISITS; i++) {
+		snprintf(buf, sizeof(buf),
+				"http://host%d.example.com/page%d.html",
+				i % 1000, i);
+		ck_assert(nsurl_create(buf, &urls[i]) == NSERROR_OK);
+
+		url_data[i].title = NULL;
+		url_data[i].visits = 1 + i % 5;
+		url_data[i].last_visit = now -
+				((time_t)i * 7919) % VISIT_PERIOD;
+		url_data[i].type = CONTENT_HTML;
+	}
+}
+
+static void urls_teardown(void)
+{
+	int i;
+
+	for (i = 0; i < N_ENTRIES + N_VISITS; i++) {
+		nsurl_unref(urls[i]);
+	}
+
+	corestrings_fini();
+}
+
+/**
+ * Build the global history from the url database
+ */
+static void history_create(void)
+{
+	uint64_t ms_before;
+	uint64_t ms_after;
+	nserror res;
+
+	nsu_getmonotonic_ms(&ms_before);
+	res = global_history_init(&test_cw_table, test_cw);
+	nsu_getmonotonic_ms(&ms_after);
+	ck_assert(res == NSERROR_OK);
+
+	printf("Built global history of %d entries in %"PRIu64"ms\n",
+			N_ENTRIES, ms_after - ms_before);
+}
+
+static void history_teardown(void)
+{
+	ck_assert(global_history_fini() == NSERROR_OK);
+}
+
+/**
+ * Count the entries in an export of the fully expanded history
+ */
+static int history_count(void)
+{
+	char line[256];
+	int count = 0;
+	FILE *fp;
+
+	ck_assert(global_history_expand(true) == NSERROR_OK);
+	ck_assert(global_history_export(EXPORT_PATH, NULL) == NSERROR_OK);
+
+	fp = fopen(EXPORT_PATH, "r");
+	ck_assert(fp != NULL);
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (strncmp(line, "<li><a href=", 12) == 0) {
+			count++;
+		}
+	}
+	fclose(fp);
+
+	remove(EXPORT_PATH);
+
+	return count;
+}
+
+/* Tests */
+
+/**
+ * Every entry in the url database is in the history
+ */
+START_TEST(global_history_build_test)
+{
+	uint64_t ms_before;
+	uint64_t ms_after;
+
+	nsu_getmonotonic_ms(&ms_before);
+	ck_assert(global_history_expand(true) == NSERROR_OK);
+	nsu_getmonotonic_ms(&ms_after);
+
+	printf("Filled global history folders with %d entries in %"PRIu64"ms\n",
+			N_ENTRIES, ms_after - ms_before);
+
+	ck_assert_int_eq(history_count(), N_ENTRIES);
+}
+END_TEST
+
+/**
+ * Benchmark adding visits to existing and new URLs
+ */
+START_TEST(global_history_add_test)
+{
+	time_t now = time(NULL);
+	uint64_t ms_before;
+	uint64_t ms_after;
+	int i;
+
+	nsu_getmonotonic_ms(&ms_before);
+	for (i = 0; i < N_VISITS; i++) {
+		int e = (i * 7) % N_ENTRIES;
+
+		url_data[e].visits++;
+		url_data[e].last_visit = now;
+		current_data = &url_data[e];
+		ck_assert(global_history_add(urls[e]) == NSERROR_OK);
+	}
+	nsu_getmonotonic_ms(&ms_after);
+
+	printf("Revisited %d of %d entries in %"PRIu64"ms\n",
+			N_VISITS, N_ENTRIES, ms_after - ms_before);
+
+	nsu_getmonotonic_ms(&ms_before);
+	for (i = N_ENTRIES; i < N_ENTRIES + N_VISITS; i++) {
+		url_data[i].last_visit = now;
+		current_data = &url_data[i];
+		ck_assert(global_history_add(urls[i]) == NSERROR_OK);
+	}
+	nsu_getmonotonic_ms(&ms_after);
+
+	printf("Added %d entries to %d entries in %"PRIu64"ms\n",
+			N_VISITS, N_ENTRIES, ms_after - ms_before);
+
+	ck_assert_int_eq(history_count(), N_ENTRIES + N_VISITS);
+}
+END_TEST
+
+
+static TCase *global_history_case_create(void)
+{
+	TCase *tc;
+	tc = tcase_create("Large history");
+
+	tcase_add_unchecked_fixture(tc, urls_create, urls_teardown);
+	tcase_add_checked_fixture(tc, history_create, history_teardown);
+
+	tcase_add_test(tc, global_history_build_test);
+	tcase_add_test(tc, global_history_add_test);
+
+	tcase_set_timeout(tc, 120);
+
+	return tc;
+}
+
+/*
+ * global history test suite creation
+ */
+static Suite *global_history_suite_create(void)
+{
+	Suite *s;
+	s = suite_create("global history");
+
+	suite_add_tcase(s, global_history_case_create());
+
+	return s;
+}
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	SRunner *sr;
+
+	sr = srunner_create(global_history_suite_create());
+
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Tests for the builtin messages table
+ *
+ * The table and a messages file are both generated from FatMessages
+ *  for the same language and filter so every message in the file must
+ *  be found in the table with the same value.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+
+#include "utils/errors.h"
+#include "utils/hashtable.h"
+#include "utils/messages.h"
+
+const char *test_messages_path = TESTROOT "/Messages";
+
+/**
+ * Every message in the messages file is in the builtin table
+ */
+START_TEST(messages_builtin_match_test)
+{
+	struct hash_table *ht;
+	char line[1024];
+	char *key;
+	char *colon;
+	unsigned int count = 0;
+	FILE *fp;
+	nserror res;
+
+	ht = hash_create(79);
+	ck_assert(ht != NULL);
+
+	res = hash_add_file(ht, test_messages_path);
+	ck_assert_int_eq(res, NSERROR_OK);
+
+	fp = fopen(test_messages_path, "r");
+	ck_assert(fp != NULL);
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		key = line + strspn(line, " \t");
+		if ((*key == '\n') || (*key == 0) || (*key == '#')) {
+			continue;
+		}
+
+		colon = strchr(key, ':');
+		ck_assert(colon != NULL);
+		*colon = 0;
+
+		/* no messages are loaded so the value must be builtin */
+		ck_assert_str_eq(messages_get(key), hash_get(ht, key));
+		count++;
+	}
+
+	fclose(fp);
+	hash_destroy(ht);
+
+	ck_assert_int_gt(count, 0);
+}
+END_TEST
+
+/**
+ * A key which is not in the table is not found
+ */
+START_TEST(messages_builtin_missing_test)
+{
+	char *buf;
+
+	ck_assert_str_eq(messages_get("DefinitelyNotAKey"),
+			 "DefinitelyNotAKey");
+
+	buf = messages_get_buff("DefinitelyNotAKey");
+	ck_assert(buf == NULL);
+}
+END_TEST
+
+/**
+ * The builtin language is recognised with territory and codeset
+ */
+START_TEST(messages_builtin_language_test)
+{
+	ck_assert(messages_builtin("en"));
+	ck_assert(messages_builtin("en_GB.UTF-8"));
+	ck_assert(messages_builtin("C"));
+	ck_assert(!messages_builtin("eo"));
+	ck_assert(!messages_builtin("fr_FR"));
+}
+END_TEST
+
+
+static TCase *messages_builtin_case_create(void)
+{
+	TCase *tc;
+	tc = tcase_create("Builtin table");
+
+	tcase_add_test(tc, messages_builtin_match_test);
+	tcase_add_test(tc, messages_builtin_missing_test);
+	tcase_add_test(tc, messages_builtin_language_test);
+
+	return tc;
+}
+
+
+static Suite *messages_builtin_suite_create(void)
+{
+	Suite *s;
+	s = suite_create("builtin messages");
+
+	suite_add_tcase(s, messages_builtin_case_create());
+
+	return s;
+}
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	SRunner *sr;
+
+	sr = srunner_create(messages_builtin_suite_create());
+
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,10 +25,12 @@ runs tests in monkey as defined in a yaml file
 import os
 import sys
 import getopt
+import json
 import time
 import yaml
 
 from monkeyfarmer import Browser
+from monkey_server import PageServer
 
 
 class DriverBrowser(Browser):
@@ -89,7 +91,7 @@ class DriverBrowser(Browser):
 
 def print_usage():
     print('Usage:')
-    print('  ' + sys.argv[0] + ' -m <path to monkey> -t <path to test> [-w <wrapper arguments>]')
+    print('  ' + sys.argv[0] + ' -m <path to monkey> -t <path to test> [-w <wrapper arguments>] [-j <path to json results>]')
 
 
 def parse_argv(argv):
@@ -99,8 +101,9 @@ def parse_argv(argv):
     path_monkey = ''
     path_test = ''
     wrapper = None
+    path_json = None
     try:
-        opts, args = getopt.getopt(argv, "hm:t:w:", ["monkey=", "test=", "wrapper="])
+        opts, args = getopt.getopt(argv, "hm:t:w:j:", ["monkey=", "test=", "wrapper=", "json="])
     except getopt.GetoptError:
         print_usage()
         sys.exit(2)
@@ -116,6 +119,8 @@ def parse_argv(argv):
             if wrapper is None:
                 wrapper = []
             wrapper.extend(arg.split())
+        elif opt in ("-j", "--json"):
+            path_json = arg
 
     if path_monkey == '':
         print_usage()
@@ -124,7 +129,7 @@ def parse_argv(argv):
         print_usage()
         sys.exit()
 
-    return path_monkey, path_test, wrapper
+    return path_monkey, path_test, wrapper, path_json
 
 
 def load_test_plan(path):
@@ -259,6 +264,9 @@ def run_test_step_action_navigate(ctx, step):
     assert_browser(ctx)
     if 'url' in step.keys():
         url = step['url']
+    elif 'path' in step.keys():
+        assert ctx.get('server') is not None
+        url = ctx['server'].url(step['path'])
     elif 'repeaturl' in step.keys():
         repeat = ctx['repeats'].get(step['repeaturl'])
         assert repeat is not None
@@ -426,6 +434,21 @@ def run_test_step_action_click(ctx, step):
     win.click(x, y, button, kind)
 
 
+def run_test_step_action_scroll(ctx, step):
+    print(get_indent(ctx) + "Action: " + step["action"])
+    assert_browser(ctx)
+    win = ctx['windows'][step['window']]
+    x = step.get('x', 0)
+    if 'repeaty' in step.keys():
+        repeat = ctx['repeats'].get(step['repeaty'])
+        assert repeat is not None
+        y = repeat['i']
+    else:
+        y = step.get('y', 0)
+    print(get_indent(ctx) + "        Scrolling to {}, {}".format(x, y))
+    win.scroll(x, y)
+
+
 def run_test_step_action_wait_loading(ctx, step):
     print(get_indent(ctx) + "Action: " + step["action"])
     assert_browser(ctx)
@@ -582,6 +605,67 @@ def run_test_step_action_page_info_state(ctx, step):
     assert win.page_info_state == match
 
 
+def run_test_step_action_server_start(ctx, step):
+    print(get_indent(ctx) + "Action: " + step["action"])
+    assert ctx.get('server') is None
+    corpus = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                          step['corpus'])
+    ctx['server'] = PageServer(corpus,
+                               latency=int(step.get('latency', 0)),
+                               bandwidth=int(step.get('bandwidth', 0)))
+    ctx['server'].start()
+    print(get_indent(ctx) + "        Serving " + corpus + " at " + ctx['server'].url())
+
+
+def run_test_step_action_server_stop(ctx, step):
+    print(get_indent(ctx) + "Action: " + step["action"])
+    server = ctx.pop('server')
+    assert server is not None
+    server.stop()
+
+
+def run_test_step_action_perf_record(ctx, step):
+    print(get_indent(ctx) + "Action: " + step["action"])
+    assert_browser(ctx)
+    tag = step['tag']
+    win = ctx['windows'].get(step['window'])
+    assert win is not None
+    assert ctx['perf'].get(tag) is None
+    record = {
+        "url": win.url,
+        "phases": win.get_timing(),
+        "peak-memory-kb": ctx['browser'].peak_memory(),
+    }
+    if record["phases"] is None:
+        print("{}        {} no phase timings".format(get_indent(ctx), tag))
+    else:
+        for phase, taken in record["phases"].items():
+            print("{}        {} {}: {}ms".format(get_indent(ctx), tag, phase, taken))
+    print("{}        {} peak memory: {}kB".format(get_indent(ctx), tag, record["peak-memory-kb"]))
+    ctx['perf'][tag] = record
+
+
+def run_test_step_action_perf_report(ctx, step):
+    print(get_indent(ctx) + "Action: " + step["action"])
+    report = {
+        "title": ctx['plan']["title"],
+        "group": ctx['plan']["group"],
+        "records": ctx['perf'],
+        "timers": {tag: timer.get("taken") for tag, timer in ctx['timers'].items()},
+    }
+    browser = ctx.get('browser')
+    if browser is not None:
+        report["startup-ms"] = browser.startup_ms
+        report["launch-ms"] = browser.launch_ms
+    path = step.get('output', ctx.get('json'))
+    if path is None:
+        print("PERF " + json.dumps(report, sort_keys=True))
+    else:
+        with open(path, 'w') as stream:
+            json.dump(report, stream, indent=2, sort_keys=True)
+        print(get_indent(ctx) + "        Results written to " + path)
+
+
 def run_test_step_action_quit(ctx, step):
     print(get_indent(ctx) + "Action: " + step["action"])
     assert_browser(ctx)
@@ -607,6 +691,7 @@ STEP_HANDLERS = {
     "timer-check":   run_test_step_action_timer_check,
     "plot-check":    run_test_step_action_plot_check,
     "click":         run_test_step_action_click,
+    "scroll":        run_test_step_action_scroll,
     "wait-loading":  run_test_step_action_wait_loading,
     "add-auth":      run_test_step_action_add_auth,
     "remove-auth":   run_test_step_action_remove_auth,
@@ -615,6 +700,10 @@ STEP_HANDLERS = {
     "js-exec":       run_test_step_action_js_exec,
     "page-info-state":
                      run_test_step_action_page_info_state,
+    "server-start":  run_test_step_action_server_start,
+    "server-stop":   run_test_step_action_server_stop,
+    "perf-record":   run_test_step_action_perf_record,
+    "perf-report":   run_test_step_action_perf_report,
     "quit":          run_test_step_action_quit,
 }
 
@@ -627,8 +716,14 @@ def walk_test_plan(ctx, plan):
     ctx["depth"] = 0
     ctx["timers"] = dict()
     ctx['repeats'] = dict()
-    for step in plan["steps"]:
-        run_test_step(ctx, step)
+    ctx['perf'] = dict()
+    ctx['plan'] = plan
+    try:
+        for step in plan["steps"]:
+            run_test_step(ctx, step)
+    finally:
+        if ctx.get('server') is not None:
+            ctx.pop('server').stop()
 
 
 def run_test_plan(ctx, plan):
@@ -645,10 +740,11 @@ def run_preloaded_test(path_monkey, plan):
 
 def main(argv):
     ctx = {}
-    path_monkey, path_test, wrapper = parse_argv(argv)
+    path_monkey, path_test, wrapper, path_json = parse_argv(argv)
     plan = load_test_plan(path_test)
     ctx["monkey"] = path_monkey
     ctx["wrapper"] = wrapper
+    ctx["json"] = path_json
     run_test_plan(ctx, plan)
 
 
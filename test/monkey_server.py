@@ -0,0 +1,161 @@
+#!/usr/bin/python3
+#
+# This file is part of NetSurf, http://www.netsurf-browser.org/
+#
+# NetSurf is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; version 2 of the License.
+#
+# NetSurf is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""
+Local page server
+
+Serves a directory of test pages over HTTP on the loopback interface,
+simulating network conditions with a fixed latency before each response
+and a limited bandwidth while sending the body. This allows page load
+tests to run without any external network access.
+
+It is used by the monkey driver `server-start` action and may also be
+run on its own.
+"""
+
+# pylint: disable=locally-disabled, missing-docstring
+
+import getopt
+import os
+import sys
+import threading
+import time
+from http.server import ThreadingHTTPServer, SimpleHTTPRequestHandler
+
+
+class ThrottledRequestHandler(SimpleHTTPRequestHandler):
+
+    # seconds to wait before responding to each request
+    latency = 0
+    # bytes per second the body is sent at, zero for no limit
+    bandwidth = 0
+    # size of the writes made while the bandwidth is limited
+    chunk_size = 4096
+    # whether to log each request
+    quiet = True
+
+    def log_message(self, format, *args):
+        # pylint: disable=locally-disabled, redefined-builtin
+        if not self.quiet:
+            super().log_message(format, *args)
+
+    def send_head(self):
+        if self.latency > 0:
+            time.sleep(self.latency)
+        return super().send_head()
+
+    def copyfile(self, source, outputfile):
+        if self.bandwidth <= 0:
+            super().copyfile(source, outputfile)
+            return
+
+        while True:
+            buf = source.read(self.chunk_size)
+            if not buf:
+                break
+            outputfile.write(buf)
+            time.sleep(len(buf) / self.bandwidth)
+
+
+class PageServer:
+
+    def __init__(self, root, latency=0, bandwidth=0, port=0, quiet=True):
+        root = os.path.abspath(root)
+        assert os.path.isdir(root), "No page corpus at {}".format(root)
+
+        handler = type("PageRequestHandler", (ThrottledRequestHandler,), {
+            "latency": latency / 1000,
+            "bandwidth": bandwidth,
+            "quiet": quiet,
+        })
+
+        def make_handler(*args, **kwargs):
+            return handler(*args, directory=root, **kwargs)
+
+        self.root = root
+        self.httpd = ThreadingHTTPServer(("127.0.0.1", port), make_handler)
+        self.httpd.daemon_threads = True
+        self.port = self.httpd.server_address[1]
+        self.thread = None
+
+    def start(self):
+        self.thread = threading.Thread(target=self.httpd.serve_forever)
+        self.thread.daemon = True
+        self.thread.start()
+
+    def stop(self):
+        self.httpd.shutdown()
+        self.httpd.server_close()
+        if self.thread is not None:
+            self.thread.join()
+            self.thread = None
+
+    def url(self, path="/"):
+        if not path.startswith("/"):
+            path = "/" + path
+        return "http://127.0.0.1:{}{}".format(self.port, path)
+
+
+def print_usage():
+    print('Usage:')
+    print('  ' + sys.argv[0] + ' -r <page directory> [-p <port>] [-l <latency ms>] [-b <bytes per second>]')
+
+
+def parse_argv(argv):
+    root = None
+    port = 8000
+    latency = 0
+    bandwidth = 0
+    try:
+        opts, _args = getopt.getopt(argv, "hr:p:l:b:",
+                                    ["root=", "port=", "latency=", "bandwidth="])
+    except getopt.GetoptError:
+        print_usage()
+        sys.exit(2)
+    for opt, arg in opts:
+        if opt == '-h':
+            print_usage()
+            sys.exit()
+        elif opt in ("-r", "--root"):
+            root = arg
+        elif opt in ("-p", "--port"):
+            port = int(arg)
+        elif opt in ("-l", "--latency"):
+            latency = int(arg)
+        elif opt in ("-b", "--bandwidth"):
+            bandwidth = int(arg)
+
+    if root is None:
+        print_usage()
+        sys.exit(2)
+
+    return root, port, latency, bandwidth
+
+
+def main(argv):
+    root, port, latency, bandwidth = parse_argv(argv)
+    server = PageServer(root, latency=latency, bandwidth=bandwidth,
+                        port=port, quiet=False)
+    print("Serving {} at {}".format(server.root, server.url()))
+    try:
+        server.httpd.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    server.httpd.server_close()
+
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
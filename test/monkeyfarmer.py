@@ -208,6 +208,7 @@ class Browser:
     # pylint: disable=locally-disabled, too-many-instance-attributes, dangerous-default-value, invalid-name
 
     def __init__(self, monkey_cmd=["./nsmonkey"], monkey_env=None, quiet=False, *, wrapper=None):
+        launched = time.time()
         self.farmer = MonkeyFarmer(
             monkey_cmd=monkey_cmd,
             monkey_env=monkey_env,
@@ -220,6 +221,9 @@ class Browser:
         self.started = False
         self.stopped = False
         self.launchurl = None
+        self.last_error = None
+        self.startup_ms = None
+        self.launch_ms = None
         now = time.time()
         timeout = now + 1
 
@@ -231,6 +235,9 @@ class Browser:
             if time.time() > timeout:
                 break
 
+        if self.started:
+            self.launch_ms = int((time.time() - launched) * 1000)
+
     def pass_options(self, *opts):
         if len(opts) > 0:
             self.farmer.tell_monkey("OPTIONS " + (" ".join(['--' + opt for opt in opts])))
@@ -244,6 +251,18 @@ class Browser:
     def quit(self):
         self.farmer.tell_monkey("QUIT")
 
+    def peak_memory(self):
+        # peak resident set size of the monkey process in kilobytes,
+        # or None where the platform does not report it
+        try:
+            with open("/proc/{}/status".format(self.farmer.monkey.pid)) as status:
+                for line in status:
+                    if line.startswith("VmHWM:"):
+                        return int(line.split()[1])
+        except OSError:
+            pass
+        return None
+
     def quit_and_wait(self):
         self.quit()
         self.farmer.loop()
@@ -252,6 +271,8 @@ class Browser:
     def handle_GENERIC(self, what, *args):
         if what == 'STARTED':
             self.started = True
+            if len(args) > 0:
+                self.startup_ms = int(args[0])
         elif what == 'FINISHED':
             self.stopped = True
         elif what == 'LAUNCH':
@@ -263,6 +284,9 @@ class Browser:
         else:
             pass
 
+    def handle_ERROR(self, *args):
+        self.last_error = " ".join(args)
+
     def handle_WINDOW(self, action, _win, winid, *args):
         if action == "NEW":
             new_win = BrowserWindow(self, winid, *args)
@@ -406,6 +430,7 @@ class BrowserWindow:
         self.plotting = False
         self.log_entries = []
         self.page_info_state = "UNKNOWN"
+        self.timing = None
 
     def kill(self):
         self.browser.farmer.tell_monkey("WINDOW DESTROY %s" % self.winid)
@@ -441,9 +466,27 @@ class BrowserWindow:
     def click(self, x, y, button="LEFT", kind="SINGLE"):
         self.browser.farmer.tell_monkey("WINDOW CLICK WIN %s X %s Y %s BUTTON %s KIND %s" % (self.winid, x, y, button, kind))
 
+    def scroll(self, x, y):
+        self.browser.farmer.tell_monkey("WINDOW SCROLL WIN %s X %s Y %s" % (self.winid, x, y))
+
     def js_exec(self, src):
         self.browser.farmer.tell_monkey("WINDOW EXEC WIN %s %s" % (self.winid, src))
 
+    def get_timing(self):
+        # phase timings of the last fetch, or None where monkey rejected
+        # the request or stopped before replying
+        self.timing = None
+        self.browser.last_error = None
+        self.browser.farmer.tell_monkey("WINDOW TIMING WIN %s" % self.winid)
+        while self.timing is None:
+            if self.browser.last_error is not None:
+                print("*** Window timing failed: {}".format(self.browser.last_error))
+                break
+            if self.browser.stopped or self.browser.farmer.deadmonkey or not self.alive:
+                break
+            self.browser.farmer.loop(once=True)
+        return self.timing
+
     def handle(self, action, *args):
         handler = getattr(self, "handle_window_" + action, None)
         if handler is not None:
@@ -526,6 +569,13 @@ class BrowserWindow:
     def handle_window_PAGE_STATUS(self, _status, status):
         self.page_info_state = status
 
+    def handle_window_TIMING(self, *args):
+        # phase name and time in ms pairs, -1 where not yet reached
+        self.timing = {}
+        for phase, taken in zip(args[0::2], args[1::2]):
+            taken = int(taken)
+            self.timing[phase.lower()] = taken if taken >= 0 else None
+
     def load_page(self, url=None, referer=None):
         if url is not None:
             self.go(url, referer)
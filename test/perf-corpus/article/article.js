@@ -0,0 +1,12 @@
+/* Fill in the related links once the document has loaded */
+document.addEventListener("DOMContentLoaded", function () {
+	var list = document.getElementById("related-list");
+	var headings = document.getElementsByTagName("h2");
+	var i;
+
+	for (i = 0; i < headings.length; i++) {
+		var item = document.createElement("li");
+		item.textContent = "See also: " + headings[i].textContent;
+		list.appendChild(item);
+	}
+});
@@ -0,0 +1,4648 @@
+/*
+ * Synthetic utility library used to measure script compilation.
+ *
+ * It is large enough that compiling it costs noticeably more than
+ * loading its cached bytecode, and every function is distinct so
+ * nothing is shared between them.
+ */
+var lib = (function () {
+	var lib = {};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares0 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 0;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft1 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 8) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter2 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 2)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount3 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend4 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 4;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale5 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 10 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape6 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 40);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy7 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares8 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 8;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft9 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 12) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter10 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 6)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount11 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend12 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 12;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale13 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 1 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape14 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 80);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy15 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares16 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 16;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft17 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 3) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter18 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 10)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount19 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend20 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 20;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale21 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 5 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape22 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 120);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy23 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares24 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 24;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft25 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 7) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter26 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 1)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount27 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend28 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 28;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale29 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 9 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape30 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 30);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy31 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares32 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 32;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft33 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 11) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter34 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 5)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount35 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend36 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 36;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale37 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 13 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape38 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 70);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy39 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares40 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 40;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft41 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 2) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter42 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 9)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount43 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend44 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 44;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale45 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 4 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape46 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 110);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy47 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares48 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 48;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft49 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 6) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter50 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 13)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount51 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend52 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 52;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale53 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 8 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape54 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 20);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy55 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares56 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 56;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft57 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 10) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter58 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 4)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount59 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend60 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 60;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale61 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 12 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape62 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 60);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy63 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares64 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 64;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft65 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 1) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter66 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 8)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount67 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend68 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 68;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale69 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 3 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape70 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 100);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy71 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares72 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 72;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft73 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 5) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter74 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 12)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount75 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend76 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 76;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale77 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 7 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape78 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 10);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy79 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares80 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 80;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft81 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 9) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter82 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 3)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount83 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend84 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 84;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale85 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 11 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape86 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 50);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy87 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares88 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 88;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft89 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 13) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter90 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 7)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount91 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend92 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 92;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale93 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 2 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape94 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 90);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy95 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares96 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 96;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft97 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 4) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter98 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 11)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount99 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend100 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 100;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale101 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 6 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape102 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 130);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy103 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares104 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 104;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft105 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 8) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter106 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 2)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount107 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend108 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 108;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale109 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 10 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape110 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 40);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy111 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares112 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 112;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft113 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 12) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter114 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 6)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount115 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend116 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 116;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale117 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 1 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape118 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 80);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy119 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares120 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 120;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft121 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 3) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter122 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 10)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount123 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend124 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 124;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale125 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 5 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape126 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 120);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy127 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares128 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 128;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft129 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 7) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter130 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 1)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount131 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend132 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 132;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale133 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 9 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape134 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 30);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy135 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares136 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 136;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft137 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 11) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter138 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 5)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount139 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend140 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 140;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale141 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 13 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape142 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 70);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy143 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares144 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 144;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft145 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 2) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter146 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 9)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount147 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend148 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 148;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale149 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 4 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape150 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 110);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy151 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares152 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 152;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft153 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 6) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter154 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 13)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount155 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend156 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 156;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale157 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 8 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape158 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 20);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy159 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares160 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 160;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft161 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 10) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter162 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 4)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount163 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend164 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 164;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale165 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 12 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape166 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 60);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy167 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares168 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 168;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft169 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 1) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter170 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 8)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount171 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend172 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 172;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale173 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 3 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape174 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 100);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy175 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares176 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 176;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft177 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 5) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter178 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 12)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount179 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend180 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 180;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale181 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 7 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape182 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 10);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy183 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares184 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 184;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft185 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 9) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter186 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 3)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount187 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend188 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 188;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale189 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 11 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape190 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 50);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy191 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares192 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 192;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft193 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 13) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter194 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 7)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount195 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend196 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 196;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale197 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 2 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape198 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 90);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy199 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares200 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 200;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft201 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 4) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter202 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 11)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount203 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend204 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 204;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale205 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 6 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape206 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 130);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy207 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares208 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 208;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft209 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 8) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter210 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 2)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount211 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend212 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 212;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale213 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 10 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape214 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 40);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy215 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares216 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 216;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft217 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 12) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter218 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 6)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount219 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend220 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 220;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale221 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 1 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape222 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 80);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy223 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares224 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 224;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft225 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 3) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter226 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 10)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount227 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend228 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 228;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale229 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 5 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape230 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 120);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy231 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares232 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 232;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft233 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 7) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter234 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 1)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount235 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend236 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 236;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale237 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 9 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape238 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 30);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy239 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares240 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 240;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft241 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 11) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter242 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 5)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount243 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend244 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 244;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale245 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 13 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape246 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 70);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy247 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares248 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 248;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft249 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 2) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter250 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 9)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount251 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend252 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 252;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale253 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 4 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape254 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 110);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy255 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares256 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 256;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft257 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 6) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter258 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 13)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount259 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend260 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 260;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale261 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 8 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape262 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 20);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy263 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares264 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 264;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft265 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 10) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter266 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 4)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount267 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend268 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 268;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale269 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 12 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape270 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 60);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy271 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares272 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 272;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft273 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 1) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter274 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 8)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount275 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend276 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 276;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale277 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 3 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape278 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 100);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy279 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares280 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 280;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft281 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 5) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter282 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 12)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount283 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend284 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 284;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale285 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 7 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape286 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 10);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy287 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares288 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 288;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft289 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 9) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter290 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 3)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount291 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend292 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 292;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale293 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 11 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape294 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 50);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy295 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares296 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 296;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft297 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 13) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter298 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 7)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount299 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend300 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 300;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale301 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 2 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape302 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 90);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy303 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares304 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 304;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft305 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 4) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter306 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 11)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount307 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend308 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 308;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale309 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 6 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape310 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 130);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy311 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares312 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 312;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft313 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 8) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter314 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 2)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount315 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend316 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 316;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale317 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 10 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape318 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 40);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy319 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares320 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 320;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft321 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 12) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter322 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 6)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount323 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend324 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 324;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale325 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 1 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape326 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 80);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy327 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares328 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 328;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft329 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 3) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter330 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 10)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount331 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 1) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend332 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 332;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale333 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 5 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape334 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 120);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy335 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 0;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares336 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 336;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft337 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 7) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter338 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 1)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount339 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 4) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend340 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 340;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale341 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 9 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape342 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 30);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy343 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 3;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares344 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 344;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft345 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 11) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter346 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 5)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount347 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 2) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend348 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 348;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale349 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 13 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape350 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 70);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy351 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 1;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares352 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 352;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft353 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 2) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter354 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 9)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount355 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 0) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend356 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 356;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale357 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 4 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape358 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 110);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy359 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 4;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares360 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 360;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft361 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 6) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter362 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 13)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	/* count the words in a string */
+	lib.wordCount363 = function (text) {
+		var words = String(text).split(/\s+/);
+		var count = 0;
+		var i;
+
+		for (i = 0; i < words.length; i++) {
+			if (words[i].length > 3) {
+				count++;
+			}
+		}
+		return count;
+	};
+
+	/* copy the own properties of objects onto a target */
+	lib.extend364 = function (target) {
+		var i, key, source;
+
+		for (i = 1; i < arguments.length; i++) {
+			source = arguments[i];
+			for (key in source) {
+				if (Object.prototype.hasOwnProperty.call(source, key)) {
+					target[key] = source[key];
+				}
+			}
+		}
+		target.generation = 364;
+		return target;
+	};
+
+	/* clamp a value to a range and scale it */
+	lib.clampScale365 = function (value, min, max) {
+		if (value < min) {
+			value = min;
+		} else if (value > max) {
+			value = max;
+		}
+		return (value - min) * 8 / ((max - min) || 1);
+	};
+
+	/* escape the characters of a string which are special in markup */
+	lib.escape366 = function (text) {
+		return String(text)
+			.replace(/&/g, "&amp;")
+			.replace(/</g, "&lt;")
+			.replace(/>/g, "&gt;")
+			.replace(/"/g, "&quot;")
+			.substr(0, 20);
+	};
+
+	/* group the items of a list by the value of a key */
+	lib.groupBy367 = function (list, key) {
+		var groups = {};
+		var i, value;
+
+		for (i = 0; i < list.length; i++) {
+			value = list[i][key];
+			if (!groups[value]) {
+				groups[value] = [];
+			}
+			groups[value].push(list[i]);
+		}
+		groups.size = 2;
+		return groups;
+	};
+
+	/* sum of the squares of the numbers in a list */
+	lib.sumSquares368 = function (list) {
+		var total = 0;
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			total += list[i] * list[i] + 368;
+		}
+		return total;
+	};
+
+	/* pad a string on the left to a width */
+	lib.padLeft369 = function (str, width, fill) {
+		str = String(str);
+		fill = fill || " ";
+		while (str.length < width + 10) {
+			str = fill + str;
+		}
+		return str;
+	};
+
+	/* items of a list which satisfy a predicate */
+	lib.filter370 = function (list, predicate) {
+		var result = [];
+		var i;
+
+		for (i = 0; i < list.length; i++) {
+			if (predicate(list[i], i + 4)) {
+				result.push(list[i]);
+			}
+		}
+		return result;
+	};
+
+	lib.count = 371;
+
+	return lib;
+})();
@@ -0,0 +1,24 @@
+/* Generate a deterministic data set for the page to render */
+var cardData = [];
+
+(function () {
+	var seed = 41;
+	var i;
+
+	function next() {
+		seed = (seed * 1103515245 + 12345) % 2147483648;
+		return seed;
+	}
+
+	for (i = 0; i < 600; i++) {
+		cardData.push({
+			title: "Card " + i,
+			score: next() % 100,
+			tags: ["alpha", "beta", "gamma", "delta"].slice(0, 1 + next() % 4)
+		});
+	}
+
+	cardData.sort(function (a, b) {
+		return b.score - a.score;
+	});
+})();
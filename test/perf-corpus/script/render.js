@@ -0,0 +1,23 @@
+/* Build the card elements from the generated data */
+(function () {
+	var container = document.getElementById("cards");
+	var i;
+
+	for (i = 0; i < cardData.length; i++) {
+		var card = document.createElement("div");
+		var heading = document.createElement("h3");
+		var score = document.createElement("span");
+		var tags = document.createElement("p");
+
+		card.className = "card";
+		score.className = "score";
+		score.textContent = cardData[i].score;
+		heading.textContent = cardData[i].title;
+		heading.appendChild(score);
+		tags.textContent = cardData[i].tags.join(", ");
+
+		card.appendChild(heading);
+		card.appendChild(tags);
+		container.appendChild(card);
+	}
+})();
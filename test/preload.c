@@ -0,0 +1,192 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Test HTML speculative preload scanner.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+
+#include "utils/errors.h"
+#include "html/preload.h"
+
+#define NELEMS(x)  (sizeof(x) / sizeof((x)[0]))
+
+/** document used by the tests */
+static const char *test_document =
+	"<!DOCTYPE html>\n"
+	"<html><head>\n"
+	"<base href=\"http://example.com/dir/\">\n"
+	"<!-- <link rel=stylesheet href=commented.css> -->\n"
+	"<LINK REL=\"Stylesheet\" HREF = 'a.css' >\n"
+	"<link rel=\"alternate stylesheet\" href=\"alt.css\">\n"
+	"<link rel=stylesheet media=print href=print.css>\n"
+	"<link rel=stylesheet type=text/plain href=plain.css>\n"
+	"<link rel=\"icon\" href=\"favicon.ico\">\n"
+	"<link rel=stylesheet media=\"screen, print\" href=\"b.css?x=1&amp;y=2\">\n"
+	"<script src=\"first.js\"></script>\n"
+	"<script>document.write('<img src=\"written.png\">');</script>\n"
+	"<style>p > a { } <img src=styled.png></style>\n"
+	"<title><script src=title.js></title>\n"
+	"</head><body>\n"
+	"<img alt=\"x > y\" src=\"  &#x69;mage.png \">\n"
+	"<textarea><img src=text.png></textarea>\n"
+	"<img src=last.png/>\n"
+	"<script async src=end.js></script>\n"
+	"</body></html>\n";
+
+/** references expected from the test document */
+static const struct {
+	enum html_preload_type type;
+	const char *url;
+} expected[] = {
+	{ HTML_PRELOAD_BASE, "http://example.com/dir/" },
+	{ HTML_PRELOAD_STYLESHEET, "a.css" },
+	{ HTML_PRELOAD_STYLESHEET, "b.css?x=1&y=2" },
+	{ HTML_PRELOAD_SCRIPT, "first.js" },
+	{ HTML_PRELOAD_IMAGE, "image.png" },
+	{ HTML_PRELOAD_IMAGE, "last.png/" },
+	{ HTML_PRELOAD_SCRIPT, "end.js" },
+};
+
+/** references reported by the scanner */
+static struct {
+	enum html_preload_type type;
+	char url[64];
+} reported[16];
+static unsigned int reported_count;
+
+static void test_cb(enum html_preload_type type, const char *url, void *pw)
+{
+	ck_assert(pw == &reported);
+	ck_assert_uint_lt(reported_count, NELEMS(reported));
+
+	reported[reported_count].type = type;
+	snprintf(reported[reported_count].url,
+		 sizeof(reported[reported_count].url), "%s", url);
+	reported_count++;
+}
+
+/**
+ * Scan the test document in chunks of the given size
+ */
+static void scan_document(size_t chunk)
+{
+	struct html_preload *preload;
+	size_t len = strlen(test_document);
+	size_t offset;
+
+	reported_count = 0;
+
+	ck_assert(html_preload_create(test_cb, &reported,
+				      &preload) == NSERROR_OK);
+
+	for (offset = 0; offset < len; offset += chunk) {
+		html_preload_scan(preload, test_document + offset,
+				  (len - offset) < chunk ? (len - offset) : chunk);
+	}
+
+	html_preload_destroy(preload);
+}
+
+/**
+ * The expected references are found however the document is split
+ */
+START_TEST(preload_scan_test)
+{
+	unsigned int idx;
+
+	scan_document(_i);
+
+	ck_assert_uint_eq(reported_count, NELEMS(expected));
+	for (idx = 0; idx < NELEMS(expected); idx++) {
+		ck_assert_int_eq(reported[idx].type, expected[idx].type);
+		ck_assert_str_eq(reported[idx].url, expected[idx].url);
+	}
+}
+END_TEST
+
+/**
+ * Over long tags are ignored without losing the raw text state
+ */
+START_TEST(preload_overflow_test)
+{
+	struct html_preload *preload;
+	char *tag;
+
+	tag = malloc(8192);
+	ck_assert(tag != NULL);
+	strcpy(tag, "<script src=long.js data-x=\"");
+	memset(tag + strlen(tag), 'x', 4096);
+	strcpy(tag + strlen(tag) - 1, "\"><img src=inner.png></script>");
+
+	reported_count = 0;
+	ck_assert(html_preload_create(test_cb, &reported,
+				      &preload) == NSERROR_OK);
+	html_preload_scan(preload, tag, strlen(tag));
+	html_preload_scan(preload, "<img src=after.png>", 19);
+	html_preload_destroy(preload);
+	free(tag);
+
+	ck_assert_uint_eq(reported_count, 1);
+	ck_assert_str_eq(reported[0].url, "after.png");
+}
+END_TEST
+
+static TCase *preload_case_create(void)
+{
+	TCase *tc;
+	tc = tcase_create("Scanner");
+
+	tcase_add_loop_test(tc, preload_scan_test, 1, 17);
+	tcase_add_test(tc, preload_overflow_test);
+
+	return tc;
+}
+
+/*
+ * preload test suite creation
+ */
+static Suite *preload_suite_create(void)
+{
+	Suite *s;
+	s = suite_create("HTML preload");
+
+	suite_add_tcase(s, preload_case_create());
+
+	return s;
+}
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	SRunner *sr;
+
+	sr = srunner_create(preload_suite_create());
+
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
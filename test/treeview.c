@@ -0,0 +1,466 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Test treeview positioning and redraw on large trees.
+ *
+ * The treeview is driven through its core window interface with a
+ * recording plotter, so the nodes drawn for a clip region and the nodes
+ * found at a position can be checked against the expected layout.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+#include <libwapcaplet/libwapcaplet.h>
+#include <nsutils/time.h>
+
+#include "utils/errors.h"
+#include "utils/nscolour.h"
+#include "utils/nsoption.h"
+#include "utils/nsurl.h"
+#include "netsurf/inttypes.h"
+#include "netsurf/plotters.h"
+#include "netsurf/core_window.h"
+#include "desktop/treeview.h"
+
+#include "corewindow.h"
+
+/** Number of folders in the large tree */
+#define N_FOLDERS 100
+
+/** Number of entries in each folder of the large tree */
+#define N_ENTRIES 1000
+
+/** Rows occupied by an expanded folder with collapsed entries */
+#define FOLDER_ROWS (N_ENTRIES + 1)
+
+/** Number of iterations in the benchmarks */
+#define BENCH_ITERATIONS 10000
+
+#define BG_ODD 0x000001
+#define BG_EVEN 0x000002
+
+/* Stubs for the treeview's dependencies */
+
+struct nsoption_s *nsoptions = NULL;
+struct nsoption_s *nsoptions_default = NULL;
+static struct nsoption_s test_options[NSOPTION_LISTEND];
+
+nserror nsurl_create(const char * const url_s, nsurl **url)
+{
+	return NSERROR_NOT_IMPLEMENTED;
+}
+
+void nsurl_unref(nsurl *url)
+{
+}
+
+/* Plotter recording the first node row drawn */
+
+struct test_plot_record {
+	int rectangles; /**< Number of rectangles plotted */
+	int first_y; /**< Top of first rectangle plotted */
+	colour first_fill; /**< Fill colour of first rectangle plotted */
+	char first_text[32]; /**< First text plotted */
+};
+
+static struct test_plot_record plot_record;
+
+static nserror test_plot_clip(const struct redraw_context *ctx,
+		const struct rect *clip)
+{
+	return NSERROR_OK;
+}
+
+static nserror test_plot_rectangle(const struct redraw_context *ctx,
+		const plot_style_t *pstyle,
+		const struct rect *rectangle)
+{
+	if (plot_record.rectangles++ == 0) {
+		plot_record.first_y = rectangle->y0;
+		plot_record.first_fill = pstyle->fill_colour;
+	}
+	return NSERROR_OK;
+}
+
+static nserror test_plot_bitmap(const struct redraw_context *ctx,
+		struct bitmap *bitmap,
+		int x, int y, int width, int height,
+		colour bg, bitmap_flags_t flags)
+{
+	return NSERROR_OK;
+}
+
+static nserror test_plot_text(const struct redraw_context *ctx,
+		const plot_font_style_t *fstyle,
+		int x, int y,
+		const char *text, size_t length)
+{
+	if (plot_record.first_text[0] == '\0') {
+		if (length >= sizeof(plot_record.first_text)) {
+			length = sizeof(plot_record.first_text) - 1;
+		}
+		memcpy(plot_record.first_text, text, length);
+		plot_record.first_text[length] = '\0';
+	}
+	return NSERROR_OK;
+}
+
+static const struct plotter_table test_plotters = {
+	.clip = test_plot_clip,
+	.rectangle = test_plot_rectangle,
+	.bitmap = test_plot_bitmap,
+	.text = test_plot_text,
+	.option_knockout = false,
+};
+
+static const struct redraw_context test_redraw_ctx = {
+	.interactive = true,
+	.background_images = true,
+	.plot = &test_plotters,
+};
+
+/* The large tree */
+
+enum test_fields {
+	TEST_TITLE,
+	TEST_URL,
+	TEST_FOLDER,
+	N_TEST_FIELDS
+};
+
+static nserror test_folder_cb(struct treeview_node_msg msg, void *data)
+{
+	return NSERROR_OK;
+}
+
+static nserror test_entry_cb(struct treeview_node_msg msg, void *data)
+{
+	return NSERROR_OK;
+}
+
+static struct treeview_callback_table test_tree_cb = {
+	.folder = test_folder_cb,
+	.entry = test_entry_cb,
+};
+
+static struct treeview_field_desc test_fields[N_TEST_FIELDS];
+static treeview *tree;
+static treeview_node *folders[N_FOLDERS];
+static treeview_node *entries[N_FOLDERS][N_ENTRIES];
+static char names[N_FOLDERS][N_ENTRIES + 1][24];
+static int line_height;
+
+/**
+ * Get the name of the node on a row of the fully expanded large tree
+ */
+static const char *row_name(int row)
+{
+	int f = row / FOLDER_ROWS;
+	int e = row % FOLDER_ROWS;
+
+	if (e == 0) {
+		return names[f][N_ENTRIES];
+	}
+	return names[f][e - 1];
+}
+
+/**
+ * Redraw a window sized clip region at a y offset
+ */
+static void redraw_at(int y)
+{
+	struct rect clip = {
+		.x0 = 0,
+		.y0 = y,
+		.x1 = TEST_CW_WIDTH,
+		.y1 = y + TEST_CW_HEIGHT,
+	};
+
+	memset(&plot_record, 0, sizeof(plot_record));
+	treeview_redraw(tree, 0, 0, &clip, &test_redraw_ctx);
+}
+
+static void large_tree_create(void)
+{
+	struct treeview_field_data field[N_TEST_FIELDS];
+	nserror res;
+	int f, e;
+
+	memset(test_options, 0, sizeof(test_options));
+	nsoptions = test_options;
+
+	nscolours[NSCOLOUR_WIN_ODD_BG] = BG_ODD;
+	nscolours[NSCOLOUR_WIN_EVEN_BG] = BG_EVEN;
+
+	res = treeview_init();
+	ck_assert(res == NSERROR_OK);
+
+	ck_assert(lwc_intern_string("Title", 5,
+			&test_fields[TEST_TITLE].field) == lwc_error_ok);
+	test_fields[TEST_TITLE].flags = TREE_FLAG_DEFAULT;
+	ck_assert(lwc_intern_string("URL", 3,
+			&test_fields[TEST_URL].field) == lwc_error_ok);
+	test_fields[TEST_URL].flags = TREE_FLAG_SHOW_NAME;
+	ck_assert(lwc_intern_string("Folder", 6,
+			&test_fields[TEST_FOLDER].field) == lwc_error_ok);
+	test_fields[TEST_FOLDER].flags = TREE_FLAG_DEFAULT;
+
+	res = treeview_create(&tree, &test_tree_cb,
+			N_TEST_FIELDS, test_fields,
+			&test_cw_table, test_cw,
+			TREEVIEW_NO_FLAGS);
+	ck_assert(res == NSERROR_OK);
+
+	for (f = 0; f < N_FOLDERS; f++) {
+		snprintf(names[f][N_ENTRIES], sizeof(names[f][N_ENTRIES]),
+				"Folder %d", f);
+		field[TEST_FOLDER].field = test_fields[TEST_FOLDER].field;
+		field[TEST_FOLDER].value = names[f][N_ENTRIES];
+		field[TEST_FOLDER].value_len = strlen(names[f][N_ENTRIES]);
+
+		res = treeview_create_node_folder(tree, &folders[f],
+				(f > 0) ? folders[f - 1] : NULL,
+				(f > 0) ? TREE_REL_NEXT_SIBLING :
+						TREE_REL_FIRST_CHILD,
+				&field[TEST_FOLDER], &folders[f],
+				TREE_OPTION_SUPPRESS_RESIZE |
+				TREE_OPTION_SUPPRESS_REDRAW);
+		ck_assert(res == NSERROR_OK);
+
+		/* Entries added in reverse as first children */
+		for (e = N_ENTRIES - 1; e >= 0; e--) {
+			snprintf(names[f][e], sizeof(names[f][e]),
+					"Entry %d.%d", f, e);
+			field[TEST_TITLE].field = test_fields[TEST_TITLE].field;
+			field[TEST_TITLE].value = names[f][e];
+			field[TEST_TITLE].value_len = strlen(names[f][e]);
+			field[TEST_URL].field = test_fields[TEST_URL].field;
+			field[TEST_URL].value = "http://example.com/";
+			field[TEST_URL].value_len = 19;
+
+			res = treeview_create_node_entry(tree, &entries[f][e],
+					folders[f], TREE_REL_FIRST_CHILD,
+					field, &entries[f][e],
+					TREE_OPTION_SUPPRESS_RESIZE |
+					TREE_OPTION_SUPPRESS_REDRAW);
+			ck_assert(res == NSERROR_OK);
+		}
+	}
+
+	res = treeview_expand(tree, true);
+	ck_assert(res == NSERROR_OK);
+
+	line_height = treeview_get_height(tree) / (N_FOLDERS * FOLDER_ROWS);
+	ck_assert(line_height > 0);
+	ck_assert_int_eq(treeview_get_height(tree),
+			line_height * N_FOLDERS * FOLDER_ROWS);
+}
+
+static void large_tree_teardown(void)
+{
+	int i;
+
+	treeview_destroy(tree);
+	tree = NULL;
+
+	for (i = 0; i < N_TEST_FIELDS; i++) {
+		lwc_string_unref(test_fields[i].field);
+	}
+
+	treeview_fini();
+}
+
+/* Tests */
+
+/**
+ * Redraw starts at the node containing the top of the clip region
+ */
+START_TEST(treeview_redraw_start_test)
+{
+	int rows = N_FOLDERS * FOLDER_ROWS;
+	int row;
+
+	for (row = 0; row < rows; row += 997) {
+		redraw_at(row * line_height + line_height / 2);
+
+		ck_assert_int_eq(plot_record.first_y, row * line_height);
+		ck_assert_str_eq(plot_record.first_text, row_name(row));
+		ck_assert(plot_record.first_fill ==
+				((row & 1) ? BG_EVEN : BG_ODD));
+	}
+}
+END_TEST
+
+/**
+ * Node at a y position is found
+ */
+START_TEST(treeview_node_at_y_test)
+{
+	int rows = N_FOLDERS * FOLDER_ROWS;
+	int row;
+
+	for (row = 1; row < rows; row += 991) {
+		enum treeview_relationship rel;
+		treeview_node *relation;
+		int f = row / FOLDER_ROWS;
+		int e = row % FOLDER_ROWS;
+		nserror res;
+
+		res = treeview_get_relation(tree, &relation, &rel,
+				true, row * line_height + 1);
+		ck_assert(res == NSERROR_OK);
+
+		if (e == 0) {
+			/* Folder, after previous folder */
+			ck_assert(rel == TREE_REL_NEXT_SIBLING);
+			ck_assert(relation == folders[f - 1]);
+		} else if (e == 1) {
+			/* First entry in folder */
+			ck_assert(rel == TREE_REL_FIRST_CHILD);
+			ck_assert(relation == folders[f]);
+		} else {
+			ck_assert(rel == TREE_REL_NEXT_SIBLING);
+			ck_assert(relation == entries[f][e - 2]);
+		}
+	}
+}
+END_TEST
+
+/**
+ * Expanding, contracting and deleting nodes moves the nodes below
+ */
+START_TEST(treeview_resize_test)
+{
+	int row = N_FOLDERS * FOLDER_ROWS - 10;
+	nserror res;
+
+	/* Expanded entry adds a line for its URL field */
+	res = treeview_node_expand(tree, entries[10][10]);
+	ck_assert(res == NSERROR_OK);
+
+	redraw_at((row + 1) * line_height + line_height / 2);
+	ck_assert_int_eq(plot_record.first_y, (row + 1) * line_height);
+	ck_assert_str_eq(plot_record.first_text, row_name(row));
+	ck_assert(plot_record.first_fill == ((row & 1) ? BG_EVEN : BG_ODD));
+
+	/* Contracted folder loses its entries */
+	res = treeview_node_contract(tree, folders[20]);
+	ck_assert(res == NSERROR_OK);
+
+	redraw_at((row + 1 - N_ENTRIES) * line_height + line_height / 2);
+	ck_assert_int_eq(plot_record.first_y,
+			(row + 1 - N_ENTRIES) * line_height);
+	ck_assert_str_eq(plot_record.first_text, row_name(row));
+
+	/* Deleted folder takes its line */
+	res = treeview_delete_node(tree, folders[20],
+			TREE_OPTION_SUPPRESS_RESIZE |
+			TREE_OPTION_SUPPRESS_REDRAW);
+	ck_assert(res == NSERROR_OK);
+
+	redraw_at((row - N_ENTRIES) * line_height + line_height / 2);
+	ck_assert_int_eq(plot_record.first_y,
+			(row - N_ENTRIES) * line_height);
+	ck_assert_str_eq(plot_record.first_text, row_name(row));
+	ck_assert(plot_record.first_fill ==
+			((row - FOLDER_ROWS) & 1 ? BG_EVEN : BG_ODD));
+}
+END_TEST
+
+/**
+ * Benchmark window sized redraws and pointer movement over the tree
+ */
+START_TEST(treeview_benchmark_test)
+{
+	int height = treeview_get_height(tree) - TEST_CW_HEIGHT;
+	uint64_t ms_before;
+	uint64_t ms_after;
+	unsigned int seed = 1;
+	int i;
+
+	nsu_getmonotonic_ms(&ms_before);
+	for (i = 0; i < BENCH_ITERATIONS; i++) {
+		redraw_at(rand_r(&seed) % height);
+	}
+	nsu_getmonotonic_ms(&ms_after);
+	printf("%d redraws of %d nodes in %"PRIu64"ms\n",
+			BENCH_ITERATIONS, N_FOLDERS * FOLDER_ROWS,
+			ms_after - ms_before);
+
+	nsu_getmonotonic_ms(&ms_before);
+	for (i = 0; i < BENCH_ITERATIONS; i++) {
+		treeview_mouse_action(tree, BROWSER_MOUSE_HOVER,
+				100, rand_r(&seed) % height);
+	}
+	nsu_getmonotonic_ms(&ms_after);
+	printf("%d pointer moves over %d nodes in %"PRIu64"ms\n",
+			BENCH_ITERATIONS, N_FOLDERS * FOLDER_ROWS,
+			ms_after - ms_before);
+}
+END_TEST
+
+
+static Suite *treeview_suite(void)
+{
+	Suite *s;
+	TCase *tc_large;
+
+	s = suite_create("treeview");
+
+	/* Large tree */
+	tc_large = tcase_create("Large tree");
+
+	tcase_add_unchecked_fixture(tc_large,
+				    large_tree_create,
+				    large_tree_teardown);
+
+	tcase_add_test(tc_large, treeview_redraw_start_test);
+	tcase_add_test(tc_large, treeview_node_at_y_test);
+	tcase_add_test(tc_large, treeview_benchmark_test);
+	tcase_add_test(tc_large, treeview_resize_test);
+
+	tcase_set_timeout(tc_large, 120);
+
+	suite_add_tcase(s, tc_large);
+
+	return s;
+}
+
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	Suite *s;
+	SRunner *sr;
+
+	s = treeview_suite();
+
+	sr = srunner_create(s);
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -895,6 +895,7 @@ END_TEST
 START_TEST(urldb_update_visit_test)
 {
 	nsurl *url;
+	unsigned int generation;
 
 	url = make_url(wikipedia_url);
 
@@ -902,9 +903,13 @@ START_TEST(urldb_update_visit_test)
 
 	urldb_add_url(url);
 
+	generation = urldb_get_visit_generation();
+
 	urldb_update_url_visit_data(url);
 	/** \todo test needs to check results */
 
+	ck_assert(urldb_get_visit_generation() != generation);
+
 	nsurl_unref(url);
 }
 END_TEST
@@ -912,6 +917,7 @@ END_TEST
 START_TEST(urldb_reset_visit_test)
 {
 	nsurl *url;
+	unsigned int generation;
 
 	url = make_url(wikipedia_url);
 
@@ -919,9 +925,13 @@ START_TEST(urldb_reset_visit_test)
 
 	urldb_add_url(url);
 
+	generation = urldb_get_visit_generation();
+
 	urldb_reset_url_visit_data(url);
 	/** \todo test needs to check results */
 
+	ck_assert(urldb_get_visit_generation() != generation);
+
 	nsurl_unref(url);
 }
 END_TEST
@@ -0,0 +1,247 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Test worker thread pool.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <check.h>
+
+#include "utils/errors.h"
+#include "utils/worker.h"
+#include "netsurf/misc.h"
+#include "desktop/gui_table.h"
+
+#define JOB_COUNT 64
+
+/** number of worker threads the tests use */
+#define THREAD_COUNT 4
+
+/** work submitted by the tests */
+struct test_job {
+	unsigned int idx; /**< submission index */
+	unsigned int input; /**< value the work operates on */
+	unsigned int output; /**< result of the work */
+	bool ran; /**< the work has been run */
+};
+
+static struct test_job jobs[JOB_COUNT];
+
+/** submission indexes in the order completions were reported */
+static int completed[JOB_COUNT];
+static unsigned int completed_count;
+
+/** the single scheduled callback, the pool only schedules its poll */
+static void (*sched_cb)(void *p);
+static void *sched_pw;
+
+static nserror test_schedule(int t, void (*callback)(void *p), void *p)
+{
+	if (t < 0) {
+		sched_cb = NULL;
+	} else {
+		sched_cb = callback;
+		sched_pw = p;
+	}
+	return NSERROR_OK;
+}
+
+static struct gui_misc_table test_misc_table = {
+	.schedule = test_schedule,
+};
+
+static struct netsurf_table test_table = {
+	.misc = &test_misc_table,
+};
+
+struct netsurf_table *guit = &test_table;
+
+
+/**
+ * Run the scheduler until the pool has nothing outstanding
+ */
+static void run_scheduler(void)
+{
+	void (*cb)(void *p);
+
+	while (sched_cb != NULL) {
+		cb = sched_cb;
+		sched_cb = NULL;
+		usleep(1000);
+		cb(sched_pw);
+	}
+}
+
+/**
+ * Work which takes a varying time to complete
+ */
+static void test_run(void *pw)
+{
+	struct test_job *job = pw;
+	unsigned int idx;
+
+	usleep((job->idx % 5) * 500);
+
+	job->output = 0;
+	for (idx = 0; idx < job->input; idx++) {
+		job->output += idx;
+	}
+	job->ran = true;
+}
+
+static void test_done(void *pw, bool cancelled)
+{
+	struct test_job *job = pw;
+
+	completed[completed_count++] = cancelled ? -1 : (int)job->idx;
+}
+
+static void submit_jobs(void)
+{
+	unsigned int idx;
+
+	for (idx = 0; idx < JOB_COUNT; idx++) {
+		jobs[idx].idx = idx;
+		jobs[idx].input = idx * 100;
+		jobs[idx].ran = false;
+		ck_assert(worker_submit(test_run, test_done,
+					&jobs[idx]) == NSERROR_OK);
+	}
+}
+
+static void worker_create(void)
+{
+	completed_count = 0;
+	ck_assert(worker_init(THREAD_COUNT) == NSERROR_OK);
+	ck_assert(worker_available());
+}
+
+static void worker_teardown(void)
+{
+	worker_fini();
+}
+
+
+/**
+ * Completions are reported in submission order with the work done
+ */
+START_TEST(worker_order_test)
+{
+	unsigned int idx;
+
+	submit_jobs();
+	run_scheduler();
+
+	ck_assert_int_eq(completed_count, JOB_COUNT);
+	for (idx = 0; idx < JOB_COUNT; idx++) {
+		ck_assert_int_eq(completed[idx], idx);
+		ck_assert(jobs[idx].ran);
+		ck_assert_int_eq(jobs[idx].output,
+				 (jobs[idx].input * (jobs[idx].input - 1)) / 2);
+	}
+}
+END_TEST
+
+/**
+ * Cancelled work is reported as cancelled in its place
+ */
+START_TEST(worker_cancel_test)
+{
+	unsigned int idx;
+
+	submit_jobs();
+	worker_cancel(&jobs[JOB_COUNT - 1]);
+	worker_cancel(&jobs[JOB_COUNT / 2]);
+	run_scheduler();
+
+	ck_assert_int_eq(completed_count, JOB_COUNT);
+	for (idx = 0; idx < JOB_COUNT; idx++) {
+		if ((idx == JOB_COUNT - 1) || (idx == JOB_COUNT / 2)) {
+			ck_assert_int_eq(completed[idx], -1);
+		} else {
+			ck_assert_int_eq(completed[idx], idx);
+		}
+	}
+}
+END_TEST
+
+/**
+ * Outstanding work is reported as cancelled on finalisation
+ */
+START_TEST(worker_fini_test)
+{
+	unsigned int idx;
+
+	submit_jobs();
+	worker_fini();
+
+	ck_assert_int_eq(completed_count, JOB_COUNT);
+	for (idx = 0; idx < JOB_COUNT; idx++) {
+		ck_assert_int_eq(completed[idx], -1);
+	}
+	ck_assert(worker_available() == false);
+	ck_assert(worker_submit(test_run, test_done,
+				&jobs[0]) == NSERROR_NOT_IMPLEMENTED);
+}
+END_TEST
+
+static TCase *worker_case_create(void)
+{
+	TCase *tc;
+	tc = tcase_create("Worker pool");
+
+	tcase_add_checked_fixture(tc, worker_create, worker_teardown);
+
+	tcase_add_test(tc, worker_order_test);
+	tcase_add_test(tc, worker_cancel_test);
+	tcase_add_test(tc, worker_fini_test);
+
+	return tc;
+}
+
+/*
+ * worker test suite creation
+ */
+static Suite *worker_suite_create(void)
+{
+	Suite *s;
+	s = suite_create("Worker threads");
+
+	suite_add_tcase(s, worker_case_create());
+
+	return s;
+}
+
+int main(int argc, char **argv)
+{
+	int number_failed;
+	SRunner *sr;
+
+	sr = srunner_create(worker_suite_create());
+
+	srunner_run_all(sr, CK_ENV);
+
+	number_failed = srunner_ntests_failed(sr);
+	srunner_free(sr);
+
+	return (number_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -54,6 +54,18 @@ char *strndup(const char *s, size_t n);
 char *strcasestr(const char *haystack, const char *needle);
 #endif
 
+#if ((defined(_GNU_SOURCE) ||			\
+      defined(__APPLE__) ||			\
+      defined(__HAIKU__) ||			\
+      defined(__NetBSD__) ||			\
+      defined(__OpenBSD__)) &&			\
+     !defined(__serenity__))
+#define HAVE_MEMMEM
+#else
+#undef HAVE_MEMMEM
+void *memmem(const void *haystack, size_t haystacklen, const void *needle, size_t needlelen);
+#endif
+
 /* Although these platforms might have strftime or strptime they
  *  appear not to support the time_t seconds format specifier.
  */
@@ -151,6 +163,13 @@ char *realpath(const char *path, char *resolved_path);
 #undef HAVE_REGEX
 #endif
 
+/* posix_fadvise available for file access pattern hints */
+#if (((defined(_POSIX_C_SOURCE) && ((_POSIX_C_SOURCE - 0) >= 200112L)) || \
+      defined(_GNU_SOURCE)) &&						\
+     (defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__)))
+#define HAVE_POSIX_FADVISE
+#endif
+
 /* execinfo available for backtrace */
 #if ((defined(__linux__) && defined(__GLIBC__) && !defined(__UCLIBC__)) || \
      defined(__APPLE__))
@@ -23,9 +23,15 @@
  *
  * Native language messages are loaded from a file and stored hashed by key for
  * fast access.
+ *
+ * When built with WITH_BUILTIN_MESSAGES the default language messages are
+ * also compiled in as a read only minimal perfect hash table generated by
+ * split-messages.pl. It is consulted for any key not found in the loaded
+ * messages so frontends using the default language need not load any.
  */
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <assert.h>
 #include <errno.h>
 #include <stdio.h>
@@ -47,6 +53,69 @@
  */
 static struct hash_table *messages_hash = NULL;
 
+#ifdef WITH_BUILTIN_MESSAGES
+
+/**
+ * Builtin messages table entry
+ */
+struct messages_builtin_entry {
+	uint32_t key; /**< offset of key in string table */
+	uint32_t value; /**< offset of value in string table */
+};
+
+#include "messages.inc"
+
+/**
+ * Seeded FNV-1a hash of a message key.
+ *
+ * This must match the hash used by the table generator.
+ */
+static inline uint32_t messages_builtin_hash(const char *key, uint32_t seed)
+{
+	uint32_t h = 0x811c9dc5 ^ seed;
+
+	while (*key != 0) {
+		h ^= (uint8_t)*key++;
+		h *= 0x01000193;
+	}
+
+	return h;
+}
+
+/**
+ * Look up a message in the builtin table.
+ *
+ * The bucket a key hashes to gives the seed which places it in the table
+ *  so at most one comparison is needed.
+ *
+ * \param key key of message
+ * \return value of message or NULL if not found.
+ */
+static const char *messages_builtin_get(const char *key)
+{
+	const struct messages_builtin_entry *e;
+	uint32_t slot;
+
+	slot = messages_builtin_hash(key, 0) % MESSAGES_BUILTIN_BUCKETS;
+	slot = messages_builtin_hash(key, messages_builtin_displace[slot]) %
+		MESSAGES_BUILTIN_COUNT;
+	e = &messages_builtin_table[slot];
+
+	if (strcmp(messages_builtin_strings + e->key, key) != 0) {
+		return NULL;
+	}
+	return messages_builtin_strings + e->value;
+}
+
+#else
+
+static inline const char *messages_builtin_get(const char *key)
+{
+	return NULL;
+}
+
+#endif
+
 
 /**
  * Create a message context
@@ -162,6 +231,11 @@ messages_get_ctx(const char *key, struct hash_table *ctx)
 		r = hash_get(ctx, key);
 	}
 
+	/* fall back to the builtin messages */
+	if (r == NULL) {
+		r = messages_builtin_get(key);
+	}
+
 	/* If called with no context or unable to retrive a value
 	 * return the key.
 	 */
@@ -211,14 +285,17 @@ char *messages_get_buff(const char *key, ...)
 
 	assert(key != NULL);
 
-	if (messages_hash == NULL) {
-		return NULL;
+	if (messages_hash != NULL) {
+		msg_fmt = hash_get(messages_hash, key);
+	} else {
+		msg_fmt = NULL;
 	}
 
-	msg_fmt = hash_get(messages_hash, key);
-
 	if (msg_fmt == NULL) {
-		return NULL;
+		msg_fmt = messages_builtin_get(key);
+		if (msg_fmt == NULL) {
+			return NULL;
+		}
 	}
 
 	va_start(ap, key);
@@ -391,6 +468,10 @@ const char *messages_get_errorcode(nserror code)
 	case NSERROR_TIMEOUT:
 		/* Operation timed out */
 		return messages_get_ctx("Timeout", messages_hash);
+
+	case NSERROR_BLOCKED:
+		/* Content blocking refused the fetch */
+		return messages_get_ctx("Blocked", messages_hash);
 	}
 
 	/* The switch has no default, so the compiler should tell us when we
@@ -459,6 +540,25 @@ const char *messages_get_sslcode(ssl_cert_err code)
 	return messages_get_ctx("Unknown", messages_hash);
 }
 
+/* exported function documented in utils/messages.h */
+bool messages_builtin(const char *lang)
+{
+#ifdef WITH_BUILTIN_MESSAGES
+	size_t len = strlen(MESSAGES_BUILTIN_LANGUAGE);
+
+	if (strcmp(lang, "C") == 0) {
+		return true;
+	}
+
+	/* allow for territory and codeset e.g. en_GB.UTF-8 */
+	if ((strncmp(lang, MESSAGES_BUILTIN_LANGUAGE, len) == 0) &&
+	    ((lang[len] == 0) || (lang[len] == '_') || (lang[len] == '.'))) {
+		return true;
+	}
+#endif
+	return false;
+}
+
 /* exported function documented in utils/messages.h */
 void messages_destroy(void)
 {
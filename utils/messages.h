@@ -35,6 +35,7 @@
 #define NETSURF_UTILS_MESSAGES_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "utils/errors.h"
 #include "netsurf/ssl_certs.h"
@@ -99,6 +100,17 @@ const char *messages_get_sslcode(ssl_cert_err code);
  */
 char *messages_get_buff(const char *key, ...);
 
+/**
+ * Check if the builtin messages are in a language.
+ *
+ * When they are there is no need to load a messages file for the
+ *  language as every key is available without it.
+ *
+ * \param lang The language code, e.g. "en" or "en_GB".
+ * \return true if messages were built in and are in the language.
+ */
+bool messages_builtin(const char *lang);
+
 /**
  * Free memory used by the standard Messages hash
  */
@@ -63,7 +63,6 @@ sub main ()
     my $output;
     my $format;
     my $header;
-    my $footer;
     my $opt_ok;
 
     # option parsing:
@@ -81,7 +80,6 @@ sub main ()
         $output = output_stream();
         $format = formatter();
         $header = static_section('header');
-        $footer = static_section('footer');
     }
 
     # double check the options are sane (and we weren't asked for the help)
@@ -176,7 +174,8 @@ sub main ()
 	}
     }
 
-    print( $output $footer );
+    # the footer may depend on the messages output
+    print( $output static_section('footer') );
 }
 
 main();
@@ -297,6 +296,129 @@ TXT
     sub format { return join(' = ', $_[0], escape( $_[1] ) ) . "\n" }
 }
 
+{
+    package msgfmt::c; # minimal perfect hash table as C source
+
+    my @keys;
+    my %vals;
+
+    # seeded FNV-1a hash, must match messages_builtin_hash()
+    sub hash
+    {
+	my( $key, $seed ) = @_;
+	my $h = 0x811c9dc5 ^ $seed;
+
+	for my $c ( unpack( 'C*', $key ) )
+	{
+	    $h ^= $c;
+	    # multiply by the FNV prime 0x01000193 modulo 2^32
+	    $h = ( ( ( $h << 24 ) & 0xffffffff ) + $h * 0x193 ) & 0xffffffff;
+	}
+	return $h;
+    }
+
+    sub escape
+    {
+	my $str = shift();
+	$str =~ s/([\\"?])/\\$1/g;
+	$str =~ s/([^\x20-\x7e])/sprintf( '\\%03o', ord( $1 ) )/ge;
+	return $str;
+    }
+
+    sub format
+    {
+	# later definitions of a key replace earlier ones
+	exists( $vals{$_[0]} ) || push( @keys, $_[0] );
+	$vals{$_[0]} = $_[1];
+	return '';
+    }
+
+    sub header
+    {
+	my $in = $opt{input} || '-stdin-';
+	return <<TXT;
+/* This file is automatically generated from $in
+ * at build-time.  Please go and edit that instead of this.
+ */
+
+#define MESSAGES_BUILTIN_LANGUAGE "$opt{lang}"
+
+TXT
+    }
+
+    # Build the table with hash and displace. Keys are grouped into
+    # buckets and for each bucket, largest first, a seed is found which
+    # places all of its keys in unused slots.
+    sub footer
+    {
+	my $count = scalar( @keys );
+	my $nbuckets = int( $count / 3 ) + 1;
+	my @buckets;
+	my @displace = ( 0 ) x $nbuckets;
+	my @slots;
+	my $out;
+
+	$count > 0 || die( "No messages to build table from\n" );
+
+	for my $key ( @keys )
+	{
+	    push( @{ $buckets[ hash( $key, 0 ) % $nbuckets ] }, $key );
+	}
+
+	for my $b ( sort { scalar( @{ $buckets[$b] || [] } ) <=>
+			   scalar( @{ $buckets[$a] || [] } ) or $a <=> $b }
+		    ( 0 .. $nbuckets - 1 ) )
+	{
+	    my $members = $buckets[$b] || next;
+
+	  SEED: for my $seed ( 1 .. 0xffff )
+	    {
+		my %used;
+		for my $key ( @$members )
+		{
+		    my $slot = hash( $key, $seed ) % $count;
+		    next SEED if( defined( $slots[$slot] ) || $used{$slot} );
+		    $used{$slot} = $key;
+		}
+		@slots[ keys( %used ) ] = values( %used );
+		$displace[$b] = $seed;
+		last;
+	    }
+	    $displace[$b] || die( "Unable to place messages bucket $b\n" );
+	}
+
+	my $offset = 0;
+	my @entries;
+
+	$out = "static const char messages_builtin_strings[] =\n";
+	for my $key ( @slots )
+	{
+	    push( @entries, sprintf( "\t{ %u, %u },\n",
+				     $offset, $offset + length( $key ) + 1 ) );
+	    $offset += length( $key ) + length( $vals{$key} ) + 2;
+	    $out .= sprintf( "\t\"%s\\0\" \"%s\\0\"\n",
+			     escape( $key ), escape( $vals{$key} ) );
+	}
+	$out .= "\t;\n\n";
+
+	$out .= "#define MESSAGES_BUILTIN_COUNT $count\n";
+	$out .= "static const struct messages_builtin_entry messages_builtin_table[] = {\n";
+	$out .= join( '', @entries );
+	$out .= "};\n\n";
+
+	$out .= "#define MESSAGES_BUILTIN_BUCKETS $nbuckets\n";
+	$out .= "static const uint16_t messages_builtin_displace[] = {\n";
+	for( my $i = 0; $i < $nbuckets; $i += 8 )
+	{
+	    my $last = $i + 7 < $nbuckets ? $i + 7 : $nbuckets - 1;
+	    $out .= "\t" . join( ', ', @displace[ $i .. $last ] ) . ",\n";
+	}
+	$out .= "};\n";
+
+	return $out;
+    }
+}
+
 ########### YAML ###########
 #{
 #    package msgfmt::yaml;
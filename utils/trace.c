@@ -0,0 +1,220 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Event tracing implementation.
+ *
+ * The core runs on a single thread so one ring of events is kept
+ *  without any locking. The ring is written out to the trace file
+ *  whenever it fills and when tracing is finalised.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "netsurf/inttypes.h"
+#include "utils/sys_time.h"
+#include "utils/log.h"
+
+#include "utils/trace.h"
+
+#ifdef WITH_TRACE
+
+/** number of events buffered before they are written out */
+#define NSTRACE_RING_SIZE 8192
+
+/** A recorded trace event */
+struct nstrace_entry {
+	int64_t ts; /**< microseconds since tracing started */
+	const char *cat; /**< event category */
+	const char *name; /**< event name */
+	uintptr_t id; /**< asynchronous event identifier */
+	int64_t value; /**< counter value */
+	char phase; /**< trace event phase */
+};
+
+/* exported interface documented in utils/trace.h */
+bool nstrace_enabled = false;
+
+/** The stream the trace is written to */
+static FILE *tracefile;
+
+/** Time tracing started in microseconds */
+static int64_t trace_start;
+
+/** Buffered events */
+static struct nstrace_entry ring[NSTRACE_RING_SIZE];
+
+/** Number of buffered events */
+static unsigned int ring_used;
+
+/** Number of events written out */
+static uint64_t written;
+
+
+/**
+ * Get the current time.
+ *
+ * A monotonic clock is used where one is available so event times are
+ *  not disturbed by changes to the system time.
+ *
+ * \return The current time in microseconds.
+ */
+static int64_t nstrace_now(void)
+{
+#ifdef CLOCK_MONOTONIC
+	struct timespec now;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &now) == 0) {
+		return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+	}
+#endif
+	{
+		struct timeval tv;
+
+		gettimeofday(&tv, NULL);
+		return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+	}
+}
+
+
+/**
+ * Write out all buffered events.
+ */
+static void nstrace_flush(void)
+{
+	unsigned int idx;
+
+	for (idx = 0; idx < ring_used; idx++) {
+		struct nstrace_entry *e = &ring[idx];
+
+		fprintf(tracefile,
+			"%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\","
+			"\"ts\":%"PRId64",\"pid\":1,\"tid\":1",
+			(written++ == 0) ? "" : ",\n",
+			e->name, e->cat, e->phase, e->ts);
+
+		switch (e->phase) {
+		case 'b':
+		case 'e':
+			fprintf(tracefile, ",\"id\":\"0x%"PRIxPTR"\"", e->id);
+			break;
+
+		case 'i':
+			fputs(",\"s\":\"t\"", tracefile);
+			break;
+
+		case 'C':
+			fprintf(tracefile, ",\"args\":{\"value\":%"PRId64"}",
+				e->value);
+			break;
+		}
+
+		fputc('}', tracefile);
+	}
+
+	ring_used = 0;
+}
+
+
+/* exported interface documented in utils/trace.h */
+void
+nstrace_event(char phase,
+	      const char *cat,
+	      const char *name,
+	      uintptr_t id,
+	      int64_t value)
+{
+	struct nstrace_entry *e;
+
+	if (ring_used == NSTRACE_RING_SIZE) {
+		nstrace_flush();
+	}
+
+	e = &ring[ring_used++];
+	e->ts = nstrace_now() - trace_start;
+	e->cat = cat;
+	e->name = name;
+	e->id = id;
+	e->value = value;
+	e->phase = phase;
+}
+
+
+/* exported interface documented in utils/trace.h */
+nserror nstrace_init(const char *path)
+{
+	if ((path == NULL) || (*path == 0)) {
+		return NSERROR_OK;
+	}
+
+	tracefile = fopen(path, "w");
+	if (tracefile == NULL) {
+		NSLOG(netsurf, WARNING, "Unable to open trace file %s", path);
+		return NSERROR_NOT_FOUND;
+	}
+
+	fputs("{\"traceEvents\":[\n", tracefile);
+
+	trace_start = nstrace_now();
+	ring_used = 0;
+	written = 0;
+	nstrace_enabled = true;
+
+	NSLOG(netsurf, INFO, "Tracing events to %s", path);
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in utils/trace.h */
+void nstrace_finalise(void)
+{
+	if (!nstrace_enabled) {
+		return;
+	}
+
+	nstrace_enabled = false;
+	nstrace_flush();
+
+	fputs("\n],\"displayTimeUnit\":\"ms\"}\n", tracefile);
+	fclose(tracefile);
+	tracefile = NULL;
+
+	NSLOG(netsurf, INFO, "Wrote %"PRIu64" trace events", written);
+}
+
+#else
+
+/* exported interface documented in utils/trace.h */
+nserror nstrace_init(const char *path)
+{
+	if ((path != NULL) && (*path != 0)) {
+		NSLOG(netsurf, WARNING, "Tracing is not available in this build");
+	}
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in utils/trace.h */
+void nstrace_finalise(void)
+{
+}
+
+#endif
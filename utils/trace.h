@@ -0,0 +1,111 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Event tracing interface.
+ *
+ * Trace events mark where time is spent in the core. They are recorded
+ *  in a ring buffer and written out in the Chrome trace event JSON
+ *  format which may be loaded into a trace viewer such as Perfetto or
+ *  chrome://tracing.
+ *
+ * Tracing is only compiled in when WITH_TRACE is defined
+ *  (NETSURF_USE_TRACE). It is then enabled at run time by setting the
+ *  trace_file option. When compiled in but not enabled each event
+ *  costs a single test of nstrace_enabled.
+ *
+ * Event category and name parameters must be string literals, or
+ *  otherwise live for the whole run, as only the pointers are recorded.
+ */
+
+#ifndef NETSURF_UTILS_TRACE_H
+#define NETSURF_UTILS_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "utils/errors.h"
+
+/**
+ * Initialise event tracing.
+ *
+ * \param path The file to write the trace to or NULL to leave tracing
+ *             disabled.
+ * \return NSERROR_OK on success or error code on failure.
+ */
+nserror nstrace_init(const char *path);
+
+/**
+ * Finalise event tracing.
+ *
+ * Writes any buffered events and completes the trace file.
+ */
+void nstrace_finalise(void);
+
+#ifdef WITH_TRACE
+
+/** flag set when tracing is enabled */
+extern bool nstrace_enabled;
+
+/**
+ * Record a trace event.
+ *
+ * This should not be called directly, use the NSTRACE macros.
+ *
+ * \param phase The trace event phase character.
+ * \param cat The event category.
+ * \param name The event name.
+ * \param id The identifier matching the ends of asynchronous events.
+ * \param value The value of counter events.
+ */
+void nstrace_event(char phase, const char *cat, const char *name, uintptr_t id, int64_t value);
+
+#define NSTRACE_EVENT(phase, cat, name, id, value)			\
+	do {								\
+		if (nstrace_enabled) {					\
+			nstrace_event(phase, cat, name,			\
+				      (uintptr_t)(id), value);		\
+		}							\
+	} while(0)
+
+#else /* WITH_TRACE */
+
+#define NSTRACE_EVENT(phase, cat, name, id, value) do { } while(0)
+
+#endif /* WITH_TRACE */
+
+/** Begin a span which ends on the same call stack */
+#define NSTRACE_BEGIN(cat, name) NSTRACE_EVENT('B', cat, name, 0, 0)
+
+/** End the innermost span started with NSTRACE_BEGIN */
+#define NSTRACE_END(cat, name) NSTRACE_EVENT('E', cat, name, 0, 0)
+
+/** Begin a span which may end later, identified by a pointer */
+#define NSTRACE_ASYNC_BEGIN(cat, name, id) NSTRACE_EVENT('b', cat, name, id, 0)
+
+/** End a span started with NSTRACE_ASYNC_BEGIN */
+#define NSTRACE_ASYNC_END(cat, name, id) NSTRACE_EVENT('e', cat, name, id, 0)
+
+/** Mark a single point in time */
+#define NSTRACE_INSTANT(cat, name) NSTRACE_EVENT('i', cat, name, 0, 0)
+
+/** Record the current value of a counter */
+#define NSTRACE_COUNTER(cat, name, value) NSTRACE_EVENT('C', cat, name, 0, value)
+
+#endif
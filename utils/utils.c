@@ -324,6 +324,46 @@ char *strcasestr(const char *haystack, const char *needle)
 #endif
 
 
+#ifndef HAVE_MEMMEM
+
+/**
+ * Find a byte sequence within a block of memory
+ *
+ * \param haystack Memory to search in
+ * \param haystacklen Length of haystack
+ * \param needle Bytes to look for
+ * \param needlelen Length of needle
+ * \return Pointer to start of found sequence, or NULL if not found
+ */
+void *memmem(const void *haystack, size_t haystacklen,
+	     const void *needle, size_t needlelen)
+{
+	const char *pos = haystack;
+	const char *last_start;
+
+	if (needlelen == 0)
+		return (void *)haystack;
+	if (haystacklen < needlelen)
+		return NULL;
+
+	last_start = pos + (haystacklen - needlelen);
+
+	while (pos <= last_start) {
+		pos = memchr(pos, *(const char *)needle,
+			     last_start - pos + 1);
+		if (pos == NULL)
+			return NULL;
+		if (memcmp(pos, needle, needlelen) == 0)
+			return (void *)pos;
+		pos++;
+	}
+
+	return NULL;
+}
+
+#endif
+
+
 #ifndef HAVE_STRNDUP
 
 /**
@@ -0,0 +1,312 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Worker thread pool implementation.
+ *
+ * Submitted work is kept on a single list in submission order. Worker
+ *  threads take the first work not yet started. The core thread polls
+ *  from the scheduler while work is outstanding and reports
+ *  completions from the head of the list, stopping at the first work
+ *  which is not finished, so completions keep submission order.
+ */
+
+#include <stdlib.h>
+
+#include "utils/log.h"
+#include "netsurf/misc.h"
+#include "desktop/gui_internal.h"
+
+#include "utils/worker.h"
+
+#ifdef WITH_WORKERS
+
+#include <pthread.h>
+
+/** Interval between polls for completed work in ms */
+#define WORKER_POLL_TIME 5
+
+/** Maximum number of worker threads */
+#define WORKER_MAX_THREADS 16
+
+/** State of submitted work */
+enum worker_state {
+	WORKER_QUEUED, /**< waiting for a worker thread */
+	WORKER_RUNNING, /**< being run by a worker thread */
+	WORKER_FINISHED, /**< run, or cancelled before it started */
+};
+
+/** Submitted work */
+struct worker_job {
+	struct worker_job *next; /**< next in submission order */
+	worker_run_cb *run; /**< work to run on a worker thread */
+	worker_done_cb *done; /**< completion on the core thread */
+	void *pw; /**< client data */
+	enum worker_state state; /**< state of the work */
+	bool cancelled; /**< the work has been cancelled */
+};
+
+/** Lock protecting the job list and shutdown flag */
+static pthread_mutex_t worker_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/** Signalled when work is queued or on shutdown */
+static pthread_cond_t worker_cond = PTHREAD_COND_INITIALIZER;
+
+/** Worker threads */
+static pthread_t worker_threads[WORKER_MAX_THREADS];
+
+/** Number of worker threads */
+static unsigned int worker_count = 0;
+
+/** Submitted work in submission order */
+static struct worker_job *worker_head = NULL;
+
+/** Last submitted work */
+static struct worker_job *worker_tail = NULL;
+
+/** Worker threads should exit */
+static bool worker_shutdown = false;
+
+
+/**
+ * Worker thread main loop
+ *
+ * \param arg unused
+ * \return NULL
+ */
+static void *worker_thread(void *arg)
+{
+	struct worker_job *job;
+
+	pthread_mutex_lock(&worker_lock);
+	while (worker_shutdown == false) {
+		for (job = worker_head; job != NULL; job = job->next) {
+			if (job->state == WORKER_QUEUED) {
+				break;
+			}
+		}
+
+		if (job == NULL) {
+			pthread_cond_wait(&worker_cond, &worker_lock);
+			continue;
+		}
+
+		job->state = WORKER_RUNNING;
+		pthread_mutex_unlock(&worker_lock);
+
+		job->run(job->pw);
+
+		pthread_mutex_lock(&worker_lock);
+		job->state = WORKER_FINISHED;
+	}
+	pthread_mutex_unlock(&worker_lock);
+
+	return NULL;
+}
+
+
+/**
+ * Report finished work from the head of the list.
+ *
+ * \param pw unused
+ */
+static void worker_poll(void *pw)
+{
+	struct worker_job *finished = NULL;
+	struct worker_job *job;
+
+	pthread_mutex_lock(&worker_lock);
+	if ((worker_head != NULL) &&
+	    (worker_head->state == WORKER_FINISHED)) {
+		finished = worker_head;
+		for (job = worker_head;
+		     (job->next != NULL) &&
+			     (job->next->state == WORKER_FINISHED);
+		     job = job->next) {
+		}
+		worker_head = job->next;
+		job->next = NULL;
+		if (worker_head == NULL) {
+			worker_tail = NULL;
+		}
+	}
+	pthread_mutex_unlock(&worker_lock);
+
+	/* completions may submit or cancel work */
+	while (finished != NULL) {
+		job = finished;
+		finished = job->next;
+
+		job->done(job->pw, job->cancelled);
+		free(job);
+	}
+
+	if (worker_head != NULL) {
+		guit->misc->schedule(WORKER_POLL_TIME, worker_poll, NULL);
+	}
+}
+
+
+/* exported interface documented in utils/worker.h */
+nserror worker_init(unsigned int count)
+{
+	if (count > WORKER_MAX_THREADS) {
+		count = WORKER_MAX_THREADS;
+	}
+
+	worker_shutdown = false;
+
+	for (worker_count = 0; worker_count < count; worker_count++) {
+		if (pthread_create(&worker_threads[worker_count], NULL,
+				   worker_thread, NULL) != 0) {
+			NSLOG(netsurf, WARNING,
+			      "Unable to start worker thread %u", worker_count);
+			break;
+		}
+	}
+
+	NSLOG(netsurf, INFO, "%u worker threads", worker_count);
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in utils/worker.h */
+void worker_fini(void)
+{
+	struct worker_job *job;
+	unsigned int idx;
+
+	guit->misc->schedule(-1, worker_poll, NULL);
+
+	pthread_mutex_lock(&worker_lock);
+	worker_shutdown = true;
+	pthread_cond_broadcast(&worker_cond);
+	pthread_mutex_unlock(&worker_lock);
+
+	for (idx = 0; idx < worker_count; idx++) {
+		pthread_join(worker_threads[idx], NULL);
+	}
+	worker_count = 0;
+
+	while (worker_head != NULL) {
+		job = worker_head;
+		worker_head = job->next;
+
+		job->done(job->pw, true);
+		free(job);
+	}
+	worker_tail = NULL;
+}
+
+
+/* exported interface documented in utils/worker.h */
+bool worker_available(void)
+{
+	return worker_count != 0;
+}
+
+
+/* exported interface documented in utils/worker.h */
+nserror worker_submit(worker_run_cb *run, worker_done_cb *done, void *pw)
+{
+	struct worker_job *job;
+
+	if (worker_count == 0) {
+		return NSERROR_NOT_IMPLEMENTED;
+	}
+
+	job = malloc(sizeof(*job));
+	if (job == NULL) {
+		return NSERROR_NOMEM;
+	}
+	job->next = NULL;
+	job->run = run;
+	job->done = done;
+	job->pw = pw;
+	job->state = WORKER_QUEUED;
+	job->cancelled = false;
+
+	pthread_mutex_lock(&worker_lock);
+	if (worker_tail == NULL) {
+		worker_head = job;
+	} else {
+		worker_tail->next = job;
+	}
+	worker_tail = job;
+	pthread_cond_signal(&worker_cond);
+	pthread_mutex_unlock(&worker_lock);
+
+	/* the poll reschedules itself while work is outstanding */
+	if (worker_head == job) {
+		guit->misc->schedule(WORKER_POLL_TIME, worker_poll, NULL);
+	}
+
+	return NSERROR_OK;
+}
+
+
+/* exported interface documented in utils/worker.h */
+void worker_cancel(void *pw)
+{
+	struct worker_job *job;
+
+	pthread_mutex_lock(&worker_lock);
+	for (job = worker_head; job != NULL; job = job->next) {
+		if (job->pw == pw) {
+			job->cancelled = true;
+			if (job->state == WORKER_QUEUED) {
+				job->state = WORKER_FINISHED;
+			}
+		}
+	}
+	pthread_mutex_unlock(&worker_lock);
+}
+
+#else /* WITH_WORKERS */
+
+/* exported interface documented in utils/worker.h */
+nserror worker_init(unsigned int count)
+{
+	return NSERROR_OK;
+}
+
+/* exported interface documented in utils/worker.h */
+void worker_fini(void)
+{
+}
+
+/* exported interface documented in utils/worker.h */
+bool worker_available(void)
+{
+	return false;
+}
+
+/* exported interface documented in utils/worker.h */
+nserror worker_submit(worker_run_cb *run, worker_done_cb *done, void *pw)
+{
+	return NSERROR_NOT_IMPLEMENTED;
+}
+
+/* exported interface documented in utils/worker.h */
+void worker_cancel(void *pw)
+{
+}
+
+#endif /* WITH_WORKERS */
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2026 The NetSurf Browser Project
+ *
+ * This file is part of NetSurf, http://www.netsurf-browser.org/
+ *
+ * NetSurf is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; version 2 of the License.
+ *
+ * NetSurf is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ * Worker thread pool interface.
+ *
+ * The core runs on a single thread. Work which touches no shared state
+ *  may be passed to a pool of worker threads and its completion is
+ *  then reported back on the core thread from the scheduler.
+ *
+ * Completions are reported in the order the work was submitted so
+ *  callers see the same ordering however the work was scheduled
+ *  across the threads.
+ *
+ * The pool is only compiled in when WITH_WORKERS is defined
+ *  (NETSURF_USE_WORKERS). Otherwise, or when no threads are
+ *  configured, submission fails with NSERROR_NOT_IMPLEMENTED and
+ *  callers must do the work themselves.
+ */
+
+#ifndef NETSURF_UTILS_WORKER_H
+#define NETSURF_UTILS_WORKER_H
+
+#include <stdbool.h>
+
+#include "utils/errors.h"
+
+/**
+ * Work to be run on a worker thread.
+ *
+ * This must not use any state shared with the core.
+ *
+ * \param pw The client data passed to worker_submit().
+ */
+typedef void (worker_run_cb)(void *pw);
+
+/**
+ * Completion of work, called on the core thread.
+ *
+ * \param pw The client data passed to worker_submit().
+ * \param cancelled true if the work was cancelled, in which case it
+ *                  may not have been run.
+ */
+typedef void (worker_done_cb)(void *pw, bool cancelled);
+
+/**
+ * Initialise the worker thread pool.
+ *
+ * \param count The number of worker threads, zero for none.
+ * \return NSERROR_OK on success or error code on failure.
+ */
+nserror worker_init(unsigned int count);
+
+/**
+ * Finalise the worker thread pool.
+ *
+ * Waits for running work, then reports all outstanding work as
+ *  cancelled.
+ */
+void worker_fini(void);
+
+/**
+ * Determine if there are worker threads to submit work to.
+ *
+ * \return true if work may be submitted else false.
+ */
+bool worker_available(void);
+
+/**
+ * Submit work to the worker thread pool.
+ *
+ * \param run The work to run on a worker thread.
+ * \param done The completion to call on the core thread.
+ * \param pw Client data passed to both callbacks.
+ * \return NSERROR_OK on success, NSERROR_NOT_IMPLEMENTED if there are
+ *         no worker threads or another error code on failure.
+ */
+nserror worker_submit(worker_run_cb *run, worker_done_cb *done, void *pw);
+
+/**
+ * Cancel submitted work.
+ *
+ * Work which has not started is not run. The completion is still
+ *  called, with cancelled set, so the client data may be freed.
+ *
+ * \param pw The client data the work was submitted with.
+ */
+void worker_cancel(void *pw);
+
+#endif